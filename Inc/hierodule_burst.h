@@ -0,0 +1,152 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_burst.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the pulse burst module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_BURST_H
+#define __HIERODULE_BURST_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Burst Pulse Burst Module
+  * @brief Bursts of an exact number of pulses, via the one-pulse mode and
+  * the repetition counter
+  * @details @rv_refer_to_usage{BurstUsage}
+  * @{
+  */
+/** @addtogroup BURST_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of burst configuration and control routines, along
+  * with the generator struct they work on and a typedef for the completion
+  * callbacks.\n
+  * @rv_inc_headers{hierodule_tim.h,the timer interrupt callbacks}
+  * @{
+  */
+
+#include <hierodule_tim.h>
+
+/** @brief Number of pulses the repetition counter can count, 256 for the
+  * 8 bit repetition counters of the supported devices.
+  */
+#define HIERODULE_BURST_CHUNK 256
+
+/** @brief Forward declaration of the generator struct, for the callback
+  * typedef.
+  */
+typedef struct HIERODULE_BURST_Generator HIERODULE_BURST_Generator;
+
+/** @brief Typedef for burst completion callbacks.
+  * @details Performed in the update IRQ of the generator's timer, with the
+  * generator and the context pointer it was initialized with.
+  */
+typedef void (*HIERODULE_BURST_Callback)
+(
+    HIERODULE_BURST_Generator *Generator,
+    void *Context
+);
+
+/** @brief Struct that keeps the state of a pulse burst generator.
+  * @details Allocated by the caller, approach the fields as read-only.
+  */
+struct HIERODULE_BURST_Generator
+{
+/** @brief The timer the generator runs on.
+  */
+    TIM_TypeDef *Timer;
+/** @brief Pointer to the compare register of the output channel.
+  */
+    volatile uint32_t *Compare;
+/** @brief Pulses of the burst not yet loaded into the repetition counter.
+  */
+    volatile uint32_t Remaining;
+/** @brief 1 while a burst is being output, 0 otherwise.
+  */
+    volatile uint32_t Active;
+/** @brief Pulse width, in counts.
+  */
+    uint32_t Width;
+/** @brief Pointer to the completion callback, may be NULL.
+  */
+    HIERODULE_BURST_Callback Callback;
+/** @brief Pointer passed as is to the completion callback.
+  */
+    void *Context;
+};
+
+/** @brief Initializes a pulse burst generator on a PWM channel.
+  * @param Generator: Pointer to the generator.
+  * @rv_param_timer
+  * @param Channel: Capture compare channel to output the pulses on, 1 to 4.
+  * @param Callback: Pointer to the completion callback, may be NULL.
+  * @param Context: Pointer passed as is to the callback, may be NULL.
+  * @return None
+  */
+void HIERODULE_BURST_Init
+(
+    HIERODULE_BURST_Generator *Generator,
+    TIM_TypeDef *Timer,
+    uint8_t Channel,
+    HIERODULE_BURST_Callback Callback,
+    void *Context
+);
+
+/** @brief Sets the pulse frequency and width of a generator.
+  * @param Generator: Pointer to the generator.
+  * @param Frequency_mHz: Pulse frequency in millihertz.
+  * @param Width_ns: Pulse width in nanoseconds.
+  * @return The frequency actually achieved, in millihertz.
+  * 0 if the requested frequency is 0, the channel of the generator is
+  * invalid, or a burst is being output.
+  */
+uint64_t HIERODULE_BURST_Configure
+(
+    HIERODULE_BURST_Generator *Generator,
+    uint64_t Frequency_mHz,
+    uint32_t Width_ns
+);
+
+/** @brief Starts a burst of pulses.
+  * @param Generator: Pointer to the generator.
+  * @param Count: Number of pulses.
+  * @return 1 if the burst is started, 0 if the count is 0, the channel of
+  * the generator is invalid, or a burst is already being output.
+  */
+uint32_t HIERODULE_BURST_Start
+(
+    HIERODULE_BURST_Generator *Generator,
+    uint32_t Count
+);
+
+/** @brief Stops the burst being output, if any.
+  * @param Generator: Pointer to the generator.
+  * @return None
+  */
+void HIERODULE_BURST_Stop(HIERODULE_BURST_Generator *Generator);
+
+/** @brief Checks whether a generator is outputting a burst.
+  * @param Generator: Pointer to the generator.
+  * @return 1 if so, 0 otherwise.
+  */
+uint32_t HIERODULE_BURST_IsActive(HIERODULE_BURST_Generator *Generator);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_BURST_H */
@@ -0,0 +1,57 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_critical.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the critical section helpers.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_CRITICAL_H
+#define __HIERODULE_CRITICAL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Critical Critical Section Helpers
+  * @brief Interrupt masking that nests, shared by the modules
+  * @details The modules that share state with their IRQs guard it with
+  * these, rather than enabling the interrupts back unconditionally, so the
+  * routines can also be called with the interrupts already masked.
+  * @{
+  */
+
+#include <main.h>
+
+/** @brief Masks interrupts and returns the previous mask state.
+  * @return The previous PRIMASK value.
+  */
+static inline uint32_t HIERODULE_CRITICAL_Enter(void)
+{
+    uint32_t Primask = __get_PRIMASK();
+    __disable_irq();
+    return Primask;
+}
+
+/** @brief Restores the interrupt mask state.
+  * @param Primask: The value returned by
+  * @ref HIERODULE_CRITICAL_Enter "HIERODULE_CRITICAL_Enter".
+  * @return None
+  */
+static inline void HIERODULE_CRITICAL_Exit(uint32_t Primask)
+{
+    __set_PRIMASK(Primask);
+}
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_CRITICAL_H */
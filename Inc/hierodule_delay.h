@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_delay.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the delay module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_DELAY_H
+#define __HIERODULE_DELAY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Delay Delay Module
+  * @brief Microsecond delays and bounded busy-waits off the timestamps
+  * @details @rv_refer_to_usage{DelayUsage}
+  * @{
+  */
+/** @addtogroup DELAY_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of the delay, deadline and busy-wait routines, and the
+  * deadline type.\n
+  * @rv_inc_headers{hierodule_tstamp.h,the free running timestamps}
+  * @{
+  */
+
+#include <hierodule_tstamp.h>
+
+/** @brief Point in time a wait should end at.
+  * @details Lower 32 bits of a timestamp, compared to the current one with
+  * a signed difference, so a deadline can be at most 2^31 counts of the
+  * timestamp timer away.
+  */
+typedef uint32_t HIERODULE_DELAY_Deadline;
+
+/** @brief Initializes the delay module.
+  * @return None
+  */
+void HIERODULE_DELAY_Init(void);
+
+/** @brief Returns the deadline a given number of microseconds from now.
+  * @param Microseconds Time until the deadline.
+  * @return Deadline.
+  */
+HIERODULE_DELAY_Deadline HIERODULE_DELAY_After_us(uint32_t Microseconds);
+
+/** @brief Checks whether a deadline has passed.
+  * @param Deadline Deadline to check.
+  * @return 1 if passed, 0 otherwise.
+  */
+uint8_t HIERODULE_DELAY_Expired(HIERODULE_DELAY_Deadline Deadline);
+
+/** @brief Blocks for a given number of microseconds.
+  * @param Microseconds Time to block for.
+  * @return None
+  */
+void HIERODULE_DELAY_us(uint32_t Microseconds);
+
+/** @brief Blocks until the masked bits of a register match a value, or a
+  * deadline passes.
+  * @param Register Address of the register to poll.
+  * @param Mask Bits of the register to compare.
+  * @param Value Value the masked bits are expected to take.
+  * @param Deadline Deadline to give up at.
+  * @return 1 if the bits matched, 0 if the deadline passed first.
+  */
+uint8_t HIERODULE_DELAY_WaitUntil(volatile uint32_t *Register, uint32_t Mask,
+    uint32_t Value, HIERODULE_DELAY_Deadline Deadline);
+
+/** @brief Returns the time spent in the blocking routines of the module.
+  * @return Counts of the timestamp timer, summed over all waits since
+  * initialization or the last reset.
+  */
+uint64_t HIERODULE_DELAY_GetWaited(void);
+
+/** @brief Clears the time spent in the blocking routines of the module.
+  * @return None
+  */
+void HIERODULE_DELAY_ResetWaited(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_DELAY_H */
@@ -0,0 +1,139 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_dma.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the DMA module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_DMA_H
+#define __HIERODULE_DMA_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Dma DMA Module
+  * @brief Circular DMA transfers between peripheral registers and memory
+  * @details Meant to be used by other modules streaming to and from timers,
+  * see @ref WaveUsage "the waveform module" for an example. Covers DMA
+  * channels on STM32F030x6 and STM32F103xB, and DMA streams on
+  * STM32F401xC, in the same manner.
+  * @{
+  */
+/** @addtogroup DMA_Public Global
+  * @brief @rv_global_private_brief{are not}
+  * @details Consists of routines to start, stop and service circular
+  * transfers, a struct that designates a DMA channel or stream, a transfer
+  * direction enumeration and the normalized transfer flags.\n
+  * @rv_inc_main
+  * @{
+  */
+
+#include <main.h>
+
+/** @brief Half transfer flag, as returned by @ref HIERODULE_DMA_FetchFlags
+  * "HIERODULE_DMA_FetchFlags".
+  */
+#define HIERODULE_DMA_FLAG_HT 0x01UL
+
+/** @brief Transfer complete flag, as returned by @ref HIERODULE_DMA_FetchFlags
+  * "HIERODULE_DMA_FetchFlags".
+  */
+#define HIERODULE_DMA_FLAG_TC 0x02UL
+
+/** @brief Transfer error flag, as returned by @ref HIERODULE_DMA_FetchFlags
+  * "HIERODULE_DMA_FetchFlags".
+  */
+#define HIERODULE_DMA_FLAG_TE 0x04UL
+
+/** @brief DMA transfer direction enumeration.
+  */
+typedef enum
+{
+/** @brief From a peripheral register to memory.
+  */
+    HIERODULE_DMA_Direction_PERIPH_TO_MEM,
+/** @brief From memory to a peripheral register.
+  */
+    HIERODULE_DMA_Direction_MEM_TO_PERIPH
+
+} HIERODULE_DMA_Direction;
+
+/** @brief Struct that designates a DMA channel, or a DMA stream on
+  * STM32F401xC.
+  * @details See the DMA request mapping in the device manual for the
+  * channel, or stream and channel selection, a peripheral request is wired
+  * to.
+  */
+typedef struct
+{
+/** @brief Pointer to the DMA controller, DMA1 or DMA2.
+  */
+    DMA_TypeDef *Controller;
+/** @brief Channel number from 1 to 7, or stream number from 0 to 7 on
+  * STM32F401xC.
+  */
+    uint8_t Index;
+/** @brief Channel selection of the stream from 0 to 7, on STM32F401xC only.
+  */
+    uint8_t Request;
+
+} HIERODULE_DMA_Link;
+
+/** @brief Starts a circular transfer between a peripheral register and a
+  * memory buffer.
+  * @param Link: Pointer to the DMA channel designation.
+  * @param Direction: Transfer direction.
+  * @param Register: Pointer to the peripheral register.
+  * @param Memory: Pointer to the memory buffer.
+  * @param Count: Number of items in the buffer.
+  * @param Size: Size of an item in bytes, 1, 2 or 4.
+  * @return None
+  */
+void HIERODULE_DMA_StartCircular
+(
+    const HIERODULE_DMA_Link *Link,
+    HIERODULE_DMA_Direction Direction,
+    volatile uint32_t *Register,
+    void *Memory,
+    uint16_t Count,
+    uint8_t Size
+);
+
+/** @brief Stops the transfer of a DMA channel.
+  * @param Link: Pointer to the DMA channel designation.
+  * @return None
+  */
+void HIERODULE_DMA_Stop(const HIERODULE_DMA_Link *Link);
+
+/** @brief Returns the number of items left until the end of the buffer.
+  * @param Link: Pointer to the DMA channel designation.
+  * @return Number of items left.
+  */
+uint32_t HIERODULE_DMA_GetRemaining(const HIERODULE_DMA_Link *Link);
+
+/** @brief Reads and clears the transfer flags of a DMA channel.
+  * @param Link: Pointer to the DMA channel designation.
+  * @return Combination of @ref HIERODULE_DMA_FLAG_HT "HIERODULE_DMA_FLAG_HT",
+  * @ref HIERODULE_DMA_FLAG_TC "HIERODULE_DMA_FLAG_TC" and
+  * @ref HIERODULE_DMA_FLAG_TE "HIERODULE_DMA_FLAG_TE".
+  */
+uint32_t HIERODULE_DMA_FetchFlags(const HIERODULE_DMA_Link *Link);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_DMA_H */
@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_enc.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the encoder module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_ENC_H
+#define __HIERODULE_ENC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Enc Encoder Module
+  * @brief Quadrature encoder position and velocity via timer encoder mode
+  * @details @rv_refer_to_usage{EncUsage}
+  * @{
+  */
+/** @addtogroup ENC_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of encoder position and velocity routines, along with
+  * the encoder struct and the encoder mode enumeration.\n
+  * @rv_inc_headers{hierodule_tim.h,the timer interrupt callbacks}
+  * @{
+  */
+
+#include <hierodule_tim.h>
+
+/** @brief Encoder mode enumeration.
+  */
+typedef enum
+{
+/** @brief Counts on the edges of TI1, two counts per cycle.
+  */
+    HIERODULE_ENC_Mode_X2_TI1 = 1,
+/** @brief Counts on the edges of TI2, two counts per cycle.
+  */
+    HIERODULE_ENC_Mode_X2_TI2 = 2,
+/** @brief Counts on the edges of both, four counts per cycle.
+  */
+    HIERODULE_ENC_Mode_X4_TI12 = 3
+
+} HIERODULE_ENC_Mode;
+
+/** @brief Struct that keeps an extended position along with the counter
+  * value it corresponds to.
+  */
+typedef struct
+{
+/** @brief Extended position.
+  */
+    int64_t Position;
+/** @brief Counter value at the position.
+  */
+    uint16_t Count;
+
+} HIERODULE_ENC_Sample;
+
+/** @brief Struct that keeps the state of an encoder.
+  * @details Allocated by the caller, approach the fields as read-only.
+  */
+typedef struct
+{
+/** @brief The timer the encoder is read on.
+  */
+    TIM_TypeDef *Timer;
+/** @brief Two samples, the one pointed at by the sequence is the latest,
+  * the other one is the one written next.
+  */
+    HIERODULE_ENC_Sample Slot[2];
+/** @brief Incremented after each sample, its lowest bit selects the latest
+  * slot.
+  */
+    volatile uint32_t Sequence;
+/** @brief Velocity in counts per second.
+  */
+    volatile int32_t Velocity;
+/** @brief Position at the start of the current velocity window.
+  */
+    int32_t WindowStart;
+/** @brief Samples elapsed in the current velocity window.
+  */
+    uint32_t Elapsed;
+/** @brief Rate the velocity is updated at, in Hertz.
+  */
+    uint32_t SampleRate;
+/** @brief Counts that close a velocity window.
+  */
+    uint32_t MinCounts;
+/** @brief Samples after which a window without any counts reports zero
+  * velocity.
+  */
+    uint32_t MaxWindow;
+
+} HIERODULE_ENC_Encoder;
+
+/** @brief Initializes an encoder on a timer.
+  * @param Encoder: Pointer to the encoder.
+  * @rv_param_timer
+  * @param Mode: Encoder mode.
+  * @return None
+  */
+void HIERODULE_ENC_Init
+(
+    HIERODULE_ENC_Encoder *Encoder,
+    TIM_TypeDef *Timer,
+    HIERODULE_ENC_Mode Mode
+);
+
+/** @brief Returns the position of an encoder.
+  * @param Encoder: Pointer to the encoder.
+  * @return Counts since initialization.
+  */
+int64_t HIERODULE_ENC_GetPosition(HIERODULE_ENC_Encoder *Encoder);
+
+/** @brief Returns the lower 32 bits of the position of an encoder.
+  * @param Encoder: Pointer to the encoder.
+  * @return Counts since initialization, wrapping at 32 bits.
+  */
+int32_t HIERODULE_ENC_GetPosition32(HIERODULE_ENC_Encoder *Encoder);
+
+/** @brief Configures the velocity estimator of an encoder.
+  * @param Encoder: Pointer to the encoder.
+  * @param SampleRate_Hz: Rate @ref HIERODULE_ENC_UpdateVelocity
+  * "HIERODULE_ENC_UpdateVelocity" is called at, in Hertz.
+  * @param MinCounts: Counts that close a velocity window, at least 1.
+  * @param MaxWindow: Samples after which a window without any counts
+  * reports zero velocity, at least 1.
+  * @return None
+  */
+void HIERODULE_ENC_ConfigVelocity
+(
+    HIERODULE_ENC_Encoder *Encoder,
+    uint32_t SampleRate_Hz,
+    uint32_t MinCounts,
+    uint32_t MaxWindow
+);
+
+/** @brief Updates the velocity estimate of an encoder.
+  * @param Encoder: Pointer to the encoder.
+  * @return None
+  */
+void HIERODULE_ENC_UpdateVelocity(HIERODULE_ENC_Encoder *Encoder);
+
+/** @brief Returns the velocity estimate of an encoder.
+  * @param Encoder: Pointer to the encoder.
+  * @return Velocity in counts per second, positive while counting up.
+  */
+int32_t HIERODULE_ENC_GetVelocity(HIERODULE_ENC_Encoder *Encoder);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_ENC_H */
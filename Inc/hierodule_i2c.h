@@ -27,7 +27,9 @@ extern "C"
   * @details Consists of general I2C comm routines, a I2C wrapper
   * initalizer and typedefs for module routines.\n
   * @rv_inc_main\n
-  * @rv_inc_headers{stddef.h and stdlib.h,NULL and malloc/free\, respectively}
+  * @rv_inc_headers{stddef.h and stdlib.h,NULL and malloc/free\, respectively}\n
+  * Also includes hierodule_delay.h when @ref HIERODULE_I2C_TIMED_IDLE
+  * "HIERODULE_I2C_TIMED_IDLE" is set.
   * @{
   */
 
@@ -35,6 +37,24 @@ extern "C"
 #include <stddef.h>
 #include <stdlib.h>
 
+/** @brief Precompiler constant to time the idle periods of the module off
+  * the delay module.
+  * @details When set to 1, the idle periods between bytes are waited out
+  * with @ref HIERODULE_DELAY_us "HIERODULE_DELAY_us", rounded up to whole
+  * microseconds, which requires the timestamp and the delay modules to be
+  * initialized beforehand.\n
+  * When set to 0, they are waited out with a NOP loop of as many iterations
+  * as the period is long in core clocks, which takes longer than that by
+  * the cost of the loop.
+  */
+#define HIERODULE_I2C_TIMED_IDLE 0
+
+/** \cond */
+#if HIERODULE_I2C_TIMED_IDLE /** \endcond */
+#include <hierodule_delay.h>
+/** \cond */
+#endif /** \endcond */
+
 /** @brief I2C wrapper status enumeration.
   * @details Notice that different devices may not follow the same status
   * succession.
@@ -0,0 +1,332 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_icap.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the input capture module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_ICAP_H
+#define __HIERODULE_ICAP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Icap Input Capture Module
+  * @brief Period, frequency and pulse width measurements via input capture
+  * @details @rv_refer_to_usage{IcapUsage}
+  * @{
+  */
+/** @addtogroup ICAP_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of input capture, PWM input and capture streaming
+  * routines, along with the engine and stream structs, the measurement mode
+  * and edge enumerations and a typedef for the stream notifications.\n
+  * @rv_inc_headers{hierodule_tim.h and hierodule_dma.h,the timer interrupt
+  * routines, callbacks and the DMA routines}
+  * @{
+  */
+
+#include <hierodule_tim.h>
+#include <hierodule_dma.h>
+
+/** @brief Input capture measurement mode enumeration.
+  */
+typedef enum
+{
+/** @brief Rising edges are captured, for period and frequency.
+  */
+    HIERODULE_ICAP_Mode_PERIOD,
+/** @brief Both edges are captured, by switching the polarity after each
+  * capture, for pulse width as well.
+  */
+    HIERODULE_ICAP_Mode_PULSE
+
+} HIERODULE_ICAP_Mode;
+
+/** @brief Captured edge enumeration, for capture streams.
+  */
+typedef enum
+{
+/** @brief Rising edges only.
+  */
+    HIERODULE_ICAP_Edge_RISING,
+/** @brief Falling edges only.
+  */
+    HIERODULE_ICAP_Edge_FALLING,
+/** @brief Both edges, not supported on STM32F103xB.
+  */
+    HIERODULE_ICAP_Edge_BOTH
+
+} HIERODULE_ICAP_Edge;
+
+/** @brief Struct that keeps a single measurement.
+  */
+typedef struct
+{
+/** @brief Counts between the last two rising edges.
+  */
+    uint32_t Period;
+/** @brief Counts between the last rising edge and the falling edge after
+  * it, 0 in period mode.
+  */
+    uint32_t Width;
+/** @brief Number of measurements taken so far.
+  */
+    uint32_t Count;
+
+} HIERODULE_ICAP_Result;
+
+/** @brief Struct that keeps the state of a channel.
+  * @details Approach the fields as read-only.
+  */
+typedef struct
+{
+/** @brief Two result slots, the one pointed at by the sequence is the
+  * latest, the other one is the one written next.
+  */
+    HIERODULE_ICAP_Result Slot[2];
+/** @brief Incremented after each measurement, its lowest bit selects the
+  * latest slot.
+  */
+    volatile uint32_t Sequence;
+/** @brief Extended timestamp of the last rising edge.
+  */
+    uint64_t LastRise;
+/** @brief Number of measurements so far, copied into the slots.
+  */
+    uint32_t Count;
+/** @brief Measurement mode of the channel.
+  */
+    HIERODULE_ICAP_Mode Mode;
+/** @brief 1 if the next capture is of a falling edge, 0 otherwise.
+  */
+    uint8_t Falling;
+/** @brief 1 once a rising edge is captured, 0 otherwise.
+  */
+    uint8_t Primed;
+
+} HIERODULE_ICAP_Channel;
+
+/** @brief Struct that keeps the state of an input capture engine.
+  * @details Allocated by the caller, one per timer, approach the fields as
+  * read-only.
+  */
+typedef struct
+{
+/** @brief The timer the engine runs on.
+  */
+    TIM_TypeDef *Timer;
+/** @brief Number of counter overflows since initialization.
+  */
+    volatile uint32_t Overflows;
+/** @brief State of each channel.
+  */
+    HIERODULE_ICAP_Channel Channel[4];
+
+} HIERODULE_ICAP_Engine;
+
+/** @brief Forward declaration of the stream struct, for the callback
+  * typedef.
+  */
+typedef struct HIERODULE_ICAP_Stream HIERODULE_ICAP_Stream;
+
+/** @brief Typedef for capture stream notifications.
+  * @details Performed in the DMA IRQ, once half of the buffer is filled,
+  * with the stream and the context pointer it was initialized with.
+  */
+typedef void (*HIERODULE_ICAP_StreamCallback)
+(
+    HIERODULE_ICAP_Stream *Stream,
+    void *Context
+);
+
+/** @brief Struct that keeps the state of a capture stream.
+  * @details Allocated by the caller and set up by
+  * @ref HIERODULE_ICAP_InitStream "HIERODULE_ICAP_InitStream", approach the
+  * fields as read-only.
+  */
+struct HIERODULE_ICAP_Stream
+{
+/** @brief The timer the captures are taken on.
+  */
+    TIM_TypeDef *Timer;
+/** @brief The DMA channel the capture request of the channel is wired to.
+  */
+    HIERODULE_DMA_Link Link;
+/** @brief Circular buffer the captures are written to.
+  */
+    uint16_t *Buffer;
+/** @brief Number of captures the buffer holds, even, 0 if the stream is
+  * unusable.
+  */
+    uint32_t Size;
+/** @brief Number of captures the stream positions wrap at, the largest
+  * multiple of the buffer size up to 2^31.
+  */
+    uint32_t Range;
+/** @brief Number of buffer halves filled since the stream is started,
+  * modulo the range.
+  */
+    volatile uint32_t Halves;
+/** @brief Number of captures consumed since the stream is started, modulo
+  * the range.
+  */
+    uint32_t Consumed;
+/** @brief Number of times captures were overwritten before being consumed.
+  */
+    uint32_t Overruns;
+/** @brief Pointer to the notification callback, may be NULL.
+  */
+    HIERODULE_ICAP_StreamCallback Notify;
+/** @brief Pointer passed as is to the notification callback.
+  */
+    void *Context;
+/** @brief Capture compare channel of the stream.
+  */
+    uint8_t Channel;
+/** @brief Captured edges.
+  */
+    HIERODULE_ICAP_Edge Edge;
+};
+
+/** @brief Initializes an input capture engine on a timer.
+  * @param Engine: Pointer to the engine.
+  * @rv_param_timer
+  * @return None
+  */
+void HIERODULE_ICAP_Init(HIERODULE_ICAP_Engine *Engine, TIM_TypeDef *Timer);
+
+/** @brief Configures a channel for input capture and starts measuring.
+  * @param Engine: Pointer to the engine.
+  * @param Channel: Capture compare channel, 1 to 4.
+  * @param Mode: Measurement mode.
+  * @return None
+  */
+void HIERODULE_ICAP_StartChannel
+(
+    HIERODULE_ICAP_Engine *Engine,
+    uint8_t Channel,
+    HIERODULE_ICAP_Mode Mode
+);
+
+/** @brief Stops measuring on a channel.
+  * @param Engine: Pointer to the engine.
+  * @param Channel: Capture compare channel, 1 to 4.
+  * @return None
+  */
+void HIERODULE_ICAP_StopChannel(HIERODULE_ICAP_Engine *Engine,
+    uint8_t Channel);
+
+/** @brief Reads the latest measurement of a channel.
+  * @param Engine: Pointer to the engine.
+  * @param Channel: Capture compare channel, 1 to 4.
+  * @param Result: Pointer to copy the measurement to.
+  * @return Number of measurements taken so far, 0 if there's none yet.
+  */
+uint32_t HIERODULE_ICAP_Read
+(
+    HIERODULE_ICAP_Engine *Engine,
+    uint8_t Channel,
+    HIERODULE_ICAP_Result *Result
+);
+
+/** @brief Returns the frequency of the signal on a channel.
+  * @param Engine: Pointer to the engine.
+  * @param Channel: Capture compare channel, 1 to 4.
+  * @return Frequency in millihertz, 0 if there's no measurement yet.
+  */
+uint64_t HIERODULE_ICAP_GetFrequency_mHz(HIERODULE_ICAP_Engine *Engine,
+    uint8_t Channel);
+
+/** @brief Configures a timer for PWM input on channel 1.
+  * @rv_param_timer
+  * @return None
+  */
+void HIERODULE_ICAP_StartPwmInput(TIM_TypeDef *Timer);
+
+/** @brief Reads the period and the pulse width measured in PWM input mode.
+  * @rv_param_timer
+  * @param Result: Pointer to copy the measurement to, with a count of 1 if
+  * a period has been captured, 0 otherwise.
+  * @return None
+  */
+void HIERODULE_ICAP_ReadPwmInput(TIM_TypeDef *Timer,
+    HIERODULE_ICAP_Result *Result);
+
+/** @brief Initializes a capture stream.
+  * @param Stream: Pointer to the stream.
+  * @rv_param_timer
+  * @param Channel: Capture compare channel, 1 to 4.
+  * @param Edge: Captured edges.
+  * @param Link: Pointer to the DMA channel the capture request of the
+  * channel is wired to, copied into the stream.
+  * @param Buffer: Circular buffer to write the captures to.
+  * @param Size: Number of captures the buffer holds, even and above 0.
+  * @param Notify: Pointer to the notification callback, may be NULL.
+  * @param Context: Pointer passed as is to the callback, may be NULL.
+  * @return None
+  */
+void HIERODULE_ICAP_InitStream
+(
+    HIERODULE_ICAP_Stream *Stream,
+    TIM_TypeDef *Timer,
+    uint8_t Channel,
+    HIERODULE_ICAP_Edge Edge,
+    const HIERODULE_DMA_Link *Link,
+    uint16_t *Buffer,
+    uint16_t Size,
+    HIERODULE_ICAP_StreamCallback Notify,
+    void *Context
+);
+
+/** @brief Starts streaming captures to the buffer.
+  * @param Stream: Pointer to the stream.
+  * @return None
+  */
+void HIERODULE_ICAP_StartStream(HIERODULE_ICAP_Stream *Stream);
+
+/** @brief Stops streaming captures.
+  * @param Stream: Pointer to the stream.
+  * @return None
+  */
+void HIERODULE_ICAP_StopStream(HIERODULE_ICAP_Stream *Stream);
+
+/** @brief Services the DMA interrupts of a stream.
+  * @param Stream: Pointer to the stream.
+  * @return None
+  */
+void HIERODULE_ICAP_ServiceStream(HIERODULE_ICAP_Stream *Stream);
+
+/** @brief Returns the oldest contiguous span of captures not yet consumed.
+  * @param Stream: Pointer to the stream.
+  * @param Span: Pointer to store the pointer to the first capture in.
+  * @return Number of captures in the span, 0 if there's none.
+  */
+uint32_t HIERODULE_ICAP_Peek(HIERODULE_ICAP_Stream *Stream,
+    const uint16_t **Span);
+
+/** @brief Marks captures as consumed.
+  * @param Stream: Pointer to the stream.
+  * @param Count: Number of captures, no more than the last span.
+  * @return None
+  */
+void HIERODULE_ICAP_Consume(HIERODULE_ICAP_Stream *Stream, uint32_t Count);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_ICAP_H */
@@ -0,0 +1,178 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_sched.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the event scheduler module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_SCHED_H
+#define __HIERODULE_SCHED_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Sched Event Scheduler Module
+  * @brief Callbacks posted at absolute timestamps, on output compare channels
+  * @details @rv_refer_to_usage{SchedUsage}
+  * @{
+  */
+/** @addtogroup SCHED_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of event scheduling routines, along with the event and
+  * lane structs they work on and a typedef for the event callbacks.\n
+  * @rv_inc_headers{hierodule_tstamp.h,the timestamps deadlines are given in}
+  * @{
+  */
+
+#include <hierodule_tstamp.h>
+
+/** @brief Forward declaration of the event struct, for the callback
+  * typedef.
+  */
+typedef struct HIERODULE_SCHED_Event HIERODULE_SCHED_Event;
+
+/** @brief Typedef for event callbacks.
+  * @details Performed in the IRQ of the lane's timer, with the event and the
+  * context pointer it was posted with.
+  */
+typedef void (*HIERODULE_SCHED_Callback)
+(
+    HIERODULE_SCHED_Event *Event,
+    void *Context
+);
+
+/** @brief Struct that keeps the state of an event.
+  * @details Allocated by the caller and zero initialized, approach the
+  * fields as read-only.
+  */
+struct HIERODULE_SCHED_Event
+{
+/** @brief Timestamp the event is due at.
+  */
+    uint64_t Deadline;
+/** @brief Post order of the event, to fire events with the same deadline
+  * in the order they're posted.
+  */
+    uint32_t Sequence;
+/** @brief Position of the event in the heap of its lane plus one, 0 while
+  * it's not queued.
+  */
+    uint32_t Index;
+/** @brief Pointer to the callback.
+  */
+    HIERODULE_SCHED_Callback Callback;
+/** @brief Pointer passed as is to the callback.
+  */
+    void *Context;
+};
+
+/** @brief Struct that keeps the state of a scheduling lane.
+  * @details A lane is a capture compare channel of the timestamp timer with
+  * a queue of its own. Allocated by the caller, approach the fields as
+  * read-only.
+  */
+typedef struct
+{
+/** @brief The timer the lane runs on.
+  */
+    TIM_TypeDef *Timer;
+/** @brief Pointer to the compare register of the channel.
+  */
+    volatile uint32_t *Compare;
+/** @brief Min-heap of the queued events, earliest deadline first.
+  */
+    HIERODULE_SCHED_Event **Heap;
+/** @brief Number of elements in the heap storage.
+  */
+    uint32_t Capacity;
+/** @brief Number of events queued.
+  */
+    uint32_t Count;
+/** @brief Post order to assign to the next event.
+  */
+    uint32_t Sequence;
+/** @brief Number of events posted with a deadline already passed.
+  */
+    uint32_t Late;
+/** @brief Capture compare channel of the lane.
+  */
+    uint8_t Channel;
+
+} HIERODULE_SCHED_Lane;
+
+/** @brief Initializes a scheduling lane on a capture compare channel.
+  * @param Lane: Pointer to the lane.
+  * @rv_param_timer
+  * @param Channel: Capture compare channel, 1 to 4.
+  * @param Heap: Array of event pointers to keep the queue in.
+  * @param Capacity: Number of elements in the array.
+  * @return None
+  */
+void HIERODULE_SCHED_InitLane
+(
+    HIERODULE_SCHED_Lane *Lane,
+    TIM_TypeDef *Timer,
+    uint8_t Channel,
+    HIERODULE_SCHED_Event **Heap,
+    uint32_t Capacity
+);
+
+/** @brief Posts an event on a lane, or moves it if it's already queued.
+  * @param Lane: Pointer to the lane.
+  * @param Event: Pointer to the event.
+  * @param Deadline: Timestamp the event is due at.
+  * @param Callback: Pointer to the callback.
+  * @param Context: Pointer passed as is to the callback, may be NULL.
+  * @return 1 if the event is queued, 0 if the lane is full.
+  */
+uint32_t HIERODULE_SCHED_Post
+(
+    HIERODULE_SCHED_Lane *Lane,
+    HIERODULE_SCHED_Event *Event,
+    uint64_t Deadline,
+    HIERODULE_SCHED_Callback Callback,
+    void *Context
+);
+
+/** @brief Removes an event from a lane before it fires.
+  * @param Lane: Pointer to the lane.
+  * @param Event: Pointer to the event.
+  * @return 1 if the event was queued, 0 otherwise.
+  */
+uint32_t HIERODULE_SCHED_Cancel
+(
+    HIERODULE_SCHED_Lane *Lane,
+    HIERODULE_SCHED_Event *Event
+);
+
+/** @brief Checks whether an event is queued.
+  * @param Event: Pointer to the event.
+  * @return 1 if the event is queued, 0 otherwise.
+  */
+uint32_t HIERODULE_SCHED_IsQueued(HIERODULE_SCHED_Event *Event);
+
+/** @brief Returns the number of events posted on a lane with a deadline
+  * already passed.
+  * @param Lane: Pointer to the lane.
+  * @return Number of late events.
+  */
+uint32_t HIERODULE_SCHED_GetLateCount(HIERODULE_SCHED_Lane *Lane);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_SCHED_H */
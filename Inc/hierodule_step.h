@@ -0,0 +1,205 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_step.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the stepper motion profile module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_STEP_H
+#define __HIERODULE_STEP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Step Stepper Module
+  * @brief Step pulse trains with precomputed acceleration profiles, on a
+  * PWM channel
+  * @details @rv_refer_to_usage{StepUsage}
+  * @{
+  */
+/** @addtogroup STEP_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of ramp computation and move queueing routines, along
+  * with the ramp, move and engine structs they work on and a profile
+  * enumeration.\n
+  * @rv_inc_headers{hierodule_tim.h,the timer interrupt callbacks}
+  * @{
+  */
+
+#include <hierodule_tim.h>
+
+/** @brief Acceleration profile enumeration.
+  */
+typedef enum
+{
+/** @brief Constant acceleration, velocity rising linearly.
+  */
+    HIERODULE_STEP_Profile_TRAPEZOID,
+/** @brief Acceleration rising and falling smoothly, velocity following
+  * \f$3u^2 - 2u^3\f$ over the ramp.
+  */
+    HIERODULE_STEP_Profile_SCURVE
+
+} HIERODULE_STEP_Profile;
+
+/** @brief Struct that keeps a precomputed acceleration ramp.
+  * @details Filled via @ref HIERODULE_STEP_ComputeRamp
+  * "HIERODULE_STEP_ComputeRamp", shared by any number of moves. Approach
+  * the fields as read-only.
+  */
+typedef struct
+{
+/** @brief Array of ARR values, element n for the interval following step n
+  * of the acceleration. Run backwards for the deceleration.
+  */
+    uint16_t *Table;
+/** @brief Number of steps in the ramp, the elements of the table.
+  */
+    uint32_t Length;
+/** @brief ARR value for the intervals at the maximum rate.
+  */
+    uint16_t Cruise;
+} HIERODULE_STEP_Ramp;
+
+/** @brief Struct that describes a move.
+  */
+typedef struct
+{
+/** @brief Pointer to the ramp to accelerate and decelerate with.
+  */
+    const HIERODULE_STEP_Ramp *Ramp;
+/** @brief Number of steps in the move.
+  */
+    uint32_t Steps;
+} HIERODULE_STEP_Move;
+
+/** @brief Struct that keeps the state of a stepper engine.
+  * @details Allocated by the caller, approach the fields as read-only.
+  */
+typedef struct
+{
+/** @brief The timer the engine runs on.
+  */
+    TIM_TypeDef *Timer;
+/** @brief Pointer to the compare register of the step channel.
+  */
+    volatile uint32_t *Compare;
+/** @brief Array of queued moves, used as a ring.
+  */
+    HIERODULE_STEP_Move *Queue;
+/** @brief Number of elements in the queue storage.
+  */
+    uint32_t Capacity;
+/** @brief Number of moves ever queued.
+  */
+    uint32_t Head;
+/** @brief Number of moves ever taken from the queue.
+  */
+    uint32_t Tail;
+/** @brief The move whose intervals are being written to ARR.
+  */
+    HIERODULE_STEP_Move Current;
+/** @brief Index of the next step of the current move to write the interval
+  * of.
+  */
+    uint32_t Index;
+/** @brief Number of steps completed since initialization.
+  */
+    volatile uint32_t Position;
+/** @brief 1 while the counter is running, 0 otherwise.
+  */
+    volatile uint32_t Running;
+/** @brief Step pulse width, in counts.
+  */
+    uint16_t Width;
+} HIERODULE_STEP_Engine;
+
+/** @brief Computes the ARR values of an acceleration ramp.
+  * @param Ramp: Pointer to the ramp struct to fill.
+  * @param Table: Array to keep the ARR values in.
+  * @param Length: Number of steps to accelerate over, the elements of the
+  * array.
+  * @param Profile: Acceleration profile.
+  * @param TickFreq_Hz: Frequency the timer counts at.
+  * @param MaxRate_Hz: Step rate to accelerate to.
+  * @return Number of intervals out of the range of a 16 bit ARR, clamped,
+  * 0 on success.
+  */
+uint32_t HIERODULE_STEP_ComputeRamp
+(
+    HIERODULE_STEP_Ramp *Ramp,
+    uint16_t *Table,
+    uint32_t Length,
+    HIERODULE_STEP_Profile Profile,
+    uint32_t TickFreq_Hz,
+    uint32_t MaxRate_Hz
+);
+
+/** @brief Initializes a stepper engine on a PWM channel.
+  * @param Engine: Pointer to the engine.
+  * @rv_param_timer
+  * @param Channel: Capture compare channel to output the steps on, 1 to 4.
+  * @param Width: Step pulse width, in counts.
+  * @param Queue: Array of moves to keep the queue in.
+  * @param Capacity: Number of elements in the array.
+  * @return None
+  */
+void HIERODULE_STEP_Init
+(
+    HIERODULE_STEP_Engine *Engine,
+    TIM_TypeDef *Timer,
+    uint8_t Channel,
+    uint16_t Width,
+    HIERODULE_STEP_Move *Queue,
+    uint32_t Capacity
+);
+
+/** @brief Queues a move, starting it right away if the engine is idle.
+  * @param Engine: Pointer to the engine.
+  * @param Ramp: Pointer to the ramp to accelerate and decelerate with.
+  * @param Steps: Number of steps.
+  * @return 1 if the move is queued, 0 if the queue is full.
+  */
+uint32_t HIERODULE_STEP_Post
+(
+    HIERODULE_STEP_Engine *Engine,
+    const HIERODULE_STEP_Ramp *Ramp,
+    uint32_t Steps
+);
+
+/** @brief Returns the number of steps completed by an engine.
+  * @param Engine: Pointer to the engine.
+  * @return Steps completed since initialization, wrapping at 32 bits.
+  */
+uint32_t HIERODULE_STEP_GetPosition(HIERODULE_STEP_Engine *Engine);
+
+/** @brief Returns the number of moves queued but not started yet.
+  * @param Engine: Pointer to the engine.
+  * @return Number of moves.
+  */
+uint32_t HIERODULE_STEP_GetPending(HIERODULE_STEP_Engine *Engine);
+
+/** @brief Checks whether an engine is running.
+  * @param Engine: Pointer to the engine.
+  * @return 1 if so, 0 otherwise.
+  */
+uint32_t HIERODULE_STEP_IsRunning(HIERODULE_STEP_Engine *Engine);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_STEP_H */
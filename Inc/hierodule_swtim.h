@@ -0,0 +1,182 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_swtim.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the software timer module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_SWTIM_H
+#define __HIERODULE_SWTIM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Swtim Software Timer Module
+  * @brief Software timers multiplexed on a single hardware timer
+  * @details @rv_refer_to_usage{SwtimUsage}
+  * @{
+  */
+/** @addtogroup SWTIM_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of software timer management routines, a software timer
+  * struct to make up the pool with, a mode enumeration and a typedef for the
+  * expiry callbacks.\n
+  * @rv_inc_headers{hierodule_tim.h,the timer interrupt callbacks}
+  * @{
+  */
+
+#include <hierodule_tim.h>
+
+/** @brief Software timer mode enumeration.
+  */
+typedef enum
+{
+/** @brief The wheel ticks on every update event of the hardware timer.
+  */
+    HIERODULE_SWTIM_Mode_PERIODIC,
+/** @brief The hardware timer counts freely, one count being a tick, and
+  * the capture compare channel 1 is programmed for the next deadline only.
+  */
+    HIERODULE_SWTIM_Mode_TICKLESS
+
+} HIERODULE_SWTIM_Mode;
+
+/** @brief Forward declaration of the software timer struct, for the callback
+  * typedef.
+  */
+typedef struct HIERODULE_SWTIM_Timer HIERODULE_SWTIM_Timer;
+
+/** @brief Typedef for software timer expiry callbacks.
+  * @details Performed in the hardware timer's IRQ, with the expired timer
+  * and the context pointer it was created with.
+  */
+typedef void (*HIERODULE_SWTIM_Callback)
+(
+    HIERODULE_SWTIM_Timer *Timer,
+    void *Context
+);
+
+/** @brief Struct that keeps the state of a software timer.
+  * @details An array of these is handed to @ref HIERODULE_SWTIM_Init
+  * "HIERODULE_SWTIM_Init" as the pool timers are created from. Approach
+  * the fields as read-only.
+  */
+struct HIERODULE_SWTIM_Timer
+{
+/** @brief Next timer in the same wheel slot, or in the free list.
+  */
+    HIERODULE_SWTIM_Timer *Next;
+/** @brief Previous timer in the same wheel slot, NULL for the first one.
+  */
+    HIERODULE_SWTIM_Timer *Prev;
+/** @brief Tick the timer expires at.
+  */
+    uint32_t Expiry;
+/** @brief Delay the timer was last started with, in ticks.
+  */
+    uint32_t Delay;
+/** @brief Period of the timer in ticks, 0 for a one-shot timer.
+  */
+    uint32_t Period;
+/** @brief Pointer to the expiry callback.
+  */
+    HIERODULE_SWTIM_Callback Callback;
+/** @brief Pointer passed as is to the expiry callback.
+  */
+    void *Context;
+/** @brief Index of the wheel slot the timer is in, level times 64 plus
+  * slot, valid only while the timer is armed.
+  */
+    uint16_t Bucket;
+/** @brief 1 while the timer is armed, 0 otherwise.
+  */
+    uint8_t Armed;
+};
+
+/** @brief Initializes the software timer module on a hardware timer.
+  * @rv_param_timer
+  * @param Pool: Array of software timers to create timers from.
+  * @param PoolSize: Number of elements in the pool.
+  * @param Mode: Periodic or tickless.
+  * @return None
+  */
+void HIERODULE_SWTIM_Init
+(
+    TIM_TypeDef *Timer,
+    HIERODULE_SWTIM_Timer *Pool,
+    uint32_t PoolSize,
+    HIERODULE_SWTIM_Mode Mode
+);
+
+/** @brief Creates a software timer from the pool.
+  * @param Callback: Pointer to the expiry callback.
+  * @param Context: Pointer passed as is to the callback, may be NULL.
+  * @return Pointer to the timer, NULL if the pool is exhausted.
+  */
+HIERODULE_SWTIM_Timer *HIERODULE_SWTIM_Create
+(
+    HIERODULE_SWTIM_Callback Callback,
+    void *Context
+);
+
+/** @brief Stops a software timer and returns it to the pool.
+  * @param Timer: Pointer to the software timer.
+  * @return None
+  */
+void HIERODULE_SWTIM_Delete(HIERODULE_SWTIM_Timer *Timer);
+
+/** @brief Starts, or restarts if it's armed, a software timer.
+  * @param Timer: Pointer to the software timer.
+  * @param Delay: Ticks until the first expiry.
+  * @param Period: Ticks between subsequent expiries, 0 for a one-shot timer.
+  * @return None
+  */
+void HIERODULE_SWTIM_Start
+(
+    HIERODULE_SWTIM_Timer *Timer,
+    uint32_t Delay,
+    uint32_t Period
+);
+
+/** @brief Restarts a software timer with the delay and period it was last
+  * started with.
+  * @param Timer: Pointer to the software timer.
+  * @return None
+  */
+void HIERODULE_SWTIM_Restart(HIERODULE_SWTIM_Timer *Timer);
+
+/** @brief Stops a software timer.
+  * @param Timer: Pointer to the software timer.
+  * @return None
+  */
+void HIERODULE_SWTIM_Stop(HIERODULE_SWTIM_Timer *Timer);
+
+/** @brief Checks whether a software timer is armed.
+  * @param Timer: Pointer to the software timer.
+  * @return 1 if the timer is armed, 0 otherwise.
+  */
+uint32_t HIERODULE_SWTIM_IsArmed(HIERODULE_SWTIM_Timer *Timer);
+
+/** @brief Returns the current tick of the software timer module.
+  * @return Ticks elapsed since initialization, wrapping at 32 bits.
+  */
+uint32_t HIERODULE_SWTIM_GetTick(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_SWTIM_H */
@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tickless.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the tickless idle module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_TICKLESS_H
+#define __HIERODULE_TICKLESS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Tickless Tickless Idle Module
+  * @brief FreeRTOS tick and tickless idle on a timer compare channel
+  * @details @rv_refer_to_usage{TicklessUsage}
+  * @{
+  */
+/** @addtogroup TICKLESS_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of the tick setup and tickless idle routines for the
+  * FreeRTOS port, and precompiler constants to select the timer, the channel
+  * and the resolution of the tick.\n
+  * @rv_inc_headers{hierodule_tim.h,the timer interrupt callbacks}\n
+  * Also includes FreeRTOS.h and task.h, for the kernel routines and types.
+  * @{
+  */
+
+#include <hierodule_tim.h>
+#include <FreeRTOS.h>
+#include <task.h>
+
+/** @brief Precompiler constant to select the timer the RTOS tick runs on.
+  * @details The timer is occupied by the module, its prescaler and ARR are
+  * set to let the counter run freely.
+  */
+#define HIERODULE_TICKLESS_TIMER TIM3
+
+/** @brief Precompiler constant to select the capture compare channel that
+  * marks the ticks.
+  * @details Can be 1, 2, 3 or 4. The channel is occupied by the module and
+  * should be left in frozen output compare mode.
+  */
+#define HIERODULE_TICKLESS_CHANNEL 1
+
+/** @brief Precompiler constant to set the number of timer counts per RTOS
+  * tick.
+  * @details The timer counts at configTICK_RATE_HZ times this, which needs
+  * to divide the kernel clock of the timer, within the prescaler range.
+  * Fewer counts per tick allow for longer sleeps, as a sleep can't be
+  * longer than 65536 counts minus two ticks. 21845 counts at most.
+  */
+#define HIERODULE_TICKLESS_COUNTS_PER_TICK 8
+
+/** @brief Sets the timer up to generate the RTOS tick.
+  * @rv_param_timer
+  * @return None
+  */
+void HIERODULE_TICKLESS_Init(TIM_TypeDef *Timer);
+
+/** @brief Sleeps with the RTOS tick suppressed, for up to the expected idle
+  * time.
+  * @param ExpectedIdleTime: Ticks until a task is due to unblock.
+  * @return None
+  */
+void HIERODULE_TICKLESS_SuppressTicksAndSleep(TickType_t ExpectedIdleTime);
+
+/** @brief Returns the number of ticks spent asleep with the tick suppressed.
+  * @return Ticks since initialization, wrapping at 32 bits.
+  */
+uint32_t HIERODULE_TICKLESS_GetSleptTicks(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_TICKLESS_H */
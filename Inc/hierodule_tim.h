@@ -55,6 +55,124 @@ extern "C"
   */
 #define HIERODULE_TIM_CONVENIENT_IRQ
 
+/** @brief Precompiler constant to service every pending interrupt flag of a
+  * timer per IRQ entry.
+  * @details Commented out by default, only the first pending flag is then
+  * serviced per IRQ entry and the rest are left for the NVIC to tail-chain
+  * back in.\n
+  * When defined, the pending flags are read once and serviced one after
+  * another, in the order set by @ref HIERODULE_TIM_DISPATCH_URGENT
+  * "HIERODULE_TIM_DISPATCH_URGENT" and @ref HIERODULE_TIM_DISPATCH_ORDER
+  * "HIERODULE_TIM_DISPATCH_ORDER". This saves an exception entry per extra
+  * flag when flags come together, while other IRQs of the same priority wait
+  * for all of their handlers rather than one. Each flag is cleared before or
+  * after its handler, as set by @ref HIERODULE_TIM_CLEAR_BEFORE_HANDLER
+  * "HIERODULE_TIM_CLEAR_BEFORE_HANDLER".\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+//#define HIERODULE_TIM_DISPATCH_ALL_PENDING
+
+/** @brief Precompiler constant to clear interrupt flags before the ISRs
+  * assigned via the HIERODULE_TIM_Assign_ISR_* routines are performed.
+  * @details Commented out by default, a flag is cleared right after its ISR,
+  * as it's always been, and an event that comes while the ISR is running is
+  * lost. Only suitable for ISRs that are sure to finish well within a
+  * period, or that rely on the flag staying set while they run.\n
+  * When defined, a flag is cleared right before its ISR, so that the event
+  * coming again while the ISR is running sets the flag again and gets
+  * serviced on the next IRQ entry.\n
+  * Flags serviced by callbacks assigned via the
+  * HIERODULE_TIM_Assign_Callback_* routines are always cleared before them,
+  * either way. The utility modules rely on it, as their callbacks raise
+  * their own compare events when a deadline has passed by the time it's
+  * programmed.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+//#define HIERODULE_TIM_CLEAR_BEFORE_HANDLER
+
+/** @brief Precompiler constant to select the interrupt flags to be serviced
+  * before any other.
+  * @details A status register mask, break interrupt by default.\n
+  * @rv_def_req{HIERODULE_TIM_DISPATCH_ALL_PENDING}
+  */
+#define HIERODULE_TIM_DISPATCH_URGENT TIM_SR_BIF
+
+/** @brief Precompiler constant to select the order the rest of the pending
+  * interrupt flags are serviced in.
+  * @details When declared as 0, flags are serviced from the lowest status
+  * register bit up, i.e. update first. When declared as 1, from the highest
+  * bit down, i.e. capture compare channel 4 before channel 1.\n
+  * @rv_def_req{HIERODULE_TIM_DISPATCH_ALL_PENDING}
+  */
+#define HIERODULE_TIM_DISPATCH_ORDER 0
+
+/** @brief Precompiler constant to toggle the latency and duration
+  * measurements of timer interrupt handlers.
+  * @details When declared as 0, the measurements aren't compiled in at all.
+  * When declared as 1, statistics can be attached to any interrupt flag via
+  * @ref HIERODULE_TIM_AttachStats "HIERODULE_TIM_AttachStats", which costs
+  * a pointer check per flag serviced, plus the measurements for the flags
+  * that have statistics attached.\n
+  * A pointer check takes a few cycles, but a measurement is well over 20:
+  * the counter reads and the update of both sets of statistics take several
+  * dozen cycles on Cortex-M3 and M4. Cortex-M0 has neither the DWT cycle
+  * counter nor CLZ, so the duration takes two more reads of the timer
+  * counter and each histogram bin a library call, which costs more still.
+  * Attach statistics only to the flags under study.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+#define HIERODULE_TIM_INSTRUMENT 0
+
+/** @brief Precompiler constant to toggle the overrun detection of timer
+  * interrupt handlers.
+  * @details When declared as 0, the detection isn't compiled in at all.
+  * When declared as 1, each handler is checked for the event of its flag
+  * coming again while it was running, i.e. a missed deadline. Overruns are
+  * counted per flag, and passed to the hook assigned via
+  * @ref HIERODULE_TIM_Assign_OverrunHook "HIERODULE_TIM_Assign_OverrunHook"
+  * along with the number of overruns in a row.\n
+  * Flags cleared before their handlers, as set by
+  * @ref HIERODULE_TIM_CLEAR_BEFORE_HANDLER
+  * "HIERODULE_TIM_CLEAR_BEFORE_HANDLER", are checked via the flag itself.
+  * Of the flags cleared after, only the update flag is, via the counter
+  * wrapping while the handler runs.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+#define HIERODULE_TIM_DETECT_OVERRUN 0
+
+/** @brief Number of bins in the histograms of the interrupt statistics.
+  * @details Bin 0 counts zeros, bin n counts values from 2^(n-1) up to
+  * 2^n - 1, and the last bin counts everything above as well.
+  */
+#define HIERODULE_TIM_STATS_BINS 16
+
+/** @brief Precompiler constant to bound the prescaler search of the integer
+  * period and frequency setters.
+  * @details The solver tries this many prescaler values, starting from the
+  * smallest one that lets ARR reach the requested divider, and returns the
+  * closest PSC/ARR pair among them, stopping early at an exact one. A closer
+  * pair may lie past the span, e.g. a 72 MHz clock divided down to 1 Hz is
+  * split exactly only at the 27th candidate, 1125 * 64000. A larger span may
+  * find it at the cost of one 64-bit division per extra candidate.
+  */
+#define HIERODULE_TIM_SOLVER_SPAN 64
+
+/** @brief Precompiler constant to hold back update events while the batch
+  * compare setters write the compare registers.
+  * @details When defined, the UDIS bit is set for the duration of the
+  * writes, so that no update event can latch some of the new values but not
+  * the rest. An update event that lands in that window is skipped, along with
+  * its interrupt.
+
+  * When commented out, the writes are left unguarded, to be made atomic by
+  * the caller, e.g. by performing them right after the update event.
+  */
+#define HIERODULE_TIM_BATCH_UDIS
+
 #include <main.h>
 #include <stdlib.h>
 
@@ -65,6 +183,366 @@ extern "C"
   */
 typedef void (*FUNC_POINTER)(void);
 
+/** @brief Typedef for timer interrupt callbacks.
+  * @details The callback is given the timer, the status register mask of
+  * the flag being serviced and the context pointer it was assigned with, so
+  * that a single callback may serve many timers or objects.
+  */
+typedef void (*HIERODULE_TIM_Callback)
+(
+    TIM_TypeDef *Timer,
+    uint32_t Flags,
+    void *Context
+);
+
+/** @brief Typedef for the hook called on timer interrupt handler overruns.
+  * @details The hook is given the timer, the status register mask of the
+  * flag whose handler has overrun, and the number of overruns in a row.
+  */
+typedef void (*HIERODULE_TIM_OverrunHook)
+(
+    TIM_TypeDef *Timer,
+    uint32_t Flags,
+    uint32_t Depth
+);
+
+/** @brief Timer identifier enumeration.
+  * @details Each timer supported on the device is given a small, contiguous
+  * identifier, which is used to index the per-timer descriptors within the
+  * module. The last member is the number of timers, not a timer.
+  */
+typedef enum
+{
+/** \cond */
+#ifdef __STM32F030x6_H /** \endcond */
+    HIERODULE_TIM_ID_1,
+    HIERODULE_TIM_ID_3,
+    HIERODULE_TIM_ID_14,
+    HIERODULE_TIM_ID_16,
+    HIERODULE_TIM_ID_17,
+/** \cond */
+#elif defined __STM32F103xB_H /** \endcond */
+    HIERODULE_TIM_ID_1,
+    HIERODULE_TIM_ID_2,
+    HIERODULE_TIM_ID_3,
+    HIERODULE_TIM_ID_4,
+/** \cond */
+#elif defined __STM32F401xC_H /** \endcond */
+    HIERODULE_TIM_ID_1,
+    HIERODULE_TIM_ID_2,
+    HIERODULE_TIM_ID_3,
+    HIERODULE_TIM_ID_4,
+    HIERODULE_TIM_ID_5,
+    HIERODULE_TIM_ID_9,
+    HIERODULE_TIM_ID_10,
+    HIERODULE_TIM_ID_11,
+/** \cond */
+#endif /** \endcond */
+/** @brief Number of timers supported on the device.
+  */
+    HIERODULE_TIM_ID_COUNT
+
+} HIERODULE_TIM_ID;
+
+/** @brief Struct that keeps a pair of timers chained into a single logical
+  * 32 bit timer.
+  * @details Initialized via @ref HIERODULE_TIM_InitChain
+  * "HIERODULE_TIM_InitChain". Approach the fields as read-only.
+  */
+typedef struct
+{
+/** @brief Timer counting the low word, whose update event clocks the slave.
+  */
+    TIM_TypeDef *Master;
+/** @brief Timer counting the high word, clocked by the master.
+  */
+    TIM_TypeDef *Slave;
+} HIERODULE_TIM_Chain;
+
+/** @brief Struct that describes a member of a timer group.
+  */
+typedef struct
+{
+/** @brief Pointer to the member timer.
+  */
+    TIM_TypeDef *Timer;
+/** @brief Phase the member leads the master by, in Q15 of the period,
+  * 32768 being a full period.
+  * @details Loaded into the counter on each start of the group, may be
+  * changed while the group is stopped.
+  */
+    uint16_t Phase_Q15;
+} HIERODULE_TIM_GroupMember;
+
+/** @brief Struct that keeps a group of timers started together by a master.
+  * @details Initialized via @ref HIERODULE_TIM_InitGroup
+  * "HIERODULE_TIM_InitGroup". Approach the fields as read-only.
+  */
+typedef struct
+{
+/** @brief Timer whose counter enable starts the members.
+  */
+    TIM_TypeDef *Master;
+/** @brief Array of members.
+  */
+    HIERODULE_TIM_GroupMember *Members;
+/** @brief Number of members.
+  */
+    uint32_t Count;
+} HIERODULE_TIM_Group;
+
+/** @brief Struct that describes the break and dead time configuration of
+  * an advanced timer.
+  * @details Handed to @ref HIERODULE_TIM_ConfigureBridge
+  * "HIERODULE_TIM_ConfigureBridge", fields other than the dead time are
+  * taken as 0 for off, anything else for on.
+  */
+typedef struct
+{
+/** @brief Dead time inserted between complementary outputs, in
+  * nanoseconds.
+  */
+    uint32_t DeadTime_ns;
+/** @brief Lock level, 0 to 3, freezing the configuration up to the next
+  * reset. See the device manual for the bits each level locks.
+  */
+    uint8_t Lock;
+/** @brief Enables the break input.
+  */
+    uint8_t BreakEnable;
+/** @brief Makes the break input active high, active low otherwise.
+  */
+    uint8_t BreakActiveHigh;
+/** @brief Sets the main output enable again on the next update event after
+  * a break.
+  */
+    uint8_t AutomaticOutput;
+/** @brief Off-state selection for run mode, OSSR.
+  */
+    uint8_t OffStateRun;
+/** @brief Off-state selection for idle mode, OSSI.
+  */
+    uint8_t OffStateIdle;
+} HIERODULE_TIM_BridgeConfig;
+
+/** @brief Struct that keeps the latency and duration statistics of a timer
+  * interrupt flag.
+  * @details Attached via @ref HIERODULE_TIM_AttachStats
+  * "HIERODULE_TIM_AttachStats" and updated by the IRQ handler each time
+  * the flag is serviced. Read consistent copies via
+  * @ref HIERODULE_TIM_ReadStats "HIERODULE_TIM_ReadStats", approach the
+  * fields as read-only.\n
+  * Latency is the time from the event to the start of its handler, in
+  * counts of the timer. Duration is the time the handler takes, in core
+  * cycles on cores with a DWT cycle counter, Cortex-M3 and up, in counts of
+  * the timer otherwise. Means are the sums divided by the count.
+  */
+typedef struct
+{
+/** @brief Number of times the flag has been serviced.
+  */
+    volatile uint32_t Count;
+/** @brief Shortest latency, 0xFFFFFFFF while there's none.
+  */
+    uint32_t LatencyMin;
+/** @brief Longest latency.
+  */
+    uint32_t LatencyMax;
+/** @brief Sum of latencies.
+  */
+    uint64_t LatencySum;
+/** @brief Shortest duration, 0xFFFFFFFF while there's none.
+  */
+    uint32_t DurationMin;
+/** @brief Longest duration.
+  */
+    uint32_t DurationMax;
+/** @brief Sum of durations.
+  */
+    uint64_t DurationSum;
+/** @brief Log2 histogram of latencies.
+  */
+    uint32_t LatencyHistogram[HIERODULE_TIM_STATS_BINS];
+/** @brief Log2 histogram of durations.
+  */
+    uint32_t DurationHistogram[HIERODULE_TIM_STATS_BINS];
+} HIERODULE_TIM_Stats;
+
+/** @brief Capability flag of timers with a master mode controller, driving
+  * TRGO.
+  */
+#define HIERODULE_TIM_CAP_MASTER 0x01U
+
+/** @brief Capability flag of timers with a slave mode controller.
+  */
+#define HIERODULE_TIM_CAP_SLAVE 0x02U
+
+/** @brief Capability flag of timers with an encoder interface.
+  */
+#define HIERODULE_TIM_CAP_ENCODER 0x04U
+
+/** @brief Capability flag of timers that can count down and center-aligned.
+  */
+#define HIERODULE_TIM_CAP_UPDOWN 0x08U
+
+/** @brief Capability flag of timers with a repetition counter.
+  */
+#define HIERODULE_TIM_CAP_REPETITION 0x10U
+
+/** @brief Capability flag of timers with a break input.
+  */
+#define HIERODULE_TIM_CAP_BREAK 0x20U
+
+/** @brief DMA request flag of the update event.
+  * @details DMA request flags stand for bits 8 to 14 of DIER, shifted down
+  * by 8.
+  */
+#define HIERODULE_TIM_DMA_UP 0x01U
+
+/** @brief DMA request flag of capture compare channel 1.
+  */
+#define HIERODULE_TIM_DMA_CC1 0x02U
+
+/** @brief DMA request flag of capture compare channel 2.
+  */
+#define HIERODULE_TIM_DMA_CC2 0x04U
+
+/** @brief DMA request flag of capture compare channel 3.
+  */
+#define HIERODULE_TIM_DMA_CC3 0x08U
+
+/** @brief DMA request flag of capture compare channel 4.
+  */
+#define HIERODULE_TIM_DMA_CC4 0x10U
+
+/** @brief DMA request flag of the commutation event.
+  */
+#define HIERODULE_TIM_DMA_COM 0x20U
+
+/** @brief DMA request flag of the trigger event.
+  */
+#define HIERODULE_TIM_DMA_TRIG 0x40U
+
+/** @brief Struct that describes what a timer of the device can do.
+  * @details One is kept for each timer in a constant table within the
+  * module, see @ref HIERODULE_TIM_GetCapability
+  * "HIERODULE_TIM_GetCapability".
+  */
+typedef struct
+{
+/** @brief Number of the timer, n for TIMn.
+  */
+    uint8_t Number;
+/** @brief Counter width in bits, 16 or 32.
+  */
+    uint8_t Width;
+/** @brief Number of capture compare channels.
+  */
+    uint8_t Channels;
+/** @brief Number of channels with complementary outputs.
+  */
+    uint8_t Complementary;
+/** @brief Peripheral bus the timer is clocked by, 1 for APB1, 2 for APB2.
+  */
+    uint8_t Bus;
+/** @brief Combination of HIERODULE_TIM_CAP_* flags.
+  */
+    uint8_t Features;
+/** @brief Combination of HIERODULE_TIM_DMA_* flags, the DMA requests that
+  * are wired to a DMA channel or stream.
+  * @details See the DMA request mapping in the device manual for where.
+  */
+    uint8_t DmaRequests;
+/** @brief Set if an IRQ vector of the timer is shared with another timer.
+  */
+    uint8_t SharedIRQ;
+/** @brief IRQ vector of the update interrupt.
+  */
+    IRQn_Type UpdateIRQ;
+/** @brief IRQ vector of the capture compare interrupts.
+  */
+    IRQn_Type CaptureIRQ;
+} HIERODULE_TIM_Capability;
+
+/** @brief Struct that describes the least a timer needs to be capable of,
+  * to be allocated via @ref HIERODULE_TIM_Request "HIERODULE_TIM_Request".
+  * @details Fields are minimums, or masks of flags that are all required.
+  */
+typedef struct
+{
+/** @brief Minimum counter width in bits, 16 or 32. 0 for any.
+  */
+    uint8_t Width;
+/** @brief Minimum number of capture compare channels.
+  */
+    uint8_t Channels;
+/** @brief Minimum number of channels with complementary outputs.
+  */
+    uint8_t Complementary;
+/** @brief Combination of the HIERODULE_TIM_CAP_* flags required.
+  */
+    uint8_t Features;
+/** @brief Combination of the HIERODULE_TIM_DMA_* flags required.
+  */
+    uint8_t DmaRequests;
+/** @brief Requires IRQ vectors that aren't shared with another timer, if
+  * set.
+  */
+    uint8_t ExclusiveIRQ;
+} HIERODULE_TIM_Requirement;
+
+/** @brief Struct that keeps a timer allocated to its user.
+  * @details Filled in by @ref HIERODULE_TIM_Request "HIERODULE_TIM_Request"
+  * or @ref HIERODULE_TIM_Claim "HIERODULE_TIM_Claim". Approach the fields
+  * as read-only.
+  */
+typedef struct
+{
+/** @brief Pointer to the timer, to be passed to the rest of the module.
+  */
+    TIM_TypeDef *Timer;
+/** @brief Identifier of the timer, indexing its descriptor and callback
+  * slots within the module.
+  */
+    HIERODULE_TIM_ID ID;
+/** @brief Kernel clock of the timer at the time of allocation, in Hertz.
+  */
+    uint32_t KernelClock;
+/** @brief Pointer to the capabilities of the timer.
+  */
+    const HIERODULE_TIM_Capability *Capability;
+} HIERODULE_TIM_Handle;
+
+/** @brief Returns the capabilities of a timer.
+  * @rv_param_timer
+  * @return Pointer to the capabilities, NULL if the timer isn't supported.
+  */
+const HIERODULE_TIM_Capability *HIERODULE_TIM_GetCapability(
+    TIM_TypeDef *Timer);
+
+/** @brief Allocates the least capable free timer that meets a requirement.
+  * @param Requirement: Pointer to the requirement.
+  * @param Handle: Pointer to the handle to be filled in.
+  * @return 1 if a timer is allocated, 0 if none is free that meets the
+  * requirement.
+  */
+uint32_t HIERODULE_TIM_Request(const HIERODULE_TIM_Requirement *Requirement,
+    HIERODULE_TIM_Handle *Handle);
+
+/** @brief Allocates a specific timer.
+  * @rv_param_timer
+  * @param Handle: Pointer to the handle to be filled in.
+  * @return 1 if the timer is allocated, 0 if it's taken, reserved or not
+  * supported.
+  */
+uint32_t HIERODULE_TIM_Claim(TIM_TypeDef *Timer, HIERODULE_TIM_Handle *Handle);
+
+/** @brief Frees an allocated timer.
+  * @param Handle: Pointer to the handle of the timer.
+  * @return None
+  */
+void HIERODULE_TIM_Release(HIERODULE_TIM_Handle *Handle);
+
 /** @brief Sets the period duration of a timer.
   * @rv_param_timer
   * @param DurationSec: Duration of period in seconds.
@@ -91,6 +569,56 @@ void HIERODULE_TIM_SetFrequency(TIM_TypeDef *Timer, double Frequency_Hz);
   */
 double HIERODULE_TIM_GetFrequency(TIM_TypeDef *Timer);
 
+/** @brief Sets the period duration of a timer with integer arithmetic only,
+  * solving PSC and ARR together.
+  * @rv_param_timer
+  * @param Period_ns: Duration of period in nanoseconds.
+  * @return The period duration actually achieved, in nanoseconds.
+  * 0 if the requested period is 0.
+  */
+uint64_t HIERODULE_TIM_SetPeriod_ns(TIM_TypeDef *Timer, uint64_t Period_ns);
+
+/** @brief Sets the frequency of a timer with integer arithmetic only,
+  * solving PSC and ARR together.
+  * @rv_param_timer
+  * @param Frequency_mHz: Frequency in millihertz.
+  * @return The frequency actually achieved, in millihertz.
+  * 0 if the requested frequency is 0.
+  */
+uint64_t HIERODULE_TIM_SetFrequency_mHz(TIM_TypeDef *Timer,
+    uint64_t Frequency_mHz);
+
+/** @brief Returns the period of a timer in kernel clocks.
+  * @rv_param_timer
+  * @return (PSC+1)*(ARR+1).
+  */
+uint64_t HIERODULE_TIM_GetPeriod_Ticks(TIM_TypeDef *Timer);
+
+/** @brief Returns the period of a timer in nanoseconds, with integer
+  * arithmetic only.
+  * @rv_param_timer
+  * @return Period in nanoseconds.
+  */
+uint64_t HIERODULE_TIM_GetPeriod_ns(TIM_TypeDef *Timer);
+
+/** @brief Re-derives and caches the kernel clock of every timer.
+  * @return None
+  */
+void HIERODULE_TIM_RefreshClockCache(void);
+
+/** @brief Marks the cached kernel clocks as stale, so that they're re-derived
+  * on next use.
+  * @return None
+  */
+void HIERODULE_TIM_InvalidateClockCache(void);
+
+/** @brief Returns the kernel clock of a timer, the clock its prescaler is fed
+  * with.
+  * @rv_param_timer
+  * @return Frequency in Hertz.
+  */
+uint32_t HIERODULE_TIM_GetKernelClock(TIM_TypeDef *Timer);
+
 /** @brief Clears the counter register of a timer.
   * @rv_param_timer
   * @return None
@@ -161,6 +689,211 @@ void HIERODULE_TIM_SetDutyCycle(TIM_TypeDef *Timer, uint8_t Channel,
   */
 double HIERODULE_TIM_GetDutyCycle(TIM_TypeDef *Timer, uint8_t Channel);
 
+/** @brief Returns the duty cycle of the specified PWM output channel
+  * of a timer in Q15, with integer arithmetic only.
+  * @rv_param_timer
+  * @param Channel: Integer to specify the channel, 1 to 4.
+  * @return Duty cycle as a fraction of ARR+1, 32768 being 100%.
+  * 0 if the channel is invalid.
+  */
+uint32_t HIERODULE_TIM_GetDutyCycle_Q15(TIM_TypeDef *Timer, uint8_t Channel);
+
+/** @brief Returns the duty cycle of the specified PWM output channel
+  * of a timer in Q16.16, with integer arithmetic only.
+  * @rv_param_timer
+  * @param Channel: Integer to specify the channel, 1 to 4.
+  * @return Duty cycle as a fraction of ARR+1, 65536 being 100%.
+  * 0 if the channel is invalid.
+  */
+uint32_t HIERODULE_TIM_GetDutyCycle_Q16_16(TIM_TypeDef *Timer,
+    uint8_t Channel);
+
+/** @brief Enables the preload of ARR and the compare registers of the
+  * specified channels of a timer.
+  * @rv_param_timer
+  * @param ChannelMask: Bit n set for channel n+1.
+  * @return None
+  */
+void HIERODULE_TIM_EnablePreload(TIM_TypeDef *Timer, uint8_t ChannelMask);
+
+/** @brief Disables the preload of ARR and the compare registers of the
+  * specified channels of a timer.
+  * @rv_param_timer
+  * @param ChannelMask: Bit n set for channel n+1.
+  * @return None
+  */
+void HIERODULE_TIM_DisablePreload(TIM_TypeDef *Timer, uint8_t ChannelMask);
+
+/** @brief Sets the compare values of the specified channels of a timer, to
+  * take effect on the same update event.
+  * @rv_param_timer
+  * @param ChannelMask: Bit n set for channel n+1.
+  * @param Compare: Array of compare values, element n for channel n+1.
+  * @return None
+  */
+void HIERODULE_TIM_SetCompareBatch(TIM_TypeDef *Timer, uint8_t ChannelMask,
+    const uint32_t *Compare);
+
+/** @brief Sets the duty cycles of the specified channels of a timer, to
+  * take effect on the same update event.
+  * @rv_param_timer
+  * @param ChannelMask: Bit n set for channel n+1.
+  * @param DutyCycle_Q15: Array of duty cycles in Q15, 32768 being 100%,
+  * element n for channel n+1.
+  * @return None
+  */
+void HIERODULE_TIM_SetDutyCycleBatch_Q15(TIM_TypeDef *Timer,
+    uint8_t ChannelMask, const uint16_t *DutyCycle_Q15);
+
+/** @brief Chains two timers, the update event of the master clocking the
+  * counter of the slave, to make a single logical 32 bit timer.
+  * @param Chain: Pointer to the chain struct to initialize.
+  * @param Master: Pointer to the timer to count the low word.
+  * @param Slave: Pointer to the timer to count the high word.
+  * @return 1 if the slave can be clocked by the master, 0 otherwise.
+  */
+uint32_t HIERODULE_TIM_InitChain(HIERODULE_TIM_Chain *Chain,
+    TIM_TypeDef *Master, TIM_TypeDef *Slave);
+
+/** @brief Sets the period duration of a chain of timers with integer
+  * arithmetic only.
+  * @param Chain: Pointer to the chain.
+  * @param Period_ns: Duration of period in nanoseconds.
+  * @return The period duration actually achieved, in nanoseconds.
+  * 0 if the requested period is 0.
+  */
+uint64_t HIERODULE_TIM_SetChainPeriod_ns(HIERODULE_TIM_Chain *Chain,
+    uint64_t Period_ns);
+
+/** @brief Returns the period duration of a chain of timers.
+  * @param Chain: Pointer to the chain.
+  * @return Period duration in nanoseconds.
+  */
+uint64_t HIERODULE_TIM_GetChainPeriod_ns(HIERODULE_TIM_Chain *Chain);
+
+/** @brief Sets the frequency of a chain of timers with integer arithmetic
+  * only.
+  * @param Chain: Pointer to the chain.
+  * @param Frequency_mHz: Frequency in millihertz.
+  * @return The frequency actually achieved, in millihertz.
+  * 0 if the requested frequency is 0.
+  */
+uint64_t HIERODULE_TIM_SetChainFrequency_mHz(HIERODULE_TIM_Chain *Chain,
+    uint64_t Frequency_mHz);
+
+/** @brief Returns the frequency of a chain of timers.
+  * @param Chain: Pointer to the chain.
+  * @return Frequency in millihertz.
+  */
+uint64_t HIERODULE_TIM_GetChainFrequency_mHz(HIERODULE_TIM_Chain *Chain);
+
+/** @brief Returns the logical 32 bit counter of a chain of timers.
+  * @param Chain: Pointer to the chain.
+  * @return Counts of the prescaled master clock since the last wrap of the
+  * chain.
+  */
+uint32_t HIERODULE_TIM_GetChainCounter(HIERODULE_TIM_Chain *Chain);
+
+/** @brief Clears the counters of both timers of a chain.
+  * @param Chain: Pointer to the chain.
+  * @return None
+  */
+void HIERODULE_TIM_ClearChainCounter(HIERODULE_TIM_Chain *Chain);
+
+/** @brief Enables the counters of both timers of a chain.
+  * @param Chain: Pointer to the chain.
+  * @return None
+  */
+void HIERODULE_TIM_EnableChainCounter(HIERODULE_TIM_Chain *Chain);
+
+/** @brief Disables the counters of both timers of a chain.
+  * @param Chain: Pointer to the chain.
+  * @return None
+  */
+void HIERODULE_TIM_DisableChainCounter(HIERODULE_TIM_Chain *Chain);
+
+/** @brief Sets a group of timers up to be started together by a master
+  * timer.
+  * @param Group: Pointer to the group struct to initialize.
+  * @param Master: Pointer to the master timer.
+  * @param Members: Array of members, excluding the master.
+  * @param Count: Number of members.
+  * @return 1 if every member can be triggered by the master, 0 otherwise.
+  */
+uint32_t HIERODULE_TIM_InitGroup(HIERODULE_TIM_Group *Group,
+    TIM_TypeDef *Master, HIERODULE_TIM_GroupMember *Members, uint32_t Count);
+
+/** @brief Starts the timers of a group together, with the phases of the
+  * members.
+  * @param Group: Pointer to the group.
+  * @return None
+  */
+void HIERODULE_TIM_StartGroup(HIERODULE_TIM_Group *Group);
+
+/** @brief Stops the timers of a group.
+  * @param Group: Pointer to the group.
+  * @return None
+  */
+void HIERODULE_TIM_StopGroup(HIERODULE_TIM_Group *Group);
+
+/** @brief Configures the break input, the lock level and the dead time of
+  * an advanced timer, in a single register write.
+  * @rv_param_timer
+  * @param Config: Pointer to the configuration.
+  * @return The dead time actually achieved, in nanoseconds.
+  */
+uint32_t HIERODULE_TIM_ConfigureBridge(TIM_TypeDef *Timer,
+    const HIERODULE_TIM_BridgeConfig *Config);
+
+/** @brief Sets the dead time of an advanced timer.
+  * @rv_param_timer
+  * @param DeadTime_ns: Dead time in nanoseconds.
+  * @return The dead time actually achieved, in nanoseconds.
+  */
+uint32_t HIERODULE_TIM_SetDeadTime_ns(TIM_TypeDef *Timer,
+    uint32_t DeadTime_ns);
+
+/** @brief Returns the dead time of an advanced timer.
+  * @rv_param_timer
+  * @return Dead time in nanoseconds.
+  */
+uint32_t HIERODULE_TIM_GetDeadTime_ns(TIM_TypeDef *Timer);
+
+/** @brief Enables the preload of the output modes and enables of an
+  * advanced timer's channels, to be latched together on a commutation
+  * event.
+  * @rv_param_timer
+  * @param OnTrigger: 1 to latch on a rising edge of the trigger input as
+  * well as by software, 0 to latch by software only.
+  * @return None
+  */
+void HIERODULE_TIM_EnableCommutationPreload(TIM_TypeDef *Timer,
+    uint8_t OnTrigger);
+
+/** @brief Disables the preload of the output modes and enables of an
+  * advanced timer's channels.
+  * @rv_param_timer
+  * @return None
+  */
+void HIERODULE_TIM_DisableCommutationPreload(TIM_TypeDef *Timer);
+
+/** @brief Preloads the output modes and enables of channels 1 to 3 of an
+  * advanced timer for a step of six-step commutation.
+  * @rv_param_timer
+  * @param Step: Commutation step, 1 to 6.
+  * @param Complementary: 1 to drive the low side of the switching phase
+  * complementary to its high side, 0 to keep it off.
+  * @return None
+  */
+void HIERODULE_TIM_PrepareSixStep(TIM_TypeDef *Timer, uint8_t Step,
+    uint8_t Complementary);
+
+/** @brief Generates a commutation event by software.
+  * @rv_param_timer
+  * @return None
+  */
+void HIERODULE_TIM_GenerateCommutation(TIM_TypeDef *Timer);
+
 /** @brief @rv_action_periph_it_flag{Clears, update, timer}
   * @rv_param_timer
   * @return None
@@ -427,6 +1160,155 @@ uint32_t HIERODULE_TIM_IsEnabledCounter(TIM_TypeDef *Timer);
   * @return None
   */
         void HIERODULE_TIM_Assign_ISR_BRK(TIM_TypeDef *Timer, FUNC_POINTER ISR);
+
+/** @brief @rv_tim_assign_cb_conv{update}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @rv_param_cb
+  * @return None
+  */
+        void HIERODULE_TIM_Assign_Callback_UPD
+        (
+            TIM_TypeDef *Timer,
+            HIERODULE_TIM_Callback Callback,
+            void *Context
+        );
+
+/** @brief @rv_tim_assign_cb_conv{capture compare channel 1}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @rv_param_cb
+  * @return None
+  */
+        void HIERODULE_TIM_Assign_Callback_CC1
+        (
+            TIM_TypeDef *Timer,
+            HIERODULE_TIM_Callback Callback,
+            void *Context
+        );
+
+/** @brief @rv_tim_assign_cb_conv{capture compare channel 2}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @rv_param_cb
+  * @return None
+  */
+        void HIERODULE_TIM_Assign_Callback_CC2
+        (
+            TIM_TypeDef *Timer,
+            HIERODULE_TIM_Callback Callback,
+            void *Context
+        );
+
+/** @brief @rv_tim_assign_cb_conv{capture compare channel 3}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @rv_param_cb
+  * @return None
+  */
+        void HIERODULE_TIM_Assign_Callback_CC3
+        (
+            TIM_TypeDef *Timer,
+            HIERODULE_TIM_Callback Callback,
+            void *Context
+        );
+
+/** @brief @rv_tim_assign_cb_conv{capture compare channel 4}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @rv_param_cb
+  * @return None
+  */
+        void HIERODULE_TIM_Assign_Callback_CC4
+        (
+            TIM_TypeDef *Timer,
+            HIERODULE_TIM_Callback Callback,
+            void *Context
+        );
+
+/** @brief @rv_tim_assign_cb_conv{break}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @rv_param_cb
+  * @return None
+  */
+        void HIERODULE_TIM_Assign_Callback_BRK
+        (
+            TIM_TypeDef *Timer,
+            HIERODULE_TIM_Callback Callback,
+            void *Context
+        );
+
+        /** \cond */
+        #if (HIERODULE_TIM_INSTRUMENT == 1) /** \endcond */
+/** @brief Attaches statistics to an interrupt flag of a timer, or detaches
+  * them.\n
+  * @rv_def_req{HIERODULE_TIM_INSTRUMENT}
+  * @rv_param_timer
+  * @param Flag: Status register mask of the flag, e.g. TIM_SR_CC1IF.
+  * @param Stats: Pointer to the statistics, NULL to detach.
+  * @return None
+  */
+        void HIERODULE_TIM_AttachStats
+        (
+            TIM_TypeDef *Timer,
+            uint32_t Flag,
+            HIERODULE_TIM_Stats *Stats
+        );
+
+/** @brief Clears statistics.\n
+  * @rv_def_req{HIERODULE_TIM_INSTRUMENT}
+  * @param Stats: Pointer to the statistics.
+  * @return None
+  */
+        void HIERODULE_TIM_ResetStats(HIERODULE_TIM_Stats *Stats);
+
+/** @brief Copies statistics while they're being updated.\n
+  * @rv_def_req{HIERODULE_TIM_INSTRUMENT}
+  * @param Stats: Pointer to the attached statistics.
+  * @param Copy: Pointer to the copy.
+  * @return None
+  */
+        void HIERODULE_TIM_ReadStats
+        (
+            const HIERODULE_TIM_Stats *Stats,
+            HIERODULE_TIM_Stats *Copy
+        );
+        /** \cond */
+        #endif
+
+        #if (HIERODULE_TIM_DETECT_OVERRUN == 1) /** \endcond */
+/** @brief Assigns the hook called on handler overruns.\n
+  * @rv_def_req{HIERODULE_TIM_DETECT_OVERRUN}
+  * @param Hook: Pointer to the hook, NULL for none.
+  * @return None
+  */
+        void HIERODULE_TIM_Assign_OverrunHook(HIERODULE_TIM_OverrunHook Hook);
+
+/** @brief Returns the number of times the handler of an interrupt flag of
+  * a timer has overrun.\n
+  * @rv_def_req{HIERODULE_TIM_DETECT_OVERRUN}
+  * @rv_param_timer
+  * @param Flag: Status register mask of the flag, e.g. TIM_SR_UIF.
+  * @return Number of overruns since the last clear, wrapping at 32 bits.
+  */
+        uint32_t HIERODULE_TIM_GetOverruns(TIM_TypeDef *Timer, uint32_t Flag);
+
+/** @brief Clears the overrun count of an interrupt flag of a timer.\n
+  * @rv_def_req{HIERODULE_TIM_DETECT_OVERRUN}
+  * @rv_param_timer
+  * @param Flag: Status register mask of the flag, e.g. TIM_SR_UIF.
+  * @return None
+  */
+        void HIERODULE_TIM_ClearOverruns(TIM_TypeDef *Timer, uint32_t Flag);
+        /** \cond */
+        #endif /** \endcond */
     /** \cond */
     #else /** \endcond */
 /** @brief @rv_tim_assign_isr_plain{timer 1 capture compare}\n
@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tstamp.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the timestamp module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_TSTAMP_H
+#define __HIERODULE_TSTAMP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Tstamp Timestamp Module
+  * @brief 64 bit monotonic timestamps off a 16 bit timer
+  * @details @rv_refer_to_usage{TstampUsage}
+  * @{
+  */
+/** @addtogroup TSTAMP_Public Global
+  * @brief @rv_global_private_brief{are not} @rv_corresponds_exc_irqs{header}
+  * @details Consists of timestamp routines and a precompiler constant to
+  * select the capture compare channel the module occupies.\n
+  * @rv_inc_headers{hierodule_tim.h,the timer interrupt callbacks}
+  * @{
+  */
+
+#include <hierodule_tim.h>
+
+/** @brief Precompiler constant to select the capture compare channel that
+  * marks the half period of the timer.
+  * @details Can be 1, 2, 3 or 4. The channel is occupied by the module and
+  * should be left in frozen output compare mode.
+  */
+#define HIERODULE_TSTAMP_CHANNEL 1
+
+/** @brief Initializes the timestamp module on a timer.
+  * @rv_param_timer
+  * @return None
+  */
+void HIERODULE_TSTAMP_Init(TIM_TypeDef *Timer);
+
+/** @brief Returns the current timestamp.
+  * @return Counts of the timer elapsed since initialization.
+  */
+uint64_t HIERODULE_TSTAMP_Get(void);
+
+/** @brief Returns the lower 32 bits of the current timestamp.
+  * @return Counts of the timer elapsed since initialization, wrapping at 32
+  * bits.
+  */
+uint32_t HIERODULE_TSTAMP_Get32(void);
+
+/** @brief Returns the frequency the timestamps count at.
+  * @return Frequency in Hertz.
+  */
+uint32_t HIERODULE_TSTAMP_GetFrequency(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_TSTAMP_H */
@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_wave.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Header file for the waveform module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HIERODULE_WAVE_H
+#define __HIERODULE_WAVE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Hierodule_Wave Waveform Module
+  * @brief PWM waveform streaming from a table, via timer DMA bursts
+  * @details @rv_refer_to_usage{WaveUsage}
+  * @{
+  */
+/** @addtogroup WAVE_Public Global
+  * @brief @rv_global_private_brief{are not}
+  * @details Consists of waveform streaming and table generation routines,
+  * the stream struct and a typedef for the refill callbacks.\n
+  * @rv_inc_headers{hierodule_tim.h and hierodule_dma.h,the preload and DMA
+  * routines}
+  * @{
+  */
+
+#include <hierodule_tim.h>
+#include <hierodule_dma.h>
+
+/** @brief Forward declaration of the stream struct, for the callback
+  * typedef.
+  */
+typedef struct HIERODULE_WAVE_Stream HIERODULE_WAVE_Stream;
+
+/** @brief Typedef for refill callbacks.
+  * @details Performed in the DMA IRQ, with the stream, the half of the table
+  * that's just been sent out, its number of frames and the context pointer
+  * the stream was initialized with.
+  */
+typedef void (*HIERODULE_WAVE_Callback)
+(
+    HIERODULE_WAVE_Stream *Stream,
+    uint16_t *Half,
+    uint32_t Frames,
+    void *Context
+);
+
+/** @brief Struct that keeps the state of a waveform stream.
+  * @details Allocated by the caller and set up by @ref HIERODULE_WAVE_Init
+  * "HIERODULE_WAVE_Init", approach the fields as read-only.
+  */
+struct HIERODULE_WAVE_Stream
+{
+/** @brief The timer the waveform is output on.
+  */
+    TIM_TypeDef *Timer;
+/** @brief The DMA channel the update request of the timer is wired to.
+  */
+    HIERODULE_DMA_Link Link;
+/** @brief The table of compare values, interleaved, one frame per update
+  * event, one value per channel in each frame.
+  */
+    uint16_t *Table;
+/** @brief Number of frames in the table.
+  */
+    uint32_t Frames;
+/** @brief Number of channels fed per frame, starting from channel 1.
+  */
+    uint8_t Channels;
+/** @brief Pointer to the refill callback, may be NULL for a fixed table.
+  */
+    HIERODULE_WAVE_Callback Refill;
+/** @brief Pointer passed as is to the refill callback.
+  */
+    void *Context;
+};
+
+/** @brief Initializes a waveform stream.
+  * @param Stream: Pointer to the stream.
+  * @rv_param_timer
+  * @param Link: Pointer to the DMA channel the update request of the timer
+  * is wired to, copied into the stream.
+  * @param Table: Table of compare values.
+  * @param Frames: Number of frames in the table, even and above 0.
+  * @param Channels: Number of channels fed per frame, 1 to 4.
+  * @param Refill: Pointer to the refill callback, may be NULL.
+  * @param Context: Pointer passed as is to the callback, may be NULL.
+  * @return None
+  */
+void HIERODULE_WAVE_Init
+(
+    HIERODULE_WAVE_Stream *Stream,
+    TIM_TypeDef *Timer,
+    const HIERODULE_DMA_Link *Link,
+    uint16_t *Table,
+    uint32_t Frames,
+    uint8_t Channels,
+    HIERODULE_WAVE_Callback Refill,
+    void *Context
+);
+
+/** @brief Starts streaming the table to the compare registers.
+  * @param Stream: Pointer to the stream.
+  * @return None
+  */
+void HIERODULE_WAVE_Start(HIERODULE_WAVE_Stream *Stream);
+
+/** @brief Stops streaming.
+  * @param Stream: Pointer to the stream.
+  * @return None
+  */
+void HIERODULE_WAVE_Stop(HIERODULE_WAVE_Stream *Stream);
+
+/** @brief Services the DMA interrupts of a stream.
+  * @param Stream: Pointer to the stream.
+  * @return None
+  */
+void HIERODULE_WAVE_Service(HIERODULE_WAVE_Stream *Stream);
+
+/** @brief Returns the sine of a phase.
+  * @param Phase: Phase, a full turn being 2^32.
+  * @return Sine in Q15.
+  */
+int16_t HIERODULE_WAVE_Sine_Q15(uint32_t Phase);
+
+/** @brief Fills a channel of a table with a sine wave.
+  * @param Table: Table of compare values.
+  * @param Frames: Number of frames to fill.
+  * @param Channels: Number of channels per frame.
+  * @param Channel: Channel to fill, 1 to Channels.
+  * @param Phase: Phase of the first frame, a full turn being 2^32.
+  * @param PhaseStep: Phase advance per frame.
+  * @param Amplitude: Peak deviation from the offset, in counts.
+  * @param Offset: Compare value of the zero crossings.
+  * @return Phase of the frame that would come next.
+  */
+uint32_t HIERODULE_WAVE_FillSine
+(
+    uint16_t *Table,
+    uint32_t Frames,
+    uint8_t Channels,
+    uint8_t Channel,
+    uint32_t Phase,
+    uint32_t PhaseStep,
+    uint16_t Amplitude,
+    uint16_t Offset
+);
+
+/** @brief Fills a channel of a table with compare values dithering a duty
+  * cycle finer than a count, via a first order sigma-delta modulator.
+  * @param Table: Table of compare values.
+  * @param Frames: Number of frames to fill.
+  * @param Channels: Number of channels per frame.
+  * @param Channel: Channel to fill, 1 to Channels.
+  * @param Residue: Fraction of a count carried over from the previous
+  * fill, in Q31, 0 to start with.
+  * @param Duty_Q31: Duty cycle in Q31, 2^31 being 100%.
+  * @param Period: Period of the timer in counts, ARR+1.
+  * @return Fraction of a count to carry over to the next fill, in Q31.
+  */
+uint32_t HIERODULE_WAVE_FillDither
+(
+    uint16_t *Table,
+    uint32_t Frames,
+    uint8_t Channels,
+    uint8_t Channel,
+    uint32_t Residue,
+    uint32_t Duty_Q31,
+    uint32_t Period
+);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HIERODULE_WAVE_H */
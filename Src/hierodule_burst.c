@@ -0,0 +1,267 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_burst.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the pulse burst module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_burst.h>
+
+/** @addtogroup Hierodule_Burst Pulse Burst Module
+  * @{
+  */
+
+/** @addtogroup BURST_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the chunk loading and the update callback that are used
+  * to implement those.
+  * @{
+  */
+
+/** \cond */
+#define CCMR_FIELD  0xFFUL
+#define PWM2_PRELOAD (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1M_0 \
+    | TIM_CCMR1_OC1PE)
+/** \endcond */
+
+/** @brief Loads the next chunk of a burst into the preload of the
+  * repetition counter, or marks the running chunk as the last one.
+  * @param Generator: Pointer to the generator.
+  * @return None
+  * @details The repetition counter is reloaded from its preload on the
+  * update event that ends a chunk, so the next chunk follows with no gap.
+  * If there are no more pulses to load, the one-pulse mode is set instead,
+  * to stop the counter on the update event that ends the running chunk.
+  */
+static void LoadChunk(HIERODULE_BURST_Generator *Generator)
+{
+    uint32_t Chunk = Generator->Remaining;
+
+    if(Chunk == 0)
+    {
+        SET_BIT(Generator->Timer->CR1, TIM_CR1_OPM);
+        return;
+    }
+
+    if(Chunk > HIERODULE_BURST_CHUNK)
+    {
+        Chunk = HIERODULE_BURST_CHUNK;
+    }
+    HIERODULE_TIM_SetRepetition(Generator->Timer, Chunk - 1);
+    Generator->Remaining -= Chunk;
+}
+
+/** @brief Update callback of the generator's timer.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Pointer to the generator.
+  * @return None
+  * @details Triggered only when the repetition counter runs out, once per
+  * chunk rather than once per pulse. If the one-pulse mode is set, the
+  * event ended the burst and stopped the counter, so the completion
+  * callback is performed. Otherwise, the next chunk has just started and
+  * the one after it is loaded.
+  */
+static void Update(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    HIERODULE_BURST_Generator *Generator = (HIERODULE_BURST_Generator*)Context;
+
+    (void)Flags;
+
+    if(Generator->Active == 0)
+    {
+        return;
+    }
+
+    if(READ_BIT(Timer->CR1, TIM_CR1_OPM))
+    {
+        Generator->Active = 0;
+        if(Generator->Callback != NULL)
+        {
+            Generator->Callback(Generator, Generator->Context);
+        }
+        return;
+    }
+
+    LoadChunk(Generator);
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup BURST_Public Global
+  * @{
+  */
+
+/** @details The channel is set to PWM mode 2 with its compare preload
+  * enabled, so that each pulse is at the end of its period and the output
+  * is inactive while the counter is stopped at 0. The preload of ARR is
+  * enabled, and the channel output is enabled. The main output is left for
+  * the caller.\n
+  * The update interrupt is taken over via
+  * @ref HIERODULE_TIM_Assign_Callback_UPD "HIERODULE_TIM_Assign_Callback_UPD"
+  * and enabled, the NVIC line of the timer is left for the caller to
+  * enable.\n
+  * The channel should be 1 to 4, the generator is left unusable and the
+  * timer untouched otherwise, configuring and starting it failing.\n
+  * @rv_req_xreg{repetition counter}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+void HIERODULE_BURST_Init
+(
+    HIERODULE_BURST_Generator *Generator,
+    TIM_TypeDef *Timer,
+    uint8_t Channel,
+    HIERODULE_BURST_Callback Callback,
+    void *Context
+)
+{
+    uint32_t Index = Channel - 1;
+    volatile uint32_t *ModeRegister;
+
+    Generator->Timer = Timer;
+    Generator->Compare = NULL;
+    Generator->Remaining = 0;
+    Generator->Active = 0;
+    Generator->Width = 0;
+    Generator->Callback = Callback;
+    Generator->Context = Context;
+
+    if( (Channel < 1) || (Channel > 4) )
+    {
+        return;
+    }
+
+    ModeRegister = (Index < 2) ? &Timer->CCMR1 : &Timer->CCMR2;
+    Generator->Compare = &Timer->CCR1 + Index;
+
+    HIERODULE_TIM_DisableCounter(Timer);
+    MODIFY_REG(*ModeRegister, CCMR_FIELD << ((Index & 1) << 3),
+        PWM2_PRELOAD << ((Index & 1) << 3));
+    SET_BIT(Timer->CR1, TIM_CR1_ARPE);
+    HIERODULE_TIM_EnableChannel(Timer, (int8_t)Channel);
+
+    HIERODULE_TIM_Assign_Callback_UPD(Timer, &Update, Generator);
+    HIERODULE_TIM_ClearFlag_UPD(Timer);
+    HIERODULE_TIM_Enable_IT_UPD(Timer);
+}
+
+/** @details The period is set via @ref HIERODULE_TIM_SetFrequency_mHz
+  * "HIERODULE_TIM_SetFrequency_mHz", and the width is converted to counts
+  * of the new prescaler, rounded. Widths as long as the period or longer
+  * make a constant output.\n
+  * All of it is preloaded, to be latched at the start of the next burst.
+  */
+uint64_t HIERODULE_BURST_Configure
+(
+    HIERODULE_BURST_Generator *Generator,
+    uint64_t Frequency_mHz,
+    uint32_t Width_ns
+)
+{
+    TIM_TypeDef *Timer = Generator->Timer;
+    uint64_t Achieved;
+    uint64_t Tick;
+    uint64_t Period;
+
+    if( (Generator->Compare == NULL) || Generator->Active )
+    {
+        return 0;
+    }
+
+    Achieved = HIERODULE_TIM_SetFrequency_mHz(Timer, Frequency_mHz);
+    if(Achieved == 0)
+    {
+        return 0;
+    }
+
+    Tick = HIERODULE_TIM_GetKernelClock(Timer) / (READ_REG(Timer->PSC) + 1);
+    Period = (uint64_t)READ_REG(Timer->ARR) + 1;
+    Generator->Width = (uint32_t)( (Width_ns * Tick + 500000000UL) /
+        1000000000UL );
+
+    *Generator->Compare = (Generator->Width < Period)
+        ? (uint32_t)(Period - Generator->Width) : 0;
+
+    return Achieved;
+}
+
+/** @details The first chunk takes the remainder of the count over
+  * @ref HIERODULE_BURST_CHUNK "HIERODULE_BURST_CHUNK", so that every chunk
+  * after it is full, leaving the update interrupt a full chunk of pulses to
+  * load the next one in.\n
+  * The first chunk, along with the preloaded period and compare values, is
+  * latched via a software update event, with URS held so that no update
+  * interrupt is triggered, then the next chunk is loaded and the counter
+  * is started. Pulses are counted by the hardware alone, an interrupt load
+  * can only delay chunk loads, which have a chunk's time to complete.
+  */
+uint32_t HIERODULE_BURST_Start
+(
+    HIERODULE_BURST_Generator *Generator,
+    uint32_t Count
+)
+{
+    TIM_TypeDef *Timer = Generator->Timer;
+    uint32_t First = Count % HIERODULE_BURST_CHUNK;
+
+    if( (Count == 0) || (Generator->Compare == NULL) || Generator->Active )
+    {
+        return 0;
+    }
+
+    if(First == 0)
+    {
+        First = HIERODULE_BURST_CHUNK;
+    }
+
+    CLEAR_BIT(Timer->CR1, TIM_CR1_OPM);
+    HIERODULE_TIM_SetRepetition(Timer, First - 1);
+    SET_BIT(Timer->CR1, TIM_CR1_URS);
+    WRITE_REG(Timer->EGR, TIM_EGR_UG);
+    CLEAR_BIT(Timer->CR1, TIM_CR1_URS);
+
+    Generator->Remaining = Count - First;
+    LoadChunk(Generator);
+
+    HIERODULE_TIM_ClearFlag_UPD(Timer);
+    Generator->Active = 1;
+    HIERODULE_TIM_EnableCounter(Timer);
+
+    return 1;
+}
+
+/** @details The counter is stopped and cleared right away, so the burst is
+  * cut short; the pulse being output, if any, is cut as well. The
+  * completion callback isn't performed.
+  */
+void HIERODULE_BURST_Stop(HIERODULE_BURST_Generator *Generator)
+{
+    HIERODULE_TIM_DisableCounter(Generator->Timer);
+    Generator->Active = 0;
+    Generator->Remaining = 0;
+    HIERODULE_TIM_ClearCounter(Generator->Timer);
+    HIERODULE_TIM_ClearFlag_UPD(Generator->Timer);
+}
+
+/** @details @rv_obvious
+  */
+uint32_t HIERODULE_BURST_IsActive(HIERODULE_BURST_Generator *Generator)
+{
+    return Generator->Active;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,228 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_delay.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the delay module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_delay.h>
+
+/** @addtogroup Hierodule_Delay Delay Module
+  * @{
+  */
+
+/** @addtogroup DELAY_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the microsecond scale factor and the waited time
+  * accumulator.
+  * @{
+  */
+
+/** \cond */
+#define MAX_SPAN    0x7FFFFFFFUL
+#define COUNT_MASK  0xFFFFUL
+/** \endcond */
+
+/** @brief Counts of the timestamp timer per microsecond, in Q32.32 format.
+  * @details Rounded up, so that the delays are never shorter than asked.
+  */
+static uint64_t CountsPerMicrosecond = 0;
+
+/** @brief Counts of the timestamp timer spent in the blocking routines.
+  */
+static uint64_t Waited = 0;
+
+/** @brief Converts microseconds to counts of the timestamp timer.
+  * @param Microseconds Time to convert.
+  * @return Counts, rounded up and saturated at 2^31 - 1.
+  * @details The 32 by 64 bit product is split at bit 32, the fraction of
+  * the lower half is rounded up on its own. No division is involved.
+  */
+static uint32_t ToCounts(uint32_t Microseconds)
+{
+    uint64_t Whole = (uint64_t)Microseconds *
+        (uint32_t)(CountsPerMicrosecond >> 32);
+    uint64_t Fraction = (uint64_t)Microseconds *
+        (uint32_t)CountsPerMicrosecond;
+
+    Whole += (Fraction + 0xFFFFFFFFUL) >> 32;
+
+    return (Whole > MAX_SPAN) ? MAX_SPAN : (uint32_t)Whole;
+}
+
+/** @brief Returns the counts elapsed since the last call of a wait, and
+  * moves its timestamp on.
+  * @param Last Pointer to the lower 32 bits of the last timestamp read.
+  * @return Counts elapsed.
+  * @details If the wait can't be preempted by the interrupts of the
+  * timestamp timer, e.g. with PRIMASK set or in an ISR of the same or a
+  * higher priority, the timestamps can make up for only one half period
+  * event that's pending. Past the next wrap of the counter, they fall back
+  * a whole period, 65536 counts, until the interrupts are serviced.\n
+  * Such a step back shows up as a negative difference, so the difference
+  * of the counter alone is taken instead, which is right as long as the
+  * wait reads the timestamp at least once a period. It does, spinning on
+  * it. Otherwise the timestamps are right, and so is their difference, no
+  * matter how long the wait was preempted for.
+  */
+static uint32_t Advance(uint32_t *Last)
+{
+    uint32_t Now = HIERODULE_TSTAMP_Get32();
+    uint32_t Step = Now - *Last;
+
+    if( (int32_t)Step < 0 )
+    {
+        Step &= COUNT_MASK;
+    }
+    *Last = Now;
+
+    return Step;
+}
+
+/** @brief Adds the time elapsed in a wait to the waited time.
+  * @param Elapsed Counts elapsed.
+  * @return None
+  */
+static void Account(uint32_t Elapsed)
+{
+    uint32_t Mask = __get_PRIMASK();
+
+    __disable_irq();
+    Waited += Elapsed;
+    __set_PRIMASK(Mask);
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup DELAY_Public Global
+  * @{
+  */
+
+/** @details The scale factor is computed once off @ref
+  * HIERODULE_TSTAMP_GetFrequency "HIERODULE_TSTAMP_GetFrequency", so call
+  * this after @ref HIERODULE_TSTAMP_Init "HIERODULE_TSTAMP_Init", and again
+  * if the prescaler or the kernel clock of the timestamp timer changes. The
+  * waited time is cleared as well.
+  */
+void HIERODULE_DELAY_Init(void)
+{
+    uint64_t Frequency = HIERODULE_TSTAMP_GetFrequency();
+
+    CountsPerMicrosecond = ((Frequency << 32) + 999999U) / 1000000U;
+    HIERODULE_DELAY_ResetWaited();
+}
+
+/** @details One count is added on top of the converted time, since the
+  * current count is already partially elapsed. The time is saturated at
+  * 2^31 - 1 counts.
+  */
+HIERODULE_DELAY_Deadline HIERODULE_DELAY_After_us(uint32_t Microseconds)
+{
+    return HIERODULE_TSTAMP_Get32() + ToCounts(Microseconds) + 1U;
+}
+
+/** @details Compares the deadline to the current timestamp, so it's only
+  * as right as the timestamps are. Where the interrupts of the timestamp
+  * timer can't preempt the caller, that is for half a period of the timer
+  * at most, use @ref HIERODULE_DELAY_WaitUntil "HIERODULE_DELAY_WaitUntil"
+  * there instead, which isn't bound by it.
+  */
+uint8_t HIERODULE_DELAY_Expired(HIERODULE_DELAY_Deadline Deadline)
+{
+    return ( (int32_t)(HIERODULE_TSTAMP_Get32() - Deadline) >= 0 ) ? 1 : 0;
+}
+
+/** @details Spins on the timestamp, so the time is kept regardless of the
+  * core clock, the compiler's optimization level or the interrupts taken in
+  * between. May block longer by as much as the interrupts take, never
+  * shorter.\n
+  * The elapsed time is summed up by @ref Advance "Advance", so the delay
+  * holds for its whole length in any context, even where the interrupts of
+  * the timestamp timer are held off.
+  */
+void HIERODULE_DELAY_us(uint32_t Microseconds)
+{
+    uint32_t Last = HIERODULE_TSTAMP_Get32();
+    uint32_t Span = ToCounts(Microseconds) + 1U;
+    uint32_t Elapsed = 0;
+
+    while(Elapsed < Span)
+    {
+        Elapsed += Advance(&Last);
+    }
+
+    Account(Elapsed);
+}
+
+/** @details The deadline is turned into a span from the first timestamp
+  * read, and the elapsed time is summed up by @ref Advance "Advance", same
+  * as @ref HIERODULE_DELAY_us "HIERODULE_DELAY_us", so the wait holds in
+  * any context. A deadline that has already passed reads the register just
+  * once.\n
+  * The time is checked before the register on each turn, so the register
+  * is always read once more after the deadline has passed. A wait preempted
+  * past its deadline won't time out on a register that's already set.
+  */
+uint8_t HIERODULE_DELAY_WaitUntil(volatile uint32_t *Register, uint32_t Mask,
+    uint32_t Value, HIERODULE_DELAY_Deadline Deadline)
+{
+    uint32_t Last = HIERODULE_TSTAMP_Get32();
+    int32_t Span = (int32_t)(Deadline - Last);
+    uint32_t Elapsed = 0;
+    uint8_t Expired;
+    uint8_t Matched;
+
+    do
+    {
+        Expired = ( (int32_t)Elapsed >= Span ) ? 1 : 0;
+        Matched = ( (READ_REG(*Register) & Mask) == Value ) ? 1 : 0;
+        Elapsed += Advance(&Last);
+    }
+    while( (0 == Matched) && (0 == Expired) );
+
+    Account(Elapsed);
+
+    return Matched;
+}
+
+/** @details Read with interrupts masked, so the two halves are consistent.
+  * Divide by @ref HIERODULE_TSTAMP_GetFrequency
+  * "HIERODULE_TSTAMP_GetFrequency" for seconds.
+  */
+uint64_t HIERODULE_DELAY_GetWaited(void)
+{
+    uint64_t Total;
+    uint32_t Mask = __get_PRIMASK();
+
+    __disable_irq();
+    Total = Waited;
+    __set_PRIMASK(Mask);
+
+    return Total;
+}
+
+/** @details @rv_obvious
+  */
+void HIERODULE_DELAY_ResetWaited(void)
+{
+    uint32_t Mask = __get_PRIMASK();
+
+    __disable_irq();
+    Waited = 0;
+    __set_PRIMASK(Mask);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
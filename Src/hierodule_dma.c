@@ -0,0 +1,214 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_dma.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the DMA module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_dma.h>
+
+/** @addtogroup Hierodule_Dma DMA Module
+  * @{
+  */
+
+/** @addtogroup DMA_Private Static
+  * @brief @rv_global_private_brief{are}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the routines that locate the registers of a DMA channel
+  * or stream.
+  * @{
+  */
+
+/** \cond */
+#ifdef __STM32F401xC_H /** \endcond */
+
+/** @brief Keeps the bit offsets of the flags of the streams within LISR and
+  * HISR, as well as LIFCR and HIFCR.\n
+  * @rv_def_req_device{__STM32F401xC_H}
+  */
+static const uint8_t StreamFlagOffset[4] = {0, 6, 16, 22};
+
+/** @brief Returns the pointer to a DMA stream.
+  * @param Link: Pointer to the DMA stream designation.
+  * @return Pointer to the stream registers.
+  * @details Streams are laid out 0x18 bytes apart, starting 0x10 bytes into
+  * the controller.\n
+  * @rv_def_req_device{__STM32F401xC_H}
+  */
+static inline DMA_Stream_TypeDef *GetStream(const HIERODULE_DMA_Link *Link)
+{
+    return (DMA_Stream_TypeDef*)((char*)Link->Controller + 0x10 +
+        (0x18 * (size_t)Link->Index));
+}
+
+/** \cond */
+#else /** \endcond */
+
+/** @brief Returns the pointer to a DMA channel.
+  * @param Link: Pointer to the DMA channel designation.
+  * @return Pointer to the channel registers.
+  * @details Channels are laid out 0x14 bytes apart, starting 0x08 bytes into
+  * the controller.\n
+  * @rv_def_req_device{__STM32F030x6_H or __STM32F103xB_H}
+  */
+static inline DMA_Channel_TypeDef *GetChannel(const HIERODULE_DMA_Link *Link)
+{
+    return (DMA_Channel_TypeDef*)((char*)Link->Controller + 0x08 +
+        (0x14 * (size_t)(Link->Index - 1)));
+}
+
+/** \cond */
+#endif /** \endcond */
+
+/**
+  * @}
+  */
+
+/** @addtogroup DMA_Public Global
+  * @{
+  */
+
+/** @details The channel is stopped and its flags are cleared first. It's
+  * then configured for a circular transfer, incrementing the memory address
+  * only, at high priority, with the half transfer, transfer complete and
+  * transfer error interrupts enabled, and started.\n
+  * The clock of the DMA controller and its NVIC line are left for the
+  * caller to enable, as well as the DMA request of the peripheral.
+  */
+void HIERODULE_DMA_StartCircular
+(
+    const HIERODULE_DMA_Link *Link,
+    HIERODULE_DMA_Direction Direction,
+    volatile uint32_t *Register,
+    void *Memory,
+    uint16_t Count,
+    uint8_t Size
+)
+{
+    uint32_t SizeCode = (uint32_t)Size >> 1;
+
+    HIERODULE_DMA_Stop(Link);
+    HIERODULE_DMA_FetchFlags(Link);
+
+    /** \cond */
+    #ifdef __STM32F401xC_H /** \endcond */
+        DMA_Stream_TypeDef *Stream = GetStream(Link);
+
+        WRITE_REG(Stream->PAR, (uint32_t)Register);
+        WRITE_REG(Stream->M0AR, (uint32_t)Memory);
+        WRITE_REG(Stream->NDTR, Count);
+        WRITE_REG(Stream->CR,
+            ((uint32_t)Link->Request << DMA_SxCR_CHSEL_Pos) |
+            DMA_SxCR_PL_1 |
+            (DMA_SxCR_MSIZE_0 * SizeCode) |
+            (DMA_SxCR_PSIZE_0 * SizeCode) |
+            DMA_SxCR_MINC | DMA_SxCR_CIRC |
+            ((Direction == HIERODULE_DMA_Direction_MEM_TO_PERIPH) ?
+                DMA_SxCR_DIR_0 : 0U) |
+            DMA_SxCR_TCIE | DMA_SxCR_HTIE | DMA_SxCR_TEIE);
+        SET_BIT(Stream->CR, DMA_SxCR_EN);
+    /** \cond */
+    #else /** \endcond */
+        DMA_Channel_TypeDef *Channel = GetChannel(Link);
+
+        WRITE_REG(Channel->CPAR, (uint32_t)Register);
+        WRITE_REG(Channel->CMAR, (uint32_t)Memory);
+        WRITE_REG(Channel->CNDTR, Count);
+        WRITE_REG(Channel->CCR,
+            DMA_CCR_PL_1 |
+            (DMA_CCR_MSIZE_0 * SizeCode) |
+            (DMA_CCR_PSIZE_0 * SizeCode) |
+            DMA_CCR_MINC | DMA_CCR_CIRC |
+            ((Direction == HIERODULE_DMA_Direction_MEM_TO_PERIPH) ?
+                DMA_CCR_DIR : 0U) |
+            DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE);
+        SET_BIT(Channel->CCR, DMA_CCR_EN);
+    /** \cond */
+    #endif /** \endcond */
+}
+
+/** @details On STM32F401xC, the enable bit of the stream is polled until
+  * it reads back as cleared, as the stream may finish an ongoing beat
+  * first.
+  */
+void HIERODULE_DMA_Stop(const HIERODULE_DMA_Link *Link)
+{
+    /** \cond */
+    #ifdef __STM32F401xC_H /** \endcond */
+        DMA_Stream_TypeDef *Stream = GetStream(Link);
+
+        CLEAR_BIT(Stream->CR, DMA_SxCR_EN);
+        while( READ_BIT(Stream->CR, DMA_SxCR_EN) != 0 );
+    /** \cond */
+    #else /** \endcond */
+        CLEAR_BIT(GetChannel(Link)->CCR, DMA_CCR_EN);
+    /** \cond */
+    #endif /** \endcond */
+}
+
+/** @details @rv_obvious
+  */
+uint32_t HIERODULE_DMA_GetRemaining(const HIERODULE_DMA_Link *Link)
+{
+    /** \cond */
+    #ifdef __STM32F401xC_H /** \endcond */
+        return READ_REG(GetStream(Link)->NDTR);
+    /** \cond */
+    #else /** \endcond */
+        return READ_REG(GetChannel(Link)->CNDTR);
+    /** \cond */
+    #endif /** \endcond */
+}
+
+/** @details Only the flags that are read as set are cleared, so none can be
+  * lost in between. Meant to be called from the IRQ handler of the channel.
+  */
+uint32_t HIERODULE_DMA_FetchFlags(const HIERODULE_DMA_Link *Link)
+{
+    uint32_t Raw;
+
+    /** \cond */
+    #ifdef __STM32F401xC_H /** \endcond */
+        uint32_t Offset = StreamFlagOffset[Link->Index & 3U];
+
+        if(Link->Index < 4)
+        {
+            Raw = READ_REG(Link->Controller->LISR) & (0x3DUL << Offset);
+            WRITE_REG(Link->Controller->LIFCR, Raw);
+        }
+        else
+        {
+            Raw = READ_REG(Link->Controller->HISR) & (0x3DUL << Offset);
+            WRITE_REG(Link->Controller->HIFCR, Raw);
+        }
+        Raw >>= Offset;
+
+        return ( ((Raw >> 4) & 1UL) * HIERODULE_DMA_FLAG_HT ) |
+            ( ((Raw >> 5) & 1UL) * HIERODULE_DMA_FLAG_TC ) |
+            ( ((Raw >> 3) & 1UL) * HIERODULE_DMA_FLAG_TE );
+    /** \cond */
+    #else /** \endcond */
+        uint32_t Offset = 4UL * (Link->Index - 1);
+
+        Raw = READ_REG(Link->Controller->ISR) & (0x0EUL << Offset);
+        WRITE_REG(Link->Controller->IFCR, Raw);
+        Raw >>= Offset;
+
+        return ( ((Raw >> 2) & 1UL) * HIERODULE_DMA_FLAG_HT ) |
+            ( ((Raw >> 1) & 1UL) * HIERODULE_DMA_FLAG_TC ) |
+            ( ((Raw >> 3) & 1UL) * HIERODULE_DMA_FLAG_TE );
+    /** \cond */
+    #endif /** \endcond */
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,223 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_enc.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the encoder module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_enc.h>
+
+/** @addtogroup Hierodule_Enc Encoder Module
+  * @{
+  */
+
+/** @addtogroup ENC_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the callback that samples the counter.
+  * @{
+  */
+
+/** \cond */
+#define COUNT_MASK  0xFFFFUL
+#define HALF_COUNT  0x8000UL
+/** \endcond */
+
+/** @brief Update and capture compare channel 3 callback of the encoder's
+  * timer.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Pointer to the encoder.
+  * @return None
+  * @details The counter is sampled and the signed 16 bit difference from
+  * the latest sample is added to the position, into the slot that's not the
+  * latest, which is then made the latest.\n
+  * The callback runs whenever the counter crosses either the wrap point or
+  * the middle of its range, so the counter never moves by more than half
+  * its range between two samples. Unlike deciding on each wrap by the
+  * direction, this doesn't lose track when a jittering encoder wraps back
+  * and forth before the flag is serviced.
+  */
+static void Resample(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    HIERODULE_ENC_Encoder *Encoder = (HIERODULE_ENC_Encoder*)Context;
+    uint32_t Next = Encoder->Sequence + 1;
+    const HIERODULE_ENC_Sample *Latest = &Encoder->Slot[Encoder->Sequence & 1];
+    HIERODULE_ENC_Sample *Slot = &Encoder->Slot[Next & 1];
+    uint16_t Count = (uint16_t)READ_REG(Timer->CNT);
+
+    (void)Flags;
+
+    Slot->Position = Latest->Position + (int16_t)(Count - Latest->Count);
+    Slot->Count = Count;
+    Encoder->Sequence = Next;
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup ENC_Public Global
+  * @{
+  */
+
+/** @details Channel 1 and 2 are mapped to their own inputs, non-inverted
+  * and unfiltered, and the slave mode controller is set to the encoder mode.
+  * ARR is set to 0xFFFF and channel 3 is set to compare at 0x8000, so that
+  * the counter is sampled via @ref HIERODULE_TIM_Assign_Callback_UPD
+  * "HIERODULE_TIM_Assign_Callback_UPD" and
+  * @ref HIERODULE_TIM_Assign_Callback_CC3 "HIERODULE_TIM_Assign_Callback_CC3"
+  * at both points.\n
+  * The counter and the NVIC lines of the timer are left for the caller to
+  * enable. If the timer has separate update and capture compare IRQs, give
+  * them the same priority.\n
+  * The velocity estimator is off until it's configured.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+void HIERODULE_ENC_Init
+(
+    HIERODULE_ENC_Encoder *Encoder,
+    TIM_TypeDef *Timer,
+    HIERODULE_ENC_Mode Mode
+)
+{
+    Encoder->Timer = Timer;
+    Encoder->Sequence = 0;
+    Encoder->Slot[0].Position = 0;
+    Encoder->Slot[0].Count = (uint16_t)READ_REG(Timer->CNT);
+    Encoder->Velocity = 0;
+    Encoder->SampleRate = 0;
+
+    MODIFY_REG(Timer->CCER, 0xFFUL, 0);
+    MODIFY_REG(Timer->CCMR1, 0xFFFFUL, TIM_CCMR1_CC1S_0 | TIM_CCMR1_CC2S_0);
+    MODIFY_REG(Timer->SMCR, TIM_SMCR_SMS, (uint32_t)Mode << TIM_SMCR_SMS_Pos);
+    MODIFY_REG(Timer->CCMR2, 0xFFUL, 0);
+    WRITE_REG(Timer->ARR, COUNT_MASK);
+    WRITE_REG(Timer->CCR3, HALF_COUNT);
+
+    HIERODULE_TIM_Assign_Callback_UPD(Timer, &Resample, Encoder);
+    HIERODULE_TIM_Assign_Callback_CC3(Timer, &Resample, Encoder);
+    HIERODULE_TIM_ClearFlag_UPD(Timer);
+    HIERODULE_TIM_ClearFlag_CC3(Timer);
+    HIERODULE_TIM_Enable_IT_UPD(Timer);
+    HIERODULE_TIM_Enable_IT_CC3(Timer);
+}
+
+/** @details The latest sample and the counter are read without masking
+  * interrupts, safe to call from any context. The read is retried if a new
+  * sample is taken in between.
+  */
+int64_t HIERODULE_ENC_GetPosition(HIERODULE_ENC_Encoder *Encoder)
+{
+    HIERODULE_ENC_Sample Sample;
+    uint32_t Sequence;
+    uint16_t Count;
+
+    do
+    {
+        Sequence = Encoder->Sequence;
+        Sample = Encoder->Slot[Sequence & 1];
+        Count = (uint16_t)READ_REG(Encoder->Timer->CNT);
+    }
+    while(Sequence != Encoder->Sequence);
+
+    return Sample.Position + (int16_t)(Count - Sample.Count);
+}
+
+/** @details Same as @ref HIERODULE_ENC_GetPosition
+  * "HIERODULE_ENC_GetPosition", truncated. Differences of these are still
+  * correct across the wrap, and cheaper to work with.
+  */
+int32_t HIERODULE_ENC_GetPosition32(HIERODULE_ENC_Encoder *Encoder)
+{
+    return (int32_t)HIERODULE_ENC_GetPosition(Encoder);
+}
+
+/** @details The current window is restarted from the current position.
+  */
+void HIERODULE_ENC_ConfigVelocity
+(
+    HIERODULE_ENC_Encoder *Encoder,
+    uint32_t SampleRate_Hz,
+    uint32_t MinCounts,
+    uint32_t MaxWindow
+)
+{
+    Encoder->MinCounts = (MinCounts > 0) ? MinCounts : 1;
+    Encoder->MaxWindow = (MaxWindow > 0) ? MaxWindow : 1;
+    Encoder->WindowStart = HIERODULE_ENC_GetPosition32(Encoder);
+    Encoder->Elapsed = 0;
+    Encoder->Velocity = 0;
+    Encoder->SampleRate = SampleRate_Hz;
+}
+
+/** @details Meant to be called at the configured sample rate, e.g. from a
+  * timer's update ISR. Integer arithmetic only, one division per call.\n
+  * A window is kept open until it has seen at least the minimum counts, then
+  * the velocity is the counts in the window over its duration. At high
+  * speed, that's every sample, counting edges per sample. At low speed, the
+  * window stretches until the next edge, which is in effect timing the edge
+  * period, to the resolution of a sample.\n
+  * While a window is open, the velocity is clamped to the highest one that
+  * wouldn't have closed it yet, so it falls off with the time since the last
+  * edge when the encoder slows down. A window that reaches the maximum
+  * length is closed with whatever counts it has, zero for a standstill.\n
+  * The counts in a window multiplied by the sample rate should fit in 31
+  * bits.
+  */
+void HIERODULE_ENC_UpdateVelocity(HIERODULE_ENC_Encoder *Encoder)
+{
+    int32_t Counts;
+    uint32_t Magnitude;
+    int32_t Bound;
+
+    if(Encoder->SampleRate == 0)
+    {
+        return;
+    }
+
+    Counts = HIERODULE_ENC_GetPosition32(Encoder) - Encoder->WindowStart;
+    Magnitude = (Counts < 0) ? (uint32_t)(-Counts) : (uint32_t)Counts;
+    Encoder->Elapsed++;
+
+    if( (Magnitude >= Encoder->MinCounts) ||
+        (Encoder->Elapsed >= Encoder->MaxWindow) )
+    {
+        Encoder->Velocity = (Counts * (int32_t)Encoder->SampleRate) /
+            (int32_t)Encoder->Elapsed;
+        Encoder->WindowStart += Counts;
+        Encoder->Elapsed = 0;
+        return;
+    }
+
+    Bound = (int32_t)( (Encoder->MinCounts * Encoder->SampleRate) /
+        Encoder->Elapsed );
+    if(Encoder->Velocity > Bound)
+    {
+        Encoder->Velocity = Bound;
+    }
+    else if(Encoder->Velocity < -Bound)
+    {
+        Encoder->Velocity = -Bound;
+    }
+}
+
+/** @details @rv_obvious
+  */
+int32_t HIERODULE_ENC_GetVelocity(HIERODULE_ENC_Encoder *Encoder)
+{
+    return Encoder->Velocity;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
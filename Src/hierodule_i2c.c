@@ -50,14 +50,27 @@ static HIERODULE_I2C_Wrapper *I2C3_Wrapper;
   * @param NumberOfPeriods Number of I2C clock periods.
   * @return None
   * @details The period length is calculated beforehand with a @ref
-  * HIERODULE_I2C_InitWrapper "HIERODULE_I2C_InitWrapper" call.
+  * HIERODULE_I2C_InitWrapper "HIERODULE_I2C_InitWrapper" call, in core
+  * clocks. Either spun off with NOPs, or converted to microseconds and
+  * waited out on the timestamps, as set by @ref HIERODULE_I2C_TIMED_IDLE
+  * "HIERODULE_I2C_TIMED_IDLE".
   */
 void Idle(HIERODULE_I2C_Wrapper *Wrapper, uint32_t NumberOfPeriods)
 {
+    /** \cond */
+    #if HIERODULE_I2C_TIMED_IDLE /** \endcond */
+    uint64_t Clocks = (uint64_t)Wrapper->I2C_Period_Length * NumberOfPeriods;
+
+    HIERODULE_DELAY_us( (uint32_t)
+        ((Clocks * 1000000U + SystemCoreClock - 1) / SystemCoreClock) );
+    /** \cond */
+    #else /** \endcond */
     for(uint32_t i = 0 ; i < Wrapper->I2C_Period_Length*NumberOfPeriods ; i++)
     {
         __NOP();
     }
+    /** \cond */
+    #endif /** \endcond */
 }
 
 /** @brief Enables clock stretching for the I2C peripheral of a wrapper.
@@ -0,0 +1,595 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_icap.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the input capture module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_icap.h>
+
+/** @addtogroup Hierodule_Icap Input Capture Module
+  * @{
+  */
+
+/** @addtogroup ICAP_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the callbacks and the routines that are used to
+  * implement those.
+  * @{
+  */
+
+/** \cond */
+#define CCMR_FIELD  0xFFUL
+#define CCER_FIELD  0x0FUL
+/** \endcond */
+
+/** @brief Returns the pointer to the capture mode register of a channel.
+  * @rv_param_timer
+  * @param Index: Channel number minus one.
+  * @return Pointer to CCMR1 or CCMR2.
+  * @details @rv_obvious
+  */
+static inline volatile uint32_t *ModeRegister(TIM_TypeDef *Timer,
+    uint32_t Index)
+{
+    return (Index < 2) ? &Timer->CCMR1 : &Timer->CCMR2;
+}
+
+/** @brief Configures a channel for input capture on its own input.
+  * @rv_param_timer
+  * @param Index: Channel number minus one.
+  * @param Polarity: CCxP and CCxNP bits of channel 1, for the edges to
+  * capture.
+  * @return None
+  * @details The channel is disabled while it's reconfigured, with no filter
+  * and no prescaler, then enabled again.
+  */
+static void ConfigureCapture(TIM_TypeDef *Timer, uint32_t Index,
+    uint32_t Polarity)
+{
+    CLEAR_BIT(Timer->CCER, TIM_CCER_CC1E << (Index << 2));
+    MODIFY_REG(*ModeRegister(Timer, Index), CCMR_FIELD << ((Index & 1) << 3),
+        TIM_CCMR1_CC1S_0 << ((Index & 1) << 3));
+    MODIFY_REG(Timer->CCER, CCER_FIELD << (Index << 2),
+        (TIM_CCER_CC1E | Polarity) << (Index << 2));
+}
+
+/** @brief Extends a capture to the timeline of the engine.
+  * @param Engine: Pointer to the engine.
+  * @param Capture: Captured counter value.
+  * @return Counts elapsed since initialization at the capture.
+  * @details The current time is read first, as the overflow count, whether
+  * an overflow is pending and the counter. The pending flag is read on both
+  * sides of the counter, so an overflow in between is caught along with the
+  * counter value after it. The whole read is retried if the update callback
+  * runs in between.\n
+  * The capture is then placed behind the current time, by the counts
+  * between the two within a counter period. So it doesn't matter whether
+  * the overflow around it has been counted yet, as long as the capture is
+  * serviced within a period.
+  */
+static uint64_t Extend(HIERODULE_ICAP_Engine *Engine, uint32_t Capture)
+{
+    TIM_TypeDef *Timer = Engine->Timer;
+    uint64_t Span = (uint64_t)READ_REG(Timer->ARR) + 1;
+    uint32_t Overflows;
+    uint32_t Pending;
+    uint32_t Count;
+    uint64_t Behind;
+
+    do
+    {
+        Overflows = Engine->Overflows;
+        Pending = READ_BIT(Timer->SR, TIM_SR_UIF);
+        Count = READ_REG(Timer->CNT);
+        if( (Pending == 0) && (READ_BIT(Timer->SR, TIM_SR_UIF) != 0) )
+        {
+            Pending = 1;
+            Count = READ_REG(Timer->CNT);
+        }
+    }
+    while(Overflows != Engine->Overflows);
+
+    Behind = (Count >= Capture) ?
+        (uint64_t)(Count - Capture) : ((uint64_t)Count + Span - Capture);
+
+    return ( ((uint64_t)Overflows + (Pending != 0)) * Span ) + Count - Behind;
+}
+
+/** @brief Stores a measurement in the slot that's not the latest, then
+  * makes it the latest.
+  * @param State: Pointer to the channel state.
+  * @param Period: Period in counts.
+  * @param Width: Pulse width in counts.
+  * @return None
+  * @details A reader that preempts this keeps reading the latest slot,
+  * which is left alone.
+  */
+static void Publish(HIERODULE_ICAP_Channel *State, uint32_t Period,
+    uint32_t Width)
+{
+    uint32_t Next = State->Sequence + 1;
+    HIERODULE_ICAP_Result *Slot = &State->Slot[Next & 1];
+
+    State->Count++;
+    Slot->Period = Period;
+    Slot->Width = Width;
+    Slot->Count = State->Count;
+    State->Sequence = Next;
+}
+
+/** @brief Advances the filled half count of a stream by one.
+  * @param Stream: Pointer to the stream.
+  * @param Halves: Filled half count to advance.
+  * @return The next count, wrapped to 0 at the range.
+  * @details The range spans an even number of halves, so the parity of the
+  * count still tells which half the DMA is in after it wraps.
+  */
+static uint32_t NextHalf(HIERODULE_ICAP_Stream *Stream, uint32_t Halves)
+{
+    Halves++;
+    if( (Halves * (Stream->Size >> 1)) == Stream->Range )
+    {
+        Halves = 0;
+    }
+    return Halves;
+}
+
+/** @brief Returns the number of captures written by the DMA since a stream
+  * is started, modulo the range of the stream.
+  * @param Stream: Pointer to the stream.
+  * @return Number of captures written.
+  * @details The DMA position within the buffer is matched against the
+  * parity of the filled half count. A mismatch means the interrupt of the
+  * half just filled is pending, so it's counted in. Holds as long as the
+  * DMA interrupts are serviced before another half is filled.\n
+  * The range being a multiple of the buffer size, the count modulo the
+  * size is the DMA position, across the wrap as well.
+  */
+static uint32_t Produced(HIERODULE_ICAP_Stream *Stream)
+{
+    uint32_t Half = Stream->Size >> 1;
+    uint32_t Halves;
+    uint32_t Position;
+
+    do
+    {
+        Halves = Stream->Halves;
+        Position = Stream->Size - HIERODULE_DMA_GetRemaining(&Stream->Link);
+    }
+    while(Halves != Stream->Halves);
+
+    if( (Halves & 1U) != (Position >= Half) )
+    {
+        Halves = NextHalf(Stream, Halves);
+    }
+
+    return (Halves * Half) +
+        ((Position >= Half) ? (Position - Half) : Position);
+}
+
+/** @brief Update callback of the engine's timer.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Pointer to the engine.
+  * @return None
+  * @details @rv_obvious
+  */
+static void OverflowTick(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    HIERODULE_ICAP_Engine *Engine = (HIERODULE_ICAP_Engine*)Context;
+
+    (void)Timer;
+    (void)Flags;
+
+    Engine->Overflows = Engine->Overflows + 1;
+}
+
+/** @brief Capture compare callback of the engine's timer.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Pointer to the engine.
+  * @return None
+  * @details The channel is told by the flag. In pulse mode, the polarity is
+  * switched after each capture, and a pulse width is taken on falling
+  * edges.
+  */
+static void CaptureTick(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    HIERODULE_ICAP_Engine *Engine = (HIERODULE_ICAP_Engine*)Context;
+    uint32_t Index = (uint32_t)__builtin_ctz(Flags) - 1;
+    HIERODULE_ICAP_Channel *State = &Engine->Channel[Index];
+    const HIERODULE_ICAP_Result *Latest = &State->Slot[State->Sequence & 1];
+    uint64_t Stamp = Extend(Engine, READ_REG(*(&Timer->CCR1 + Index)));
+
+    if(State->Falling)
+    {
+        CLEAR_BIT(Timer->CCER, TIM_CCER_CC1P << (Index << 2));
+        State->Falling = 0;
+        Publish(State, Latest->Period, (uint32_t)(Stamp - State->LastRise));
+        return;
+    }
+
+    if(State->Mode == HIERODULE_ICAP_Mode_PULSE)
+    {
+        SET_BIT(Timer->CCER, TIM_CCER_CC1P << (Index << 2));
+        State->Falling = 1;
+    }
+    if(State->Primed)
+    {
+        Publish(State, (uint32_t)(Stamp - State->LastRise), Latest->Width);
+    }
+    State->LastRise = Stamp;
+    State->Primed = 1;
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup ICAP_Public Global
+  * @{
+  */
+
+/** @details Overflows are counted on the update interrupt, via
+  * @ref HIERODULE_TIM_Assign_Callback_UPD "HIERODULE_TIM_Assign_Callback_UPD".
+  * URS is set, so that only counter overflows raise the update flag.\n
+  * The counter and the NVIC lines of the timer are left for the caller to
+  * enable. If the timer has separate update and capture compare IRQs, give
+  * them the same priority.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+void HIERODULE_ICAP_Init(HIERODULE_ICAP_Engine *Engine, TIM_TypeDef *Timer)
+{
+    uint32_t Index;
+
+    Engine->Timer = Timer;
+    Engine->Overflows = 0;
+    for(Index = 0 ; Index < 4 ; Index++)
+    {
+        Engine->Channel[Index].Sequence = 0;
+        Engine->Channel[Index].Slot[0].Count = 0;
+        Engine->Channel[Index].Count = 0;
+        Engine->Channel[Index].Primed = 0;
+    }
+
+    SET_BIT(Timer->CR1, TIM_CR1_URS);
+    HIERODULE_TIM_Assign_Callback_UPD(Timer, &OverflowTick, Engine);
+    HIERODULE_TIM_ClearFlag_UPD(Timer);
+    HIERODULE_TIM_Enable_IT_UPD(Timer);
+}
+
+/** @details The channel is mapped to its own input, with no filter and no
+  * prescaler, to capture rising edges. Its capture compare callback is
+  * assigned and its interrupt enabled via @ref HIERODULE_TIM_Enable_IT_CC1
+  * "HIERODULE_TIM_Enable_IT_CC1" to CC4. The first rising edge only primes
+  * the channel.\n
+  * In pulse mode, the pulse should last longer than the interrupt latency,
+  * or an edge is missed while the polarity is being switched. Use
+  * @ref HIERODULE_ICAP_StartPwmInput "HIERODULE_ICAP_StartPwmInput" for
+  * short pulses instead.
+  */
+void HIERODULE_ICAP_StartChannel
+(
+    HIERODULE_ICAP_Engine *Engine,
+    uint8_t Channel,
+    HIERODULE_ICAP_Mode Mode
+)
+{
+    TIM_TypeDef *Timer = Engine->Timer;
+    HIERODULE_ICAP_Channel *State;
+    uint32_t Index;
+
+    if( (Channel < 1) || (Channel > 4) )
+    {
+        return;
+    }
+    Index = Channel - 1;
+    State = &Engine->Channel[Index];
+
+    ConfigureCapture(Timer, Index, 0);
+
+    State->Mode = Mode;
+    State->Falling = 0;
+    State->Primed = 0;
+
+    WRITE_REG(Timer->SR, ~(TIM_SR_CC1IF << Index));
+    switch(Channel)
+    {
+        case 1:
+            HIERODULE_TIM_Assign_Callback_CC1(Timer, &CaptureTick, Engine);
+            HIERODULE_TIM_Enable_IT_CC1(Timer);
+            break;
+        case 2:
+            HIERODULE_TIM_Assign_Callback_CC2(Timer, &CaptureTick, Engine);
+            HIERODULE_TIM_Enable_IT_CC2(Timer);
+            break;
+        case 3:
+            HIERODULE_TIM_Assign_Callback_CC3(Timer, &CaptureTick, Engine);
+            HIERODULE_TIM_Enable_IT_CC3(Timer);
+            break;
+        default:
+            HIERODULE_TIM_Assign_Callback_CC4(Timer, &CaptureTick, Engine);
+            HIERODULE_TIM_Enable_IT_CC4(Timer);
+            break;
+    }
+}
+
+/** @details The interrupt and the capture of the channel are disabled. The
+  * latest measurement is kept.
+  */
+void HIERODULE_ICAP_StopChannel(HIERODULE_ICAP_Engine *Engine,
+    uint8_t Channel)
+{
+    if( (Channel < 1) || (Channel > 4) )
+    {
+        return;
+    }
+    CLEAR_BIT(Engine->Timer->DIER, TIM_DIER_CC1IE << (Channel - 1));
+    CLEAR_BIT(Engine->Timer->CCER, TIM_CCER_CC1E << ((Channel - 1) << 2));
+}
+
+/** @details The latest slot is copied without masking interrupts, safe to
+  * call from any context. The copy is retried if a measurement is published
+  * in between.
+  */
+uint32_t HIERODULE_ICAP_Read
+(
+    HIERODULE_ICAP_Engine *Engine,
+    uint8_t Channel,
+    HIERODULE_ICAP_Result *Result
+)
+{
+    HIERODULE_ICAP_Channel *State;
+    uint32_t Sequence;
+
+    if( (Channel < 1) || (Channel > 4) )
+    {
+        return 0;
+    }
+    State = &Engine->Channel[Channel - 1];
+
+    do
+    {
+        Sequence = State->Sequence;
+        *Result = State->Slot[Sequence & 1];
+    }
+    while(Sequence != State->Sequence);
+
+    return Result->Count;
+}
+
+/** @details The counting frequency of the timer, its kernel clock divided
+  * by its prescaler, is divided by the latest period. The division is left
+  * to the reader, not to the capture callback.
+  */
+uint64_t HIERODULE_ICAP_GetFrequency_mHz(HIERODULE_ICAP_Engine *Engine,
+    uint8_t Channel)
+{
+    HIERODULE_ICAP_Result Result;
+
+    if( (HIERODULE_ICAP_Read(Engine, Channel, &Result) == 0) ||
+        (Result.Period == 0) )
+    {
+        return 0;
+    }
+
+    return ( (uint64_t)HIERODULE_TIM_GetKernelClock(Engine->Timer) * 1000U /
+        (READ_REG(Engine->Timer->PSC) + 1) ) / Result.Period;
+}
+
+/** @details The buffer is filled and consumed half by half, so the size
+  * should be even and above 0. The stream is left unusable, with a size of
+  * 0, otherwise; starting it does nothing and peeking returns 0.
+  */
+void HIERODULE_ICAP_InitStream
+(
+    HIERODULE_ICAP_Stream *Stream,
+    TIM_TypeDef *Timer,
+    uint8_t Channel,
+    HIERODULE_ICAP_Edge Edge,
+    const HIERODULE_DMA_Link *Link,
+    uint16_t *Buffer,
+    uint16_t Size,
+    HIERODULE_ICAP_StreamCallback Notify,
+    void *Context
+)
+{
+    Stream->Timer = Timer;
+    Stream->Channel = Channel;
+    Stream->Edge = Edge;
+    Stream->Link = *Link;
+    Stream->Buffer = Buffer;
+    Stream->Size = 0;
+    Stream->Range = 0;
+    Stream->Notify = Notify;
+    Stream->Context = Context;
+    Stream->Halves = 0;
+    Stream->Consumed = 0;
+    Stream->Overruns = 0;
+
+    if( (Size == 0) || (Size & 1) )
+    {
+        return;
+    }
+
+    Stream->Size = Size;
+    Stream->Range = (0x80000000UL / Size) * Size;
+}
+
+/** @details The channel is configured for input capture on the selected
+  * edges, and the DMA channel is started in circular mode from its CCR to
+  * the buffer. The capture DMA request of the channel is enabled last. No
+  * capture compare interrupts are involved, the DMA transfer clears the
+  * capture flags.\n
+  * The clock of the DMA controller and its NVIC line, as well as the
+  * counter, are left for the caller to enable.
+  */
+void HIERODULE_ICAP_StartStream(HIERODULE_ICAP_Stream *Stream)
+{
+    TIM_TypeDef *Timer = Stream->Timer;
+    uint32_t Index = Stream->Channel - 1;
+    uint32_t Polarity = 0;
+
+    if( (Stream->Channel < 1) || (Stream->Channel > 4) ||
+        (Stream->Size == 0) )
+    {
+        return;
+    }
+
+    if(Stream->Edge == HIERODULE_ICAP_Edge_FALLING)
+    {
+        Polarity = TIM_CCER_CC1P;
+    }
+    else if(Stream->Edge == HIERODULE_ICAP_Edge_BOTH)
+    {
+        Polarity = TIM_CCER_CC1P | TIM_CCER_CC1NP;
+    }
+
+    Stream->Halves = 0;
+    Stream->Consumed = 0;
+    ConfigureCapture(Timer, Index, Polarity);
+    HIERODULE_DMA_StartCircular(&Stream->Link,
+        HIERODULE_DMA_Direction_PERIPH_TO_MEM, &Timer->CCR1 + Index,
+        Stream->Buffer, (uint16_t)Stream->Size, 2);
+    SET_BIT(Timer->DIER, TIM_DIER_CC1DE << Index);
+}
+
+/** @details The capture DMA request is disabled before the DMA channel is
+  * stopped. Captures not yet consumed are kept in the buffer, but the next
+  * start discards them.
+  */
+void HIERODULE_ICAP_StopStream(HIERODULE_ICAP_Stream *Stream)
+{
+    CLEAR_BIT(Stream->Timer->DIER, TIM_DIER_CC1DE << (Stream->Channel - 1));
+    HIERODULE_DMA_Stop(&Stream->Link);
+}
+
+/** @details Meant to be called from the IRQ handler of the DMA channel.
+  * Each half transfer and transfer complete flag counts a filled half, and
+  * the notification callback is performed if either is set. The stream is
+  * stopped on a transfer error.
+  */
+void HIERODULE_ICAP_ServiceStream(HIERODULE_ICAP_Stream *Stream)
+{
+    uint32_t Flags = HIERODULE_DMA_FetchFlags(&Stream->Link);
+
+    if(Flags & HIERODULE_DMA_FLAG_TE)
+    {
+        HIERODULE_ICAP_StopStream(Stream);
+        return;
+    }
+    if(Flags & HIERODULE_DMA_FLAG_HT)
+    {
+        Stream->Halves = NextHalf(Stream, Stream->Halves);
+    }
+    if(Flags & HIERODULE_DMA_FLAG_TC)
+    {
+        Stream->Halves = NextHalf(Stream, Stream->Halves);
+    }
+    if( (Stream->Notify != NULL) &&
+        (Flags & (HIERODULE_DMA_FLAG_HT | HIERODULE_DMA_FLAG_TC)) )
+    {
+        Stream->Notify(Stream, Stream->Context);
+    }
+}
+
+/** @details The span points into the buffer itself, nothing is copied. It
+  * ends either where the DMA is writing, or at the end of the buffer, in
+  * which case the rest follows from the start of the buffer on the next
+  * call.\n
+  * If the DMA has lapped the reader, the overrun is counted and the reader
+  * skips ahead to the latest half buffer.\n
+  * Positions are kept modulo the range of the stream, a multiple of the
+  * buffer size, so the span stays in step with the DMA across the wrap of
+  * the counts.\n
+  * Meant to be called from a single context, the same as
+  * @ref HIERODULE_ICAP_Consume "HIERODULE_ICAP_Consume".
+  */
+uint32_t HIERODULE_ICAP_Peek(HIERODULE_ICAP_Stream *Stream,
+    const uint16_t **Span)
+{
+    uint32_t Written;
+    uint32_t Unread;
+    uint32_t Tail;
+
+    *Span = Stream->Buffer;
+    if(Stream->Size == 0)
+    {
+        return 0;
+    }
+
+    Written = Produced(Stream);
+    Unread = Written - Stream->Consumed;
+    if(Written < Stream->Consumed)
+    {
+        Unread += Stream->Range;
+    }
+
+    if(Unread > Stream->Size)
+    {
+        Stream->Overruns++;
+        Unread = Stream->Size >> 1;
+        Stream->Consumed = (Written >= Unread) ?
+            (Written - Unread) : (Written + Stream->Range - Unread);
+    }
+
+    Tail = Stream->Consumed % Stream->Size;
+    *Span = Stream->Buffer + Tail;
+
+    return (Unread < (Stream->Size - Tail)) ? Unread : (Stream->Size - Tail);
+}
+
+/** @details @rv_obvious
+  */
+void HIERODULE_ICAP_Consume(HIERODULE_ICAP_Stream *Stream, uint32_t Count)
+{
+    Stream->Consumed += Count;
+    if(Stream->Consumed >= Stream->Range)
+    {
+        Stream->Consumed -= Stream->Range;
+    }
+}
+
+/** @details Both channel 1 and 2 are mapped to the input of channel 1,
+  * capturing rising and falling edges respectively. The slave mode
+  * controller resets the counter on each rising edge, so CCR1 holds the
+  * period and CCR2 the pulse width, without any interrupts.\n
+  * Needs a timer with a slave mode controller. The period shouldn't exceed
+  * ARR.
+  */
+void HIERODULE_ICAP_StartPwmInput(TIM_TypeDef *Timer)
+{
+    CLEAR_BIT(Timer->CCER, TIM_CCER_CC1E | TIM_CCER_CC2E);
+    MODIFY_REG(Timer->CCMR1, CCMR_FIELD | (CCMR_FIELD << 8),
+        TIM_CCMR1_CC1S_0 | TIM_CCMR1_CC2S_1);
+    MODIFY_REG(Timer->SMCR, TIM_SMCR_TS | TIM_SMCR_SMS,
+        TIM_SMCR_TS_2 | TIM_SMCR_TS_0 | TIM_SMCR_SMS_2);
+    MODIFY_REG(Timer->CCER, CCER_FIELD | (CCER_FIELD << 4),
+        TIM_CCER_CC1E | TIM_CCER_CC2E | TIM_CCER_CC2P);
+}
+
+/** @details The captures aren't counted without interrupts, so the count
+  * only tells whether a period has been captured.
+  */
+void HIERODULE_ICAP_ReadPwmInput(TIM_TypeDef *Timer,
+    HIERODULE_ICAP_Result *Result)
+{
+    Result->Period = READ_REG(Timer->CCR1);
+    Result->Width = READ_REG(Timer->CCR2);
+    Result->Count = (Result->Period != 0) ? 1 : 0;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
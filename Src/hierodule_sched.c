@@ -0,0 +1,377 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_sched.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the event scheduler module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_sched.h>
+#include <hierodule_critical.h>
+
+/** @addtogroup Hierodule_Sched Event Scheduler Module
+  * @{
+  */
+
+/** @addtogroup SCHED_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the heap operations and the compare callback that are
+  * used to implement those.
+  * @{
+  */
+
+/** \cond */
+#define COUNT_MASK  0xFFFFUL
+#define MAX_ARM     (COUNT_MASK >> 1)
+#define NOT_QUEUED  0
+/** \endcond */
+
+/** @brief Checks whether an event is due before another.
+  * @param A: Pointer to the first event.
+  * @param B: Pointer to the second event.
+  * @return 1 if A is due first, 0 otherwise.
+  * @details Events with the same deadline are ordered by their post order,
+  * compared modulo 2^32.
+  */
+static inline uint32_t Precedes
+(
+    const HIERODULE_SCHED_Event *A,
+    const HIERODULE_SCHED_Event *B
+)
+{
+    if(A->Deadline != B->Deadline)
+    {
+        return (A->Deadline < B->Deadline);
+    }
+    return ( (int32_t)(A->Sequence - B->Sequence) < 0 );
+}
+
+/** @brief Moves an event up the heap until its parent precedes it.
+  * @param Lane: Pointer to the lane.
+  * @param Index: Position of the event in the heap.
+  * @return None
+  * @details @rv_obvious
+  */
+static void SiftUp(HIERODULE_SCHED_Lane *Lane, uint32_t Index)
+{
+    HIERODULE_SCHED_Event *Event = Lane->Heap[Index];
+    uint32_t Parent;
+
+    while(Index > 0)
+    {
+        Parent = (Index - 1) >> 1;
+        if( !Precedes(Event, Lane->Heap[Parent]) )
+        {
+            break;
+        }
+        Lane->Heap[Index] = Lane->Heap[Parent];
+        Lane->Heap[Index]->Index = Index + 1;
+        Index = Parent;
+    }
+    Lane->Heap[Index] = Event;
+    Event->Index = Index + 1;
+}
+
+/** @brief Moves an event down the heap until it precedes its children.
+  * @param Lane: Pointer to the lane.
+  * @param Index: Position of the event in the heap.
+  * @return None
+  * @details @rv_obvious
+  */
+static void SiftDown(HIERODULE_SCHED_Lane *Lane, uint32_t Index)
+{
+    HIERODULE_SCHED_Event *Event = Lane->Heap[Index];
+    uint32_t Child;
+
+    while( (Child = (Index << 1) + 1) < Lane->Count )
+    {
+        if( ((Child + 1) < Lane->Count) &&
+            Precedes(Lane->Heap[Child + 1], Lane->Heap[Child]) )
+        {
+            Child++;
+        }
+        if( !Precedes(Lane->Heap[Child], Event) )
+        {
+            break;
+        }
+        Lane->Heap[Index] = Lane->Heap[Child];
+        Lane->Heap[Index]->Index = Index + 1;
+        Index = Child;
+    }
+    Lane->Heap[Index] = Event;
+    Event->Index = Index + 1;
+}
+
+/** @brief Removes an event from the heap.
+  * @param Lane: Pointer to the lane.
+  * @param Index: Position of the event in the heap.
+  * @return None
+  * @details The last event takes its place, and is sifted whichever way it
+  * needs to go.
+  */
+static void Remove(HIERODULE_SCHED_Lane *Lane, uint32_t Index)
+{
+    HIERODULE_SCHED_Event *Last;
+
+    Lane->Heap[Index]->Index = NOT_QUEUED;
+    Lane->Count--;
+    if(Index == Lane->Count)
+    {
+        return;
+    }
+
+    Last = Lane->Heap[Lane->Count];
+    Lane->Heap[Index] = Last;
+    if( (Index > 0) && Precedes(Last, Lane->Heap[(Index - 1) >> 1]) )
+    {
+        SiftUp(Lane, Index);
+    }
+    else
+    {
+        SiftDown(Lane, Index);
+    }
+}
+
+/** @brief Programs the compare register of a lane for its earliest event.
+  * @param Lane: Pointer to the lane.
+  * @param Now: Current timestamp.
+  * @return None
+  * @details The compare is never programmed further than half the counter
+  * range ahead, deadlines beyond that take intermediate wake ups. If the
+  * target is passed by the time the register is written, the compare event
+  * is generated by software, so a deadline is never missed by a whole
+  * counter period.\n
+  * The interrupt of the channel is disabled while the lane is empty.
+  */
+static void Arm(HIERODULE_SCHED_Lane *Lane, uint64_t Now)
+{
+    uint32_t Bit = 1UL << Lane->Channel;
+    uint64_t Target;
+
+    if(Lane->Count == 0)
+    {
+        CLEAR_BIT(Lane->Timer->DIER, Bit);
+        return;
+    }
+
+    Target = Lane->Heap[0]->Deadline;
+    if( (Target > Now) && ((Target - Now) > MAX_ARM) )
+    {
+        Target = Now + MAX_ARM;
+    }
+
+    WRITE_REG(*Lane->Compare, (uint32_t)Target & COUNT_MASK);
+    SET_BIT(Lane->Timer->DIER, Bit);
+
+    if(HIERODULE_TSTAMP_Get() >= Target)
+    {
+        WRITE_REG(Lane->Timer->EGR, Bit);
+    }
+}
+
+/** @brief Capture compare callback of a lane.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Pointer to the lane.
+  * @return None
+  * @details Every event that's due is popped and performed, outside the
+  * critical section, so callbacks are free to post or cancel events. The
+  * compare is then programmed for the next one.
+  */
+static void LaneTick(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    HIERODULE_SCHED_Lane *Lane = (HIERODULE_SCHED_Lane*)Context;
+    HIERODULE_SCHED_Event *Event;
+    uint32_t Primask;
+    uint64_t Now;
+
+    (void)Timer;
+    (void)Flags;
+
+    while(1)
+    {
+        Primask = HIERODULE_CRITICAL_Enter();
+        Now = HIERODULE_TSTAMP_Get();
+        if( (Lane->Count == 0) || (Lane->Heap[0]->Deadline > Now) )
+        {
+            break;
+        }
+        Event = Lane->Heap[0];
+        Remove(Lane, 0);
+        HIERODULE_CRITICAL_Exit(Primask);
+
+        Event->Callback(Event, Event->Context);
+    }
+    Arm(Lane, Now);
+    HIERODULE_CRITICAL_Exit(Primask);
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup SCHED_Public Global
+  * @{
+  */
+
+/** @details The lane's callback is assigned to the capture compare interrupt
+  * of the channel, with the lane as the context pointer, and the pending flag
+  * is cleared. The interrupt is enabled only while the lane has events
+  * queued.\n
+  * The timer should be the one the timestamp module runs on, and the channel
+  * should be other than @ref HIERODULE_TSTAMP_CHANNEL
+  * "HIERODULE_TSTAMP_CHANNEL", in frozen output compare mode. The lane is
+  * left unusable, with a capacity of 0, otherwise.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+void HIERODULE_SCHED_InitLane
+(
+    HIERODULE_SCHED_Lane *Lane,
+    TIM_TypeDef *Timer,
+    uint8_t Channel,
+    HIERODULE_SCHED_Event **Heap,
+    uint32_t Capacity
+)
+{
+    Lane->Timer = Timer;
+    Lane->Heap = Heap;
+    Lane->Capacity = 0;
+    Lane->Count = 0;
+    Lane->Sequence = 0;
+    Lane->Late = 0;
+    Lane->Channel = Channel;
+
+    if( (Channel < 1) || (Channel > 4) ||
+        (Channel == HIERODULE_TSTAMP_CHANNEL) )
+    {
+        return;
+    }
+
+    Lane->Compare = &Timer->CCR1 + (Channel - 1);
+    CLEAR_BIT(Timer->DIER, 1UL << Channel);
+    WRITE_REG(Timer->SR, ~(1UL << Channel));
+
+    switch(Channel)
+    {
+        case 1:
+            HIERODULE_TIM_Assign_Callback_CC1(Timer, &LaneTick, Lane);
+            break;
+        case 2:
+            HIERODULE_TIM_Assign_Callback_CC2(Timer, &LaneTick, Lane);
+            break;
+        case 3:
+            HIERODULE_TIM_Assign_Callback_CC3(Timer, &LaneTick, Lane);
+            break;
+        default:
+            HIERODULE_TIM_Assign_Callback_CC4(Timer, &LaneTick, Lane);
+            break;
+    }
+
+    Lane->Capacity = Capacity;
+}
+
+/** @details Posting takes O(log n) with interrupts masked. An event that's
+  * already queued is taken out first, so an event can be posted again to
+  * move its deadline. An event should only be queued on one lane at a
+  * time.\n
+  * Events with a deadline already passed are counted as late and fired from
+  * the lane's IRQ right away, via a software generated compare event.
+  */
+uint32_t HIERODULE_SCHED_Post
+(
+    HIERODULE_SCHED_Lane *Lane,
+    HIERODULE_SCHED_Event *Event,
+    uint64_t Deadline,
+    HIERODULE_SCHED_Callback Callback,
+    void *Context
+)
+{
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+    uint64_t Now;
+
+    if(Event->Index != NOT_QUEUED)
+    {
+        Remove(Lane, Event->Index - 1);
+    }
+    if(Lane->Count >= Lane->Capacity)
+    {
+        HIERODULE_CRITICAL_Exit(Primask);
+        return 0;
+    }
+
+    Event->Deadline = Deadline;
+    Event->Sequence = Lane->Sequence++;
+    Event->Callback = Callback;
+    Event->Context = Context;
+    Lane->Heap[Lane->Count] = Event;
+    Lane->Count++;
+    SiftUp(Lane, Lane->Count - 1);
+
+    Now = HIERODULE_TSTAMP_Get();
+    if(Deadline <= Now)
+    {
+        Lane->Late++;
+    }
+    if(Event->Index == 1)
+    {
+        Arm(Lane, Now);
+    }
+
+    HIERODULE_CRITICAL_Exit(Primask);
+    return 1;
+}
+
+/** @details The compare is programmed again if the earliest event is the
+  * one cancelled.
+  */
+uint32_t HIERODULE_SCHED_Cancel
+(
+    HIERODULE_SCHED_Lane *Lane,
+    HIERODULE_SCHED_Event *Event
+)
+{
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+    uint32_t Index = Event->Index;
+
+    if(Index == NOT_QUEUED)
+    {
+        HIERODULE_CRITICAL_Exit(Primask);
+        return 0;
+    }
+
+    Remove(Lane, Index - 1);
+    if(Index == 1)
+    {
+        Arm(Lane, HIERODULE_TSTAMP_Get());
+    }
+
+    HIERODULE_CRITICAL_Exit(Primask);
+    return 1;
+}
+
+/** @details @rv_obvious
+  */
+uint32_t HIERODULE_SCHED_IsQueued(HIERODULE_SCHED_Event *Event)
+{
+    return (Event->Index != NOT_QUEUED);
+}
+
+/** @details @rv_obvious
+  */
+uint32_t HIERODULE_SCHED_GetLateCount(HIERODULE_SCHED_Lane *Lane)
+{
+    return Lane->Late;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,403 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_step.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the stepper motion profile module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_step.h>
+#include <hierodule_critical.h>
+
+/** @addtogroup Hierodule_Step Stepper Module
+  * @{
+  */
+
+/** @addtogroup STEP_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the profile arithmetic and the update callback that are
+  * used to implement those.
+  * @{
+  */
+
+/** \cond */
+#define Q30         30
+#define ONE_Q30     (1ULL << Q30)
+#define MAX_ARR     0xFFFFUL
+#define CCMR_FIELD  0xFFUL
+#define PWM_PRELOAD (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+/** \endcond */
+
+/** @brief Returns the fraction of the ramp distance covered at a point in
+  * time.
+  * @param Profile: Acceleration profile.
+  * @param Time: Counts since the start of the ramp.
+  * @param Duration: Counts the ramp takes.
+  * @return Fraction of the distance, in Q30.
+  * @details With \f$u\f$ the fraction of the duration elapsed, the distance
+  * is \f$u^2\f$ for the trapezoid, and \f$2u^3 - u^4\f$ for the S-curve,
+  * the integral of its velocity. Both reach the maximum rate at
+  * \f$u = 1\f$, having covered half the distance they would've at that
+  * rate, so a ramp of a given length takes the same time for both.
+  */
+static uint64_t Fraction
+(
+    HIERODULE_STEP_Profile Profile,
+    uint64_t Time,
+    uint64_t Duration
+)
+{
+    uint64_t U = (Time << Q30) / Duration;
+    uint64_t U2 = (U * U) >> Q30;
+
+    if(Profile == HIERODULE_STEP_Profile_TRAPEZOID)
+    {
+        return U2;
+    }
+
+    return ( ((U2 * U) >> Q30) << 1 ) - ((U2 * U2) >> Q30);
+}
+
+/** @brief Sets up the next step interval of an engine.
+  * @param Engine: Pointer to the engine.
+  * @return 1 if there's a next step, 0 if the queue has run dry.
+  * @details The interval is written to ARR, the preload of which is enabled,
+  * so it applies to the period after the current one. The next move is
+  * taken from the queue once the current one is written out, moves of 0
+  * steps being skipped.\n
+  * Step n of a move of S steps accelerates with the element n of the ramp
+  * table and decelerates with the element S-1-n, whichever is smaller,
+  * cruising when both are past the table. Moves too short to reach the
+  * maximum rate turn around in the middle.
+  */
+static uint32_t Advance(HIERODULE_STEP_Engine *Engine)
+{
+    const HIERODULE_STEP_Ramp *Ramp;
+    uint32_t Step;
+
+    while(Engine->Index == Engine->Current.Steps)
+    {
+        if(Engine->Tail == Engine->Head)
+        {
+            return 0;
+        }
+        Engine->Current = Engine->Queue[Engine->Tail % Engine->Capacity];
+        Engine->Tail++;
+        Engine->Index = 0;
+    }
+
+    Ramp = Engine->Current.Ramp;
+    Step = Engine->Current.Steps - 1 - Engine->Index;
+    if(Engine->Index < Step)
+    {
+        Step = Engine->Index;
+    }
+    Engine->Index++;
+
+    WRITE_REG(Engine->Timer->ARR,
+        (Step < Ramp->Length) ? Ramp->Table[Step] : Ramp->Cruise);
+    return 1;
+}
+
+/** @brief Winds an engine down after its last step.
+  * @param Engine: Pointer to the engine.
+  * @return None
+  * @details The compare value is set to 0 and the counter to stop on the
+  * next update event, when the new compare value is latched, so the output
+  * is left inactive after the last step pulse.
+  */
+static void Finish(HIERODULE_STEP_Engine *Engine)
+{
+    *Engine->Compare = 0;
+    SET_BIT(Engine->Timer->CR1, TIM_CR1_OPM);
+}
+
+/** @brief Starts the counter of an idle engine, if there's a queued move.
+  * @param Engine: Pointer to the engine.
+  * @return None
+  * @details The first interval and the pulse width are latched via a
+  * software update event, with URS held so that no update interrupt is
+  * triggered, and the second interval is written to the preload. Called
+  * with interrupts masked, or from the update callback.
+  */
+static void Kick(HIERODULE_STEP_Engine *Engine)
+{
+    TIM_TypeDef *Timer = Engine->Timer;
+
+    if(Advance(Engine) == 0)
+    {
+        return;
+    }
+
+    *Engine->Compare = Engine->Width;
+    CLEAR_BIT(Timer->CR1, TIM_CR1_OPM);
+    SET_BIT(Timer->CR1, TIM_CR1_URS);
+    WRITE_REG(Timer->EGR, TIM_EGR_UG);
+    CLEAR_BIT(Timer->CR1, TIM_CR1_URS);
+
+    if(Advance(Engine) == 0)
+    {
+        Finish(Engine);
+    }
+
+    HIERODULE_TIM_ClearFlag_UPD(Timer);
+    Engine->Running = 1;
+    HIERODULE_TIM_EnableCounter(Timer);
+}
+
+/** @brief Update callback of the engine's timer.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Pointer to the engine.
+  * @return None
+  * @details Each update event completes a step, the pulse of the next one
+  * being output as the event happens, so the interval after it is written
+  * to the preload. If the one-pulse mode is set, the event completed the
+  * last step and stopped the counter, in which case the engine is kicked
+  * again for moves queued in the meantime.
+  */
+static void Update(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    HIERODULE_STEP_Engine *Engine = (HIERODULE_STEP_Engine*)Context;
+
+    (void)Flags;
+
+    Engine->Position++;
+
+    if(READ_BIT(Timer->CR1, TIM_CR1_OPM))
+    {
+        Engine->Running = 0;
+        Kick(Engine);
+    }
+    else if(Advance(Engine) == 0)
+    {
+        Finish(Engine);
+    }
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup STEP_Public Global
+  * @{
+  */
+
+/** @details The time step n of the ramp is due at, with a fraction of
+  * n over the length of the ramp covered, is searched for by bisection on
+  * @ref Fraction "Fraction", in counts, and the intervals are the
+  * differences of consecutive ones. Since every step is placed on the ideal
+  * profile rather than accumulated from the intervals before it, rounding
+  * errors don't add up; each step is within a count of its ideal time,
+  * give or take the Q30 resolution of the fraction of the distance.\n
+  * Only integer arithmetic is used, meant to be performed once at
+  * startup, not on every step. The ramp takes \f$2 * Length / MaxRate\f$
+  * seconds, which in counts should fit in 32 bits. For a trapezoid with an
+  * acceleration of \f$a\f$ steps/s², the length is
+  * \f$MaxRate^2 / (2a)\f$.\n
+  * Intervals are rounded to counts and stored as ARR values, intervals
+  * longer than the 16 bit ARR range or shorter than 2 counts are clamped.
+  * Pick the prescaler for the slowest step, the first one, to fit.
+  */
+uint32_t HIERODULE_STEP_ComputeRamp
+(
+    HIERODULE_STEP_Ramp *Ramp,
+    uint16_t *Table,
+    uint32_t Length,
+    HIERODULE_STEP_Profile Profile,
+    uint32_t TickFreq_Hz,
+    uint32_t MaxRate_Hz
+)
+{
+    uint64_t Duration = ((uint64_t)Length * TickFreq_Hz * 2 + MaxRate_Hz/2)
+        / MaxRate_Hz;
+    uint64_t Cruise = ((uint64_t)TickFreq_Hz + MaxRate_Hz/2) / MaxRate_Hz;
+    uint64_t Previous = 0;
+    uint32_t Clamped = 0;
+
+    Ramp->Table = Table;
+    Ramp->Length = Length;
+    Ramp->Cruise = (uint16_t)( (Cruise > MAX_ARR+1) ? MAX_ARR
+        : ((Cruise < 2) ? 1 : Cruise-1) );
+
+    for(uint32_t Step = 1 ; Step <= Length ; Step++)
+    {
+        uint64_t Target = (uint64_t)Step << Q30;
+        uint64_t Low = Previous;
+        uint64_t High = Duration;
+        uint64_t Interval;
+
+        while(High - Low > 1)
+        {
+            uint64_t Middle = Low + ((High - Low) >> 1);
+
+            if(Fraction(Profile, Middle, Duration) * Length >= Target)
+            {
+                High = Middle;
+            }
+            else
+            {
+                Low = Middle;
+            }
+        }
+
+        Interval = High - Previous;
+        Previous = High;
+
+        if(Interval > MAX_ARR+1)
+        {
+            Table[Step-1] = MAX_ARR;
+            Clamped++;
+        }
+        else if(Interval < 2)
+        {
+            Table[Step-1] = 1;
+            Clamped++;
+        }
+        else
+        {
+            Table[Step-1] = (uint16_t)(Interval - 1);
+        }
+    }
+
+    return Clamped;
+}
+
+/** @details The channel is set to PWM mode 1 with its compare preload
+  * enabled, so the step pulse is output at the start of each period, and
+  * the preload of ARR is enabled. The channel output is enabled, the main
+  * output of advanced timers is left for the caller. The prescaler is left
+  * as is, it sets the frequency the ramps are to be computed for.\n
+  * The update interrupt is taken over via
+  * @ref HIERODULE_TIM_Assign_Callback_UPD "HIERODULE_TIM_Assign_Callback_UPD"
+  * and enabled, the NVIC line of the timer is left for the caller to
+  * enable.\n
+  * The channel should be 1 to 4, the engine is left unusable, with a
+  * capacity of 0 and the timer untouched, otherwise.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+void HIERODULE_STEP_Init
+(
+    HIERODULE_STEP_Engine *Engine,
+    TIM_TypeDef *Timer,
+    uint8_t Channel,
+    uint16_t Width,
+    HIERODULE_STEP_Move *Queue,
+    uint32_t Capacity
+)
+{
+    uint32_t Index = Channel - 1;
+    volatile uint32_t *ModeRegister;
+
+    Engine->Timer = Timer;
+    Engine->Compare = NULL;
+    Engine->Queue = Queue;
+    Engine->Capacity = 0;
+    Engine->Head = 0;
+    Engine->Tail = 0;
+    Engine->Current.Ramp = NULL;
+    Engine->Current.Steps = 0;
+    Engine->Index = 0;
+    Engine->Position = 0;
+    Engine->Running = 0;
+    Engine->Width = Width;
+
+    if( (Channel < 1) || (Channel > 4) )
+    {
+        return;
+    }
+
+    ModeRegister = (Index < 2) ? &Timer->CCMR1 : &Timer->CCMR2;
+    Engine->Compare = &Timer->CCR1 + Index;
+    Engine->Capacity = Capacity;
+
+    HIERODULE_TIM_DisableCounter(Timer);
+    MODIFY_REG(*ModeRegister, CCMR_FIELD << ((Index & 1) << 3),
+        PWM_PRELOAD << ((Index & 1) << 3));
+    *Engine->Compare = 0;
+    SET_BIT(Timer->CR1, TIM_CR1_ARPE);
+    HIERODULE_TIM_EnableChannel(Timer, (int8_t)Channel);
+
+    HIERODULE_TIM_Assign_Callback_UPD(Timer, &Update, Engine);
+    HIERODULE_TIM_ClearFlag_UPD(Timer);
+    HIERODULE_TIM_Enable_IT_UPD(Timer);
+}
+
+/** @details Moves are taken from the queue as the steps before them are
+  * written out, back to back with no gap in between; each move starts and
+  * ends at standstill on its own ramp.\n
+  * If the engine is idle, the counter is started right away. Otherwise, the
+  * move starts with no gap after the queued ones, as long as it's queued
+  * before the last step of those starts. Queued any later, it starts a
+  * period after the last step instead.\n
+  * Each interval needs to be longer than the update interrupt latency, and
+  * the pulse width.
+  */
+uint32_t HIERODULE_STEP_Post
+(
+    HIERODULE_STEP_Engine *Engine,
+    const HIERODULE_STEP_Ramp *Ramp,
+    uint32_t Steps
+)
+{
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+    HIERODULE_STEP_Move *Slot;
+
+    if(Engine->Head - Engine->Tail >= Engine->Capacity)
+    {
+        HIERODULE_CRITICAL_Exit(Primask);
+        return 0;
+    }
+
+    Slot = &Engine->Queue[Engine->Head % Engine->Capacity];
+    Slot->Ramp = Ramp;
+    Slot->Steps = Steps;
+    Engine->Head++;
+
+    if(Engine->Running == 0)
+    {
+        Kick(Engine);
+    }
+
+    HIERODULE_CRITICAL_Exit(Primask);
+    return 1;
+}
+
+/** @details A step is counted once its interval is over, at the update
+  * event that ends it.
+  */
+uint32_t HIERODULE_STEP_GetPosition(HIERODULE_STEP_Engine *Engine)
+{
+    return Engine->Position;
+}
+
+/** @details The move whose steps are being output isn't counted.
+  */
+uint32_t HIERODULE_STEP_GetPending(HIERODULE_STEP_Engine *Engine)
+{
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+    uint32_t Pending = Engine->Head - Engine->Tail;
+
+    HIERODULE_CRITICAL_Exit(Primask);
+    return Pending;
+}
+
+/** @details @rv_obvious
+  */
+uint32_t HIERODULE_STEP_IsRunning(HIERODULE_STEP_Engine *Engine)
+{
+    return Engine->Running;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
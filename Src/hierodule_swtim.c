@@ -0,0 +1,626 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_swtim.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the software timer module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_swtim.h>
+#include <hierodule_critical.h>
+
+/** @addtogroup Hierodule_Swtim Software Timer Module
+  * @{
+  */
+
+/** @addtogroup SWTIM_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the timing wheel and routines that are used to
+  * implement those.
+  * @{
+  */
+
+/** \cond */
+#define LEVELS      4
+#define SLOT_BITS   6
+#define SLOTS       (1UL << SLOT_BITS)
+#define SLOT_MASK   (SLOTS - 1)
+#define WHEEL_SPAN  (1UL << (LEVELS * SLOT_BITS))
+#define MAX_DELAY   0x7FFFFFFFUL
+#define COUNT_MASK  0xFFFFUL
+#define MAX_SLEEP   (COUNT_MASK >> 1)
+/** \endcond */
+
+/** @brief Heads of the timer lists in each slot of each level of the wheel.
+  * @details Level n slots span 64^n ticks each. A timer is kept in the
+  * lowest level whose range covers its remaining delay, and is cascaded
+  * down a level each time the wheel index of the level above comes around
+  * to its slot.
+  */
+static HIERODULE_SWTIM_Timer *Wheel[LEVELS][SLOTS];
+
+/** @brief Slot occupancy bitmaps of each level of the wheel.
+  * @details Bit n is set while slot n has at least one timer in it. Used to
+  * find the next tick to wake up at in tickless mode.
+  */
+static uint64_t Occupancy[LEVELS];
+
+/** @brief Head of the list of timers in the pool that are not created.
+  */
+static HIERODULE_SWTIM_Timer *FreeList = NULL;
+
+/** @brief The hardware timer the module runs on.
+  */
+static TIM_TypeDef *HardwareTimer = NULL;
+
+/** @brief The mode the module runs in.
+  */
+static HIERODULE_SWTIM_Mode WheelMode = HIERODULE_SWTIM_Mode_PERIODIC;
+
+/** @brief The tick the wheel has been processed up to.
+  */
+static volatile uint32_t Now = 0;
+
+/** @brief The tick corresponding to @ref LastCount "LastCount".
+  * @details Equals @ref Now "Now" in periodic mode. In tickless mode, it's
+  * the tick the wheel is being advanced to by the IRQ.
+  */
+static volatile uint32_t Horizon = 0;
+
+/** @brief Counter value of the hardware timer at @ref Horizon "Horizon".
+  * @details Used in tickless mode only.
+  */
+static volatile uint32_t LastCount = 0;
+
+/** @brief Links a timer into the wheel slot its expiry falls in.
+  * @param Timer: Pointer to the software timer.
+  * @return None
+  * @details The slot is selected relative to @ref Now "Now". Delays beyond
+  * the span of the wheel are parked at the farthest top level slot, to be
+  * cascaded and parked again until they're in range.
+  */
+static void Link(HIERODULE_SWTIM_Timer *Timer)
+{
+    uint32_t Delta = Timer->Expiry - Now;
+    uint32_t Index = Timer->Expiry;
+    uint32_t Level = 0;
+    uint32_t Slot;
+
+    if(Delta >= WHEEL_SPAN)
+    {
+        Delta = WHEEL_SPAN - 1;
+        Index = Now + Delta;
+    }
+    while( (Level < (LEVELS - 1)) &&
+        (Delta >= (SLOTS << (Level * SLOT_BITS))) )
+    {
+        Level++;
+    }
+    Slot = (Index >> (Level * SLOT_BITS)) & SLOT_MASK;
+
+    Timer->Bucket = (uint16_t)((Level << SLOT_BITS) | Slot);
+    Timer->Prev = NULL;
+    Timer->Next = Wheel[Level][Slot];
+    if(Timer->Next != NULL)
+    {
+        Timer->Next->Prev = Timer;
+    }
+    Wheel[Level][Slot] = Timer;
+    Occupancy[Level] |= (1ULL << Slot);
+}
+
+/** @brief Unlinks a timer from its wheel slot.
+  * @param Timer: Pointer to the software timer.
+  * @return None
+  * @details @rv_obvious
+  */
+static void Unlink(HIERODULE_SWTIM_Timer *Timer)
+{
+    uint32_t Level = Timer->Bucket >> SLOT_BITS;
+    uint32_t Slot = Timer->Bucket & SLOT_MASK;
+
+    if(Timer->Prev != NULL)
+    {
+        Timer->Prev->Next = Timer->Next;
+    }
+    else
+    {
+        Wheel[Level][Slot] = Timer->Next;
+    }
+    if(Timer->Next != NULL)
+    {
+        Timer->Next->Prev = Timer->Prev;
+    }
+    if(Wheel[Level][Slot] == NULL)
+    {
+        Occupancy[Level] &= ~(1ULL << Slot);
+    }
+}
+
+/** @brief Moves every timer in a slot to the slot its expiry falls in now.
+  * @param Level: Level of the slot, 1 or higher.
+  * @param Slot: Index of the slot.
+  * @return None
+  * @details @rv_obvious
+  */
+static void Cascade(uint32_t Level, uint32_t Slot)
+{
+    HIERODULE_SWTIM_Timer *Timer = Wheel[Level][Slot];
+    HIERODULE_SWTIM_Timer *Next;
+
+    Wheel[Level][Slot] = NULL;
+    Occupancy[Level] &= ~(1ULL << Slot);
+
+    while(Timer != NULL)
+    {
+        Next = Timer->Next;
+        Link(Timer);
+        Timer = Next;
+    }
+}
+
+/** @brief Advances the wheel by one tick, cascading and expiring timers as
+  * necessary.
+  * @return None
+  * @details Cascading is done top-down, so that timers may fall through
+  * more than one level on the same tick. Expired timers are unlinked one at
+  * a time with interrupts masked, and their callbacks are performed with
+  * the mask restored. Periodic timers are re-armed relative to their
+  * previous expiry, so they don't drift, or to the next tick if they're
+  * already overdue.
+  */
+static void ProcessTick(void)
+{
+    HIERODULE_SWTIM_Timer *Timer;
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+    uint32_t Tick = Now + 1;
+    uint32_t Slot;
+
+    Now = Tick;
+    if(WheelMode == HIERODULE_SWTIM_Mode_PERIODIC)
+    {
+        Horizon = Tick;
+    }
+
+    if( (Tick & SLOT_MASK) == 0 )
+    {
+        uint32_t Level = 1;
+
+        while( (Level < (LEVELS - 1)) &&
+            (((Tick >> (Level * SLOT_BITS)) & SLOT_MASK) == 0) )
+        {
+            Level++;
+        }
+        while(Level > 0)
+        {
+            Cascade(Level, (Tick >> (Level * SLOT_BITS)) & SLOT_MASK);
+            Level--;
+        }
+    }
+
+    Slot = Tick & SLOT_MASK;
+    while( (Timer = Wheel[0][Slot]) != NULL )
+    {
+        Unlink(Timer);
+        if(Timer->Expiry != Tick)
+        {
+            Link(Timer);
+            continue;
+        }
+        if(Timer->Period != 0)
+        {
+            Timer->Expiry += Timer->Period;
+            if( (int32_t)(Timer->Expiry - Tick) <= 0 )
+            {
+                Timer->Expiry = Tick + 1;
+            }
+            Link(Timer);
+        }
+        else
+        {
+            Timer->Armed = 0;
+        }
+
+        HIERODULE_CRITICAL_Exit(Primask);
+        if(Timer->Callback != NULL)
+        {
+            Timer->Callback(Timer, Timer->Context);
+        }
+        Primask = HIERODULE_CRITICAL_Enter();
+    }
+    HIERODULE_CRITICAL_Exit(Primask);
+}
+
+/** @brief Returns the distance to the nearest set bit of an occupancy bitmap,
+  * going up from an index.
+  * @param Bitmap: Occupancy bitmap, not 0.
+  * @param Index: Current index of the level.
+  * @return Distance in slots, 1 to 64.
+  * @details The bitmap is rotated so that the slot after the current one
+  * lands on bit 0, the current slot itself being the farthest.
+  */
+static inline uint32_t NextSlot(uint64_t Bitmap, uint32_t Index)
+{
+    uint32_t Shift = (Index + 1) & SLOT_MASK;
+
+    if(Shift != 0)
+    {
+        Bitmap = (Bitmap >> Shift) | (Bitmap << (SLOTS - Shift));
+    }
+    return (uint32_t)__builtin_ctzll(Bitmap) + 1;
+}
+
+/** @brief Returns the number of ticks until the wheel needs processing.
+  * @return Ticks until the next expiry or cascade of a non-empty slot,
+  * 0 if the wheel is empty.
+  * @details For levels above 0, the tick the next non-empty slot gets
+  * cascaded at is a lower bound of the expiries in it, so waking up then
+  * never misses a deadline.
+  */
+static uint32_t NextEvent(void)
+{
+    uint32_t Best = 0;
+    uint32_t Level;
+    uint32_t Delta;
+    uint32_t Shift;
+
+    for(Level = 0 ; Level < LEVELS ; Level++)
+    {
+        if(Occupancy[Level] == 0)
+        {
+            continue;
+        }
+        Shift = Level * SLOT_BITS;
+        Delta = NextSlot(Occupancy[Level], (Now >> Shift) & SLOT_MASK);
+        if(Level != 0)
+        {
+            Delta = ((((Now >> Shift) + Delta) << Shift)) - Now;
+        }
+        if( (Best == 0) || (Delta < Best) )
+        {
+            Best = Delta;
+        }
+    }
+    return Best;
+}
+
+/** @brief Programs the capture compare channel 1 for the next tick the wheel
+  * needs processing at.
+  * @return None
+  * @details The sleep is measured from @ref Horizon "Horizon", which may be
+  * ahead of @ref Now "Now" if this is called while the wheel is being
+  * advanced. Sleeps are capped at half the counter range, so that elapsed
+  * counts stay unambiguous. The longest sleep is also taken while the wheel
+  * is empty, so that @ref Horizon "Horizon" keeps up with the counter
+  * across its wraps. If the tick is already due, or the counter has already
+  * passed the programmed value, a capture compare event is generated to have
+  * the IRQ pending right away.
+  */
+static void Reprogram(void)
+{
+    uint32_t Sleep = NextEvent();
+    uint32_t Lag = Horizon - Now;
+
+    if(Sleep == 0)
+    {
+        Sleep = MAX_SLEEP;
+    }
+    else
+    {
+        Sleep = (Sleep > Lag) ? (Sleep - Lag) : 0;
+    }
+    if(Sleep > MAX_SLEEP)
+    {
+        Sleep = MAX_SLEEP;
+    }
+
+    WRITE_REG(HardwareTimer->CCR1, (LastCount + Sleep) & COUNT_MASK);
+    SET_BIT(HardwareTimer->DIER, TIM_DIER_CC1IE);
+
+    if( ((READ_REG(HardwareTimer->CNT) - LastCount) & COUNT_MASK) >= Sleep )
+    {
+        WRITE_REG(HardwareTimer->EGR, TIM_EGR_CC1G);
+    }
+}
+
+/** @brief Returns the current tick in tickless mode.
+  * @return @ref Horizon "Horizon" plus the counts elapsed since.
+  * @details @rv_obvious
+  */
+static inline uint32_t CurrentTick(void)
+{
+    return Horizon +
+        ((READ_REG(HardwareTimer->CNT) - LastCount) & COUNT_MASK);
+}
+
+/** @brief Update callback of the hardware timer in periodic mode.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Unused.
+  * @return None
+  * @details @rv_obvious
+  */
+static void PeriodicTick(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    (void)Timer;
+    (void)Flags;
+    (void)Context;
+
+    ProcessTick();
+}
+
+/** @brief Capture compare channel 1 callback of the hardware timer in
+  * tickless mode.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Unused.
+  * @return None
+  * @details The counts elapsed since the last call are taken in at once.
+  * Ticks where nothing is due are skipped over, so the cost depends on the
+  * number of slots to process, not on the time slept.
+  */
+static void TicklessTick(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+    uint32_t Count = READ_REG(Timer->CNT) & COUNT_MASK;
+    uint32_t Next;
+
+    (void)Flags;
+    (void)Context;
+
+    Horizon += (Count - LastCount) & COUNT_MASK;
+    LastCount = Count;
+    HIERODULE_CRITICAL_Exit(Primask);
+
+    while(1)
+    {
+        Primask = HIERODULE_CRITICAL_Enter();
+        Next = NextEvent();
+        if( (Next == 0) || (Next > (Horizon - Now)) )
+        {
+            Now = Horizon;
+            break;
+        }
+        Now += Next - 1;
+        HIERODULE_CRITICAL_Exit(Primask);
+        ProcessTick();
+    }
+    Reprogram();
+    HIERODULE_CRITICAL_Exit(Primask);
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup SWTIM_Public Global
+  * @{
+  */
+
+/** @details The pool is chained into the free list and the wheel is
+  * emptied.\n
+  * In periodic mode, the wheel ticks on the update interrupt, via
+  * @ref HIERODULE_TIM_Assign_Callback_UPD "HIERODULE_TIM_Assign_Callback_UPD".
+  * Set the period of the timer to the tick duration beforehand.\n
+  * In tickless mode, ARR is set to 0xFFFF and the wheel ticks on the capture
+  * compare channel 1 interrupt, via
+  * @ref HIERODULE_TIM_Assign_Callback_CC1 "HIERODULE_TIM_Assign_Callback_CC1".
+  * Set the prescaler so that a count is a tick beforehand. The channel is
+  * armed right away, and stays armed while no timer is, to keep track of the
+  * counter wraps.\n
+  * The counter and the NVIC line of the timer are left for the caller to
+  * enable.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+void HIERODULE_SWTIM_Init
+(
+    TIM_TypeDef *Timer,
+    HIERODULE_SWTIM_Timer *Pool,
+    uint32_t PoolSize,
+    HIERODULE_SWTIM_Mode Mode
+)
+{
+    uint32_t Level;
+    uint32_t Slot;
+
+    for(Level = 0 ; Level < LEVELS ; Level++)
+    {
+        for(Slot = 0 ; Slot < SLOTS ; Slot++)
+        {
+            Wheel[Level][Slot] = NULL;
+        }
+        Occupancy[Level] = 0;
+    }
+
+    FreeList = NULL;
+    while(PoolSize > 0)
+    {
+        PoolSize--;
+        Pool[PoolSize].Armed = 0;
+        Pool[PoolSize].Next = FreeList;
+        FreeList = &Pool[PoolSize];
+    }
+
+    HardwareTimer = Timer;
+    WheelMode = Mode;
+    Now = 0;
+    Horizon = 0;
+
+    if(Mode == HIERODULE_SWTIM_Mode_TICKLESS)
+    {
+        WRITE_REG(Timer->ARR, COUNT_MASK);
+        LastCount = READ_REG(Timer->CNT) & COUNT_MASK;
+        HIERODULE_TIM_Assign_Callback_CC1(Timer, &TicklessTick, NULL);
+        HIERODULE_TIM_ClearFlag_CC1(Timer);
+        Reprogram();
+    }
+    else
+    {
+        HIERODULE_TIM_Assign_Callback_UPD(Timer, &PeriodicTick, NULL);
+        HIERODULE_TIM_Enable_IT_UPD(Timer);
+    }
+}
+
+/** @details The timer is popped off the free list, with interrupts masked.
+  */
+HIERODULE_SWTIM_Timer *HIERODULE_SWTIM_Create
+(
+    HIERODULE_SWTIM_Callback Callback,
+    void *Context
+)
+{
+    HIERODULE_SWTIM_Timer *Timer;
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+
+    Timer = FreeList;
+    if(Timer != NULL)
+    {
+        FreeList = Timer->Next;
+    }
+    HIERODULE_CRITICAL_Exit(Primask);
+
+    if(Timer != NULL)
+    {
+        Timer->Next = NULL;
+        Timer->Prev = NULL;
+        Timer->Delay = 0;
+        Timer->Period = 0;
+        Timer->Armed = 0;
+        Timer->Callback = Callback;
+        Timer->Context = Context;
+    }
+    return Timer;
+}
+
+/** @details The timer is stopped and pushed back onto the free list.
+  */
+void HIERODULE_SWTIM_Delete(HIERODULE_SWTIM_Timer *Timer)
+{
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+
+    if(Timer->Armed != 0)
+    {
+        Unlink(Timer);
+        Timer->Armed = 0;
+    }
+    Timer->Next = FreeList;
+    FreeList = Timer;
+    HIERODULE_CRITICAL_Exit(Primask);
+}
+
+/** @details The expiry is set relative to the current tick. In periodic
+  * mode, the current tick is partly over, so the first expiry comes after
+  * Delay-1 to Delay tick durations. A delay of 0 is taken as 1 and delays
+  * are capped at 0x7FFFFFFF ticks.\n
+  * Linking and unlinking are O(1). In tickless mode, the capture compare
+  * channel is reprogrammed if the timer expires earlier than whatever the
+  * channel is programmed for.
+  */
+void HIERODULE_SWTIM_Start
+(
+    HIERODULE_SWTIM_Timer *Timer,
+    uint32_t Delay,
+    uint32_t Period
+)
+{
+    uint32_t Primask;
+
+    if(Delay == 0)
+    {
+        Delay = 1;
+    }
+    else if(Delay > MAX_DELAY)
+    {
+        Delay = MAX_DELAY;
+    }
+    if(Period > MAX_DELAY)
+    {
+        Period = MAX_DELAY;
+    }
+
+    Primask = HIERODULE_CRITICAL_Enter();
+    if(Timer->Armed != 0)
+    {
+        Unlink(Timer);
+    }
+    Timer->Delay = Delay;
+    Timer->Period = Period;
+    Timer->Armed = 1;
+
+    if(WheelMode == HIERODULE_SWTIM_Mode_TICKLESS)
+    {
+        Timer->Expiry = CurrentTick() + Delay;
+        Link(Timer);
+        Reprogram();
+    }
+    else
+    {
+        Timer->Expiry = Now + Delay;
+        Link(Timer);
+    }
+    HIERODULE_CRITICAL_Exit(Primask);
+}
+
+/** @details @rv_obvious
+  */
+void HIERODULE_SWTIM_Restart(HIERODULE_SWTIM_Timer *Timer)
+{
+    HIERODULE_SWTIM_Start(Timer, Timer->Delay, Timer->Period);
+}
+
+/** @details The timer is unlinked from its slot in O(1). The capture compare
+  * channel isn't reprogrammed in tickless mode, an early wake-up simply finds
+  * nothing to do.
+  */
+void HIERODULE_SWTIM_Stop(HIERODULE_SWTIM_Timer *Timer)
+{
+    uint32_t Primask = HIERODULE_CRITICAL_Enter();
+
+    if(Timer->Armed != 0)
+    {
+        Unlink(Timer);
+        Timer->Armed = 0;
+    }
+    HIERODULE_CRITICAL_Exit(Primask);
+}
+
+/** @details @rv_obvious
+  */
+uint32_t HIERODULE_SWTIM_IsArmed(HIERODULE_SWTIM_Timer *Timer)
+{
+    return (Timer->Armed != 0) ? 1UL : 0UL;
+}
+
+/** @details In tickless mode, the counts elapsed since the wheel was last
+  * processed are added.
+  */
+uint32_t HIERODULE_SWTIM_GetTick(void)
+{
+    uint32_t Tick;
+    uint32_t Primask;
+
+    if(WheelMode == HIERODULE_SWTIM_Mode_TICKLESS)
+    {
+        Primask = HIERODULE_CRITICAL_Enter();
+        Tick = CurrentTick();
+        HIERODULE_CRITICAL_Exit(Primask);
+    }
+    else
+    {
+        Tick = Now;
+    }
+    return Tick;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,265 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tickless.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the tickless idle module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_tickless.h>
+
+/** @addtogroup Hierodule_Tickless Tickless Idle Module
+  * @{
+  */
+
+/** @addtogroup TICKLESS_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the tick callback and the FreeRTOS port hook that are
+  * used to implement those.
+  * @{
+  */
+
+/** \cond */
+#define COUNT_MASK  0xFFFFUL
+#define PERIOD      ((uint32_t)HIERODULE_TICKLESS_COUNTS_PER_TICK)
+#define MAX_IDLE    ((COUNT_MASK + 1) / PERIOD - 2)
+
+#if HIERODULE_TICKLESS_CHANNEL == 1
+#define CC_REG      CCR1
+#define CC_EVENT    TIM_EGR_CC1G
+#define CC_ASSIGN   HIERODULE_TIM_Assign_Callback_CC1
+#define CC_CLEAR    HIERODULE_TIM_ClearFlag_CC1
+#define CC_ENABLE   HIERODULE_TIM_Enable_IT_CC1
+#elif HIERODULE_TICKLESS_CHANNEL == 2
+#define CC_REG      CCR2
+#define CC_EVENT    TIM_EGR_CC2G
+#define CC_ASSIGN   HIERODULE_TIM_Assign_Callback_CC2
+#define CC_CLEAR    HIERODULE_TIM_ClearFlag_CC2
+#define CC_ENABLE   HIERODULE_TIM_Enable_IT_CC2
+#elif HIERODULE_TICKLESS_CHANNEL == 3
+#define CC_REG      CCR3
+#define CC_EVENT    TIM_EGR_CC3G
+#define CC_ASSIGN   HIERODULE_TIM_Assign_Callback_CC3
+#define CC_CLEAR    HIERODULE_TIM_ClearFlag_CC3
+#define CC_ENABLE   HIERODULE_TIM_Enable_IT_CC3
+#elif HIERODULE_TICKLESS_CHANNEL == 4
+#define CC_REG      CCR4
+#define CC_EVENT    TIM_EGR_CC4G
+#define CC_ASSIGN   HIERODULE_TIM_Assign_Callback_CC4
+#define CC_CLEAR    HIERODULE_TIM_ClearFlag_CC4
+#define CC_ENABLE   HIERODULE_TIM_Enable_IT_CC4
+#endif
+/** \endcond */
+
+/** @brief The timer the module runs on.
+  */
+static TIM_TypeDef *HardwareTimer = NULL;
+
+/** @brief Counter value of the last tick counted.
+  * @details Only ever advanced by whole ticks, so the ticks stay on a fixed
+  * grid of the free running counter, and no count is lost however late the
+  * interrupts are serviced or however long the sleeps are.
+  */
+static uint32_t LastTick = 0;
+
+/** @brief Number of ticks stepped over in sleeps.
+  */
+static volatile uint32_t SleptTicks = 0;
+
+/** @brief Returns the counts elapsed since the last tick counted.
+  * @return Counts, 0 to 65535.
+  * @details @rv_obvious
+  */
+static inline uint32_t SinceLastTick(void)
+{
+    return (READ_REG(HardwareTimer->CNT) - LastTick) & COUNT_MASK;
+}
+
+/** @brief Capture compare callback of the timer.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Unused.
+  * @return None
+  * @details The kernel tick is incremented for each whole tick period that
+  * has passed since the last tick counted, with the compare register moved
+  * a period ahead each time. The counter is checked again after the compare
+  * register is written, so a compare value that's already passed is never
+  * left waiting for the counter to come around. A context switch is
+  * requested if the kernel asks for one.
+  */
+static void Tick(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    UBaseType_t Mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    BaseType_t Switch = pdFALSE;
+
+    (void)Flags;
+    (void)Context;
+
+    while(SinceLastTick() >= PERIOD)
+    {
+        LastTick = (LastTick + PERIOD) & COUNT_MASK;
+        if(xTaskIncrementTick() != pdFALSE)
+        {
+            Switch = pdTRUE;
+        }
+        WRITE_REG(Timer->CC_REG, (LastTick + PERIOD) & COUNT_MASK);
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(Mask);
+    portYIELD_FROM_ISR(Switch);
+}
+
+/** @brief Sets the tick interrupt up, overriding the SysTick setup of the
+  * FreeRTOS port.
+  * @return None
+  * @details Called by the kernel as the scheduler starts. The module is
+  * initialized on @ref HIERODULE_TICKLESS_TIMER "HIERODULE_TICKLESS_TIMER"
+  * and the counter is enabled. The SysTick setup of the Cortex-M ports is
+  * a weak symbol, which this definition replaces.
+  */
+void vPortSetupTimerInterrupt(void)
+{
+    HIERODULE_TICKLESS_Init(HIERODULE_TICKLESS_TIMER);
+    HIERODULE_TIM_EnableCounter(HIERODULE_TICKLESS_TIMER);
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup TICKLESS_Public Global
+  * @{
+  */
+
+/** @details The prescaler is set so that the timer counts
+  * @ref HIERODULE_TICKLESS_COUNTS_PER_TICK
+  * "HIERODULE_TICKLESS_COUNTS_PER_TICK" times per tick, and latched via a
+  * software update event. ARR is set to 0xFFFF, the counter is cleared, and
+  * the compare register of the channel selected by
+  * @ref HIERODULE_TICKLESS_CHANNEL "HIERODULE_TICKLESS_CHANNEL" is set for
+  * the first tick. The compare interrupt is assigned the tick callback and
+  * enabled.\n
+  * The counter is never cleared again, ticks are marked by moving the
+  * compare register on a fixed grid, so the tick doesn't drift.\n
+  * Called by the kernel via vPortSetupTimerInterrupt, which also enables
+  * the counter. The NVIC line of the timer is left for the caller to
+  * enable, at the lowest priority, the same as the kernel interrupts.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+void HIERODULE_TICKLESS_Init(TIM_TypeDef *Timer)
+{
+    uint32_t Rate = (uint32_t)configTICK_RATE_HZ * PERIOD;
+
+    HardwareTimer = Timer;
+    LastTick = 0;
+    SleptTicks = 0;
+
+    WRITE_REG(Timer->PSC,
+        (HIERODULE_TIM_GetKernelClock(Timer) + Rate/2) / Rate - 1);
+    WRITE_REG(Timer->ARR, COUNT_MASK);
+    WRITE_REG(Timer->EGR, TIM_EGR_UG);
+    HIERODULE_TIM_ClearFlag_UPD(Timer);
+    HIERODULE_TIM_ClearCounter(Timer);
+    WRITE_REG(Timer->CC_REG, PERIOD);
+
+    CC_ASSIGN(Timer, &Tick, NULL);
+    CC_CLEAR(Timer);
+    CC_ENABLE(Timer);
+}
+
+/** @details Meant to be called by the kernel, via portSUPPRESS_TICKS_AND_SLEEP,
+  * with the scheduler suspended. Interrupts are masked and the kernel is
+  * asked to confirm the sleep. Then the compare register is moved from the
+  * next tick to the expected wake-up, a whole number of ticks on the same
+  * grid, and the core sleeps via WFI until it or any other interrupt.
+  * configPRE_SLEEP_PROCESSING and configPOST_SLEEP_PROCESSING are performed
+  * around the sleep, as they are in the FreeRTOS ports.\n
+  * On wake-up, the whole ticks elapsed are worked out from the counter, so
+  * the time asleep is accounted for to the count. All but the last one are
+  * stepped over via vTaskStepTick, and the last one is left to the tick
+  * callback, by generating the compare event, so that the kernel processes
+  * it like any tick, unblocking the task it woke for. The fraction of a
+  * tick stays in the counter, to be counted by the next tick.\n
+  * The sleep is aborted if a tick falls due while it's being set up. Sleeps
+  * are limited to 65536 counts minus two ticks, longer idle times being
+  * slept in pieces. The timer keeps counting in sleep mode, not in stop
+  * mode.
+  */
+void HIERODULE_TICKLESS_SuppressTicksAndSleep(TickType_t ExpectedIdleTime)
+{
+    TIM_TypeDef *Timer = HardwareTimer;
+    TickType_t Limit = (ExpectedIdleTime > MAX_IDLE) ? MAX_IDLE
+        : ExpectedIdleTime;
+    TickType_t Sleep = Limit;
+    uint32_t Elapsed;
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    if(eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        __enable_irq();
+        return;
+    }
+
+    WRITE_REG(Timer->CC_REG, (LastTick + Limit * PERIOD) & COUNT_MASK);
+    CC_CLEAR(Timer);
+    if(SinceLastTick() >= PERIOD)
+    {
+        WRITE_REG(Timer->CC_REG, (LastTick + PERIOD) & COUNT_MASK);
+        WRITE_REG(Timer->EGR, CC_EVENT);
+        __enable_irq();
+        return;
+    }
+
+    configPRE_SLEEP_PROCESSING(Sleep);
+    if(Sleep > 0)
+    {
+        __DSB();
+        __WFI();
+        __ISB();
+    }
+    configPOST_SLEEP_PROCESSING(Sleep);
+
+    Elapsed = SinceLastTick() / PERIOD;
+    if(Elapsed > Limit)
+    {
+        Elapsed = Limit;
+    }
+    if(Elapsed > 1)
+    {
+        vTaskStepTick(Elapsed - 1);
+        LastTick = (LastTick + (Elapsed - 1) * PERIOD) & COUNT_MASK;
+        SleptTicks += Elapsed - 1;
+    }
+
+    WRITE_REG(Timer->CC_REG, (LastTick + PERIOD) & COUNT_MASK);
+    CC_CLEAR(Timer);
+    if(Elapsed > 0)
+    {
+        WRITE_REG(Timer->EGR, CC_EVENT);
+    }
+
+    __enable_irq();
+}
+
+/** @details The ticks left to the tick callback on wake-up aren't counted.
+  */
+uint32_t HIERODULE_TICKLESS_GetSleptTicks(void)
+{
+    return SleptTicks;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
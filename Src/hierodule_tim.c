@@ -24,16 +24,6 @@
   * @{
   */
 
-/** \cond */
-#ifdef HIERODULE_TIM_HANDLE_IRQ
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-/** @brief Used to reference a clear-flag routine for @ref Check_IT "Check_IT".
-  */
-        typedef void (*T2V_Function_Pointer)(TIM_TypeDef*);
-    /** \cond */
-    #endif
-#endif /** \endcond */
-
 /** @brief @rv_apb_check 1.\n
   * @rv_def_req_device{__STM32F030x6_H}
   */
@@ -56,325 +46,7 @@ static const uint32_t APB2_DIV1 = (RCC_CFGR_PPRE2_DIV1>>RCC_CFGR_PPRE2_Pos);
 
 /** \cond */
 #ifdef HIERODULE_TIM_HANDLE_IRQ
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-/** @brief @rv_fp_conv_isr{update,1}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM1 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,1}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM1 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 2,1}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC2_Handler_TIM1 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 3,1}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC3_Handler_TIM1 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 4,1}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC4_Handler_TIM1 = NULL;
-
-/** @brief @rv_fp_conv_isr{break,1}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER BRK_Handler_TIM1 = NULL;
-
-/** @brief @rv_fp_conv_isr{update,2}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER UPD_Handler_TIM2 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,2}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER CC1_Handler_TIM2 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{capture compare channel 2,2}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER CC2_Handler_TIM2 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{capture compare channel 3,2}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER CC3_Handler_TIM2 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{capture compare channel 4,2}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER CC4_Handler_TIM2 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{update,3}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM3 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,3}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM3 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 2,3}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC2_Handler_TIM3 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 3,3}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC3_Handler_TIM3 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 4,3}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC4_Handler_TIM3 = NULL;
-
-/** @brief @rv_fp_conv_isr{update,4}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER UPD_Handler_TIM4 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,4}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER CC1_Handler_TIM4 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{capture compare channel 2,4}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER CC2_Handler_TIM4 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{capture compare channel 3,4}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER CC3_Handler_TIM4 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-/** @brief @rv_fp_conv_isr{capture compare channel 4,4}\n
-  * @rv_def_req_device{__STM32F103xB_H or __STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-    /** \cond */
-    #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        static FUNC_POINTER CC4_Handler_TIM4 = NULL;
-    /** \cond */
-    #endif /** \endcond */
-
-        /** \cond */
-        #ifdef __STM32F401xC_H /** \endcond */
-/** @brief @rv_fp_conv_isr{update,5}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM5 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,5}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM5 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 2,5}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC2_Handler_TIM5 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 3,5}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC3_Handler_TIM5 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 4,5}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC4_Handler_TIM5 = NULL;
-
-/** @brief @rv_fp_conv_isr{update,9}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM9 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,9}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM9 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 2,9}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC2_Handler_TIM9 = NULL;
-
-/** @brief @rv_fp_conv_isr{update,10}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM10 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,10}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM10 = NULL;
-
-/** @brief @rv_fp_conv_isr{update,11}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM11 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,11}\n
-  * @rv_def_req_device{__STM32F401xC_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM11 = NULL;
-
-        /** \cond */
-        #elif defined __STM32F030x6_H /** \endcond */
-
-/** @brief @rv_fp_conv_isr{update,14}\n
-  * @rv_def_req_device{__STM32F030x6_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM14 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,14}\n
-  * @rv_def_req_device{__STM32F030x6_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM14 = NULL;
-
-/** @brief @rv_fp_conv_isr{update,16}\n
-  * @rv_def_req_device{__STM32F030x6_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM16 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,16}\n
-  * @rv_def_req_device{__STM32F030x6_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM16 = NULL;
-
-/** @brief @rv_fp_conv_isr{break,17}\n
-  * @rv_def_req_device{__STM32F030x6_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER BRK_Handler_TIM17 = NULL;
-
-/** @brief @rv_fp_conv_isr{update,17}\n
-  * @rv_def_req_device{__STM32F030x6_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER UPD_Handler_TIM17 = NULL;
-
-/** @brief @rv_fp_conv_isr{capture compare channel 1,17}\n
-  * @rv_def_req_device{__STM32F030x6_H}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  */
-        static FUNC_POINTER CC1_Handler_TIM17 = NULL;
-
-        /** \cond */
-        #endif
-
-    #else /** \endcond */
+    #ifndef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
 
 /** @brief @rv_fp_plain_isr{Timer 1 Capture Compare}\n
   * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
@@ -516,176 +188,1835 @@ static const uint32_t TimerChannel_CCR[4] =
     offsetof(TIM_TypeDef, CCR4)
 };
 
-/** @brief Returns the base frequency of a timer.
-  * @rv_param_timer
-  * @return Frequency in Hertz.
-  * @details Base frequency is basically the peripheral bus clock prescaled.\n
-  * Timers are driven by the different advanced peripheral bus clocks,
-  * depending on the device and type of the timer, that's configured here
-  * via device specific macro constant checks.\n
-  * Secondly, the bus clock is by default doubled if the peripheral bus
-  * divider is greater than unity, which is also managed in the function
-  * with constants @ref APB1_DIV1 "APB1_DIV1", @ref APB2_DIV1 "APB2_DIV1"
-  * and @ref APB1_DIV1_SINGLE "APB1_DIV1_SINGLE".\n
-  * Finally, the peripheral clock is divided by the prescaler value to get
-  * the clock frequency to be scaled by ARR, in turn, to set frequency and
-  * period.\n\n
-  * \f$Base Frequency = System Clock / (APB Prescaler * (PSC+1)*(ARR+1)) \f$\n
+/** \cond */
+#ifdef HIERODULE_TIM_HANDLE_IRQ
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
+/** @brief Struct that keeps a callback and its context for an interrupt flag.
+  * @details @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
   */
-static uint32_t GetBaseFreq(TIM_TypeDef *Timer)
+typedef struct
+{
+/** @brief Pointer to the callback, NULL if none is assigned.
+  */
+    HIERODULE_TIM_Callback Callback;
+/** @brief Pointer passed as is to the callback.
+  */
+    void *Context;
+/** \cond */
+#if (HIERODULE_TIM_INSTRUMENT == 1) /** \endcond */
+/** @brief Pointer to the statistics attached to the flag, NULL if none.
+  * @details @rv_def_req{HIERODULE_TIM_INSTRUMENT}
+  */
+    HIERODULE_TIM_Stats *Stats;
+/** \cond */
+#endif
+#if (HIERODULE_TIM_DETECT_OVERRUN == 1) /** \endcond */
+/** @brief Number of times the handler has overrun.
+  * @details @rv_def_req{HIERODULE_TIM_DETECT_OVERRUN}
+  */
+    uint32_t Overruns;
+/** @brief Number of times in a row the handler has overrun.
+  * @details @rv_def_req{HIERODULE_TIM_DETECT_OVERRUN}
+  */
+    uint32_t Depth;
+/** \cond */
+#endif /** \endcond */
+} TIM_Slot;
+    /** \cond */
+    #endif
+#endif /** \endcond */
+
+/** @brief Struct that keeps the per-timer state of the module.
+  * @details One descriptor is defined for each timer in
+  * @ref TimerDescriptor "TimerDescriptor", indexed by
+  * @ref HIERODULE_TIM_ID "HIERODULE_TIM_ID".
+  */
+typedef struct
+{
+/** @brief Pointer to the timer peripheral.
+  */
+    TIM_TypeDef *Timer;
+/** @brief Cached kernel clock of the timer, in Hertz.
+  * @details Valid only while @ref ClockCacheValid "ClockCacheValid" is set.
+  */
+    uint32_t KernelClock;
+/** @brief Cached period of the kernel clock of the timer, in nanoseconds,
+  * Q24.
+  * @details Valid only while @ref ClockCacheValid "ClockCacheValid" is set.
+  */
+    uint64_t KernelPeriod_Q24;
+/** @brief ARR value @ref ReloadReciprocal "ReloadReciprocal" was computed
+  * for.
+  */
+    volatile uint32_t CachedReload;
+/** @brief 2^48 / (ARR+1), rounded up, 0 while it's not computed yet.
+  * @details Computed by @ref WriteReload "WriteReload" along with each ARR
+  * value the module writes.
+  */
+    volatile uint64_t ReloadReciprocal;
+/** @brief Interrupt flags of the timer that can have a handler assigned.
+  * @details Bit n stands for bit n of the status register.
+  */
+    uint8_t SlotMask;
+/** \cond */
+#ifdef HIERODULE_TIM_HANDLE_IRQ
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
+/** @brief Callback slots of the timer, indexed by the bit position of their
+  * flags in the status register.
+  * @details Assigned via the HIERODULE_TIM_Assign_Callback_* and
+  * HIERODULE_TIM_Assign_ISR_* routines, performed by @ref Check_IT
+  * "Check_IT".\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+    TIM_Slot Slot[8];
+    /** \cond */
+    #endif
+#endif /** \endcond */
+} TIM_Descriptor;
+
+/** \cond */
+#define SLOTS_1CH   (TIM_SR_UIF | TIM_SR_CC1IF)
+#define SLOTS_2CH   (SLOTS_1CH | TIM_SR_CC2IF)
+#define SLOTS_4CH   (SLOTS_2CH | TIM_SR_CC3IF | TIM_SR_CC4IF)
+#define SLOTS_ADV   (SLOTS_4CH | TIM_SR_BIF)
+#define SLOTS_1CH_N (SLOTS_1CH | TIM_SR_BIF)
+#define SLOTS_CC    (TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF | TIM_SR_CC4IF)
+/** \endcond */
+
+/** @brief Per-timer descriptors, in the order of
+  * @ref HIERODULE_TIM_ID "HIERODULE_TIM_ID".
+  */
+static TIM_Descriptor TimerDescriptor[HIERODULE_TIM_ID_COUNT] =
+{
+/** \cond */
+#ifdef __STM32F030x6_H /** \endcond */
+    { .Timer = TIM1, .SlotMask = SLOTS_ADV },
+    { .Timer = TIM3, .SlotMask = SLOTS_4CH },
+    { .Timer = TIM14, .SlotMask = SLOTS_1CH },
+    { .Timer = TIM16, .SlotMask = SLOTS_1CH },
+    { .Timer = TIM17, .SlotMask = SLOTS_1CH_N }
+/** \cond */
+#elif defined __STM32F103xB_H /** \endcond */
+    { .Timer = TIM1, .SlotMask = SLOTS_ADV },
+    { .Timer = TIM2, .SlotMask = SLOTS_4CH },
+    { .Timer = TIM3, .SlotMask = SLOTS_4CH },
+    { .Timer = TIM4, .SlotMask = SLOTS_4CH }
+/** \cond */
+#elif defined __STM32F401xC_H /** \endcond */
+    { .Timer = TIM1, .SlotMask = SLOTS_ADV },
+    { .Timer = TIM2, .SlotMask = SLOTS_4CH },
+    { .Timer = TIM3, .SlotMask = SLOTS_4CH },
+    { .Timer = TIM4, .SlotMask = SLOTS_4CH },
+    { .Timer = TIM5, .SlotMask = SLOTS_4CH },
+    { .Timer = TIM9, .SlotMask = SLOTS_2CH },
+    { .Timer = TIM10, .SlotMask = SLOTS_1CH },
+    { .Timer = TIM11, .SlotMask = SLOTS_1CH }
+/** \cond */
+#endif /** \endcond */
+};
+
+/** @brief Maps the hashed address of a timer to its identifier.
+  * @details The hash is computed in @ref GetTimerID "GetTimerID". Empty
+  * entries hold @ref HIERODULE_TIM_ID_COUNT "HIERODULE_TIM_ID_COUNT".
+  */
+static const uint8_t TimerIDMap[16] =
+{
+/** \cond */
+#ifdef __STM32F030x6_H /** \endcond */
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_3, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_16, HIERODULE_TIM_ID_17, HIERODULE_TIM_ID_14,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_1
+/** \cond */
+#elif defined __STM32F103xB_H /** \endcond */
+    HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_3, HIERODULE_TIM_ID_4,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_1
+/** \cond */
+#elif defined __STM32F401xC_H /** \endcond */
+    HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_3, HIERODULE_TIM_ID_4,
+    HIERODULE_TIM_ID_5, HIERODULE_TIM_ID_1, HIERODULE_TIM_ID_9,
+    HIERODULE_TIM_ID_10, HIERODULE_TIM_ID_11, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT, HIERODULE_TIM_ID_COUNT,
+    HIERODULE_TIM_ID_COUNT
+/** \cond */
+#endif /** \endcond */
+};
+
+/** \cond */
+#define NO_TRG  HIERODULE_TIM_ID_COUNT
+/** \endcond */
+
+/** @brief Maps the internal trigger inputs of each timer to the timers whose
+  * TRGO they're wired to.
+  * @details Indexed by @ref HIERODULE_TIM_ID "HIERODULE_TIM_ID" of the slave
+  * timer, then by ITR. Inputs wired to missing timers or to outputs other
+  * than TRGO, and timers without a slave mode controller, hold
+  * @ref HIERODULE_TIM_ID_COUNT "HIERODULE_TIM_ID_COUNT".
+  */
+static const uint8_t TriggerSource[HIERODULE_TIM_ID_COUNT][4] =
+{
+/** \cond */
+#ifdef __STM32F030x6_H /** \endcond */
+    { NO_TRG, NO_TRG, HIERODULE_TIM_ID_3, NO_TRG },
+    { HIERODULE_TIM_ID_1, NO_TRG, NO_TRG, NO_TRG },
+    { NO_TRG, NO_TRG, NO_TRG, NO_TRG },
+    { NO_TRG, NO_TRG, NO_TRG, NO_TRG },
+    { NO_TRG, NO_TRG, NO_TRG, NO_TRG }
+/** \cond */
+#elif defined __STM32F103xB_H /** \endcond */
+    { NO_TRG, HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_3, HIERODULE_TIM_ID_4 },
+    { HIERODULE_TIM_ID_1, NO_TRG, HIERODULE_TIM_ID_3, HIERODULE_TIM_ID_4 },
+    { HIERODULE_TIM_ID_1, HIERODULE_TIM_ID_2, NO_TRG, HIERODULE_TIM_ID_4 },
+    { HIERODULE_TIM_ID_1, HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_3, NO_TRG }
+/** \cond */
+#elif defined __STM32F401xC_H /** \endcond */
+    { HIERODULE_TIM_ID_5, HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_3,
+        HIERODULE_TIM_ID_4 },
+    { HIERODULE_TIM_ID_1, NO_TRG, HIERODULE_TIM_ID_3, HIERODULE_TIM_ID_4 },
+    { HIERODULE_TIM_ID_1, HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_5,
+        HIERODULE_TIM_ID_4 },
+    { HIERODULE_TIM_ID_1, HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_3, NO_TRG },
+    { HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_3, HIERODULE_TIM_ID_4, NO_TRG },
+    { HIERODULE_TIM_ID_2, HIERODULE_TIM_ID_3, NO_TRG, NO_TRG },
+    { NO_TRG, NO_TRG, NO_TRG, NO_TRG },
+    { NO_TRG, NO_TRG, NO_TRG, NO_TRG }
+/** \cond */
+#endif /** \endcond */
+};
+
+/** \cond */
+#define CAP_GP      (HIERODULE_TIM_CAP_MASTER | HIERODULE_TIM_CAP_SLAVE | \
+                        HIERODULE_TIM_CAP_ENCODER | HIERODULE_TIM_CAP_UPDOWN)
+#define CAP_ADV     (CAP_GP | HIERODULE_TIM_CAP_REPETITION | \
+                        HIERODULE_TIM_CAP_BREAK)
+#define CAP_1CH_N   (HIERODULE_TIM_CAP_REPETITION | HIERODULE_TIM_CAP_BREAK)
+#define DMA_1CH     (HIERODULE_TIM_DMA_UP | HIERODULE_TIM_DMA_CC1)
+#define DMA_3CH     (DMA_1CH | HIERODULE_TIM_DMA_CC2 | HIERODULE_TIM_DMA_CC3)
+#define DMA_4CH     (DMA_3CH | HIERODULE_TIM_DMA_CC4)
+#define DMA_4CH_T   (DMA_4CH | HIERODULE_TIM_DMA_TRIG)
+#define DMA_ADV     (DMA_4CH_T | HIERODULE_TIM_DMA_COM)
+/** \endcond */
+
+/** @brief Capabilities of each timer, in the order of
+  * @ref HIERODULE_TIM_ID "HIERODULE_TIM_ID".
+  * @details Taken from the reference manuals of the devices. DMA requests
+  * are the ones listed in the DMA request mapping of the device.
+  */
+static const HIERODULE_TIM_Capability TimerCapability[HIERODULE_TIM_ID_COUNT] =
+{
+/** \cond */
+#ifdef __STM32F030x6_H /** \endcond */
+    { .Number = 1, .Width = 16, .Channels = 4, .Complementary = 3, .Bus = 1,
+        .Features = CAP_ADV, .DmaRequests = DMA_ADV, .SharedIRQ = 0,
+        .UpdateIRQ = TIM1_BRK_UP_TRG_COM_IRQn, .CaptureIRQ = TIM1_CC_IRQn },
+    { .Number = 3, .Width = 16, .Channels = 4, .Complementary = 0, .Bus = 1,
+        .Features = CAP_GP, .DmaRequests = DMA_4CH_T & ~HIERODULE_TIM_DMA_CC2,
+        .SharedIRQ = 0, .UpdateIRQ = TIM3_IRQn, .CaptureIRQ = TIM3_IRQn },
+    { .Number = 14, .Width = 16, .Channels = 1, .Complementary = 0, .Bus = 1,
+        .Features = 0, .DmaRequests = 0, .SharedIRQ = 0,
+        .UpdateIRQ = TIM14_IRQn, .CaptureIRQ = TIM14_IRQn },
+    { .Number = 16, .Width = 16, .Channels = 1, .Complementary = 1, .Bus = 1,
+        .Features = CAP_1CH_N, .DmaRequests = DMA_1CH, .SharedIRQ = 0,
+        .UpdateIRQ = TIM16_IRQn, .CaptureIRQ = TIM16_IRQn },
+    { .Number = 17, .Width = 16, .Channels = 1, .Complementary = 1, .Bus = 1,
+        .Features = CAP_1CH_N, .DmaRequests = DMA_1CH, .SharedIRQ = 0,
+        .UpdateIRQ = TIM17_IRQn, .CaptureIRQ = TIM17_IRQn }
+/** \cond */
+#elif defined __STM32F103xB_H /** \endcond */
+    { .Number = 1, .Width = 16, .Channels = 4, .Complementary = 3, .Bus = 2,
+        .Features = CAP_ADV, .DmaRequests = DMA_ADV, .SharedIRQ = 0,
+        .UpdateIRQ = TIM1_UP_IRQn, .CaptureIRQ = TIM1_CC_IRQn },
+    { .Number = 2, .Width = 16, .Channels = 4, .Complementary = 0, .Bus = 1,
+        .Features = CAP_GP, .DmaRequests = DMA_4CH, .SharedIRQ = 0,
+        .UpdateIRQ = TIM2_IRQn, .CaptureIRQ = TIM2_IRQn },
+    { .Number = 3, .Width = 16, .Channels = 4, .Complementary = 0, .Bus = 1,
+        .Features = CAP_GP, .DmaRequests = DMA_4CH_T & ~HIERODULE_TIM_DMA_CC2,
+        .SharedIRQ = 0, .UpdateIRQ = TIM3_IRQn, .CaptureIRQ = TIM3_IRQn },
+    { .Number = 4, .Width = 16, .Channels = 4, .Complementary = 0, .Bus = 1,
+        .Features = CAP_GP, .DmaRequests = DMA_3CH, .SharedIRQ = 0,
+        .UpdateIRQ = TIM4_IRQn, .CaptureIRQ = TIM4_IRQn }
+/** \cond */
+#elif defined __STM32F401xC_H /** \endcond */
+    { .Number = 1, .Width = 16, .Channels = 4, .Complementary = 3, .Bus = 2,
+        .Features = CAP_ADV, .DmaRequests = DMA_ADV, .SharedIRQ = 1,
+        .UpdateIRQ = TIM1_UP_TIM10_IRQn, .CaptureIRQ = TIM1_CC_IRQn },
+    { .Number = 2, .Width = 32, .Channels = 4, .Complementary = 0, .Bus = 1,
+        .Features = CAP_GP, .DmaRequests = DMA_4CH, .SharedIRQ = 0,
+        .UpdateIRQ = TIM2_IRQn, .CaptureIRQ = TIM2_IRQn },
+    { .Number = 3, .Width = 16, .Channels = 4, .Complementary = 0, .Bus = 1,
+        .Features = CAP_GP, .DmaRequests = DMA_4CH_T, .SharedIRQ = 0,
+        .UpdateIRQ = TIM3_IRQn, .CaptureIRQ = TIM3_IRQn },
+    { .Number = 4, .Width = 16, .Channels = 4, .Complementary = 0, .Bus = 1,
+        .Features = CAP_GP, .DmaRequests = DMA_3CH, .SharedIRQ = 0,
+        .UpdateIRQ = TIM4_IRQn, .CaptureIRQ = TIM4_IRQn },
+    { .Number = 5, .Width = 32, .Channels = 4, .Complementary = 0, .Bus = 1,
+        .Features = CAP_GP, .DmaRequests = DMA_4CH_T, .SharedIRQ = 0,
+        .UpdateIRQ = TIM5_IRQn, .CaptureIRQ = TIM5_IRQn },
+    { .Number = 9, .Width = 16, .Channels = 2, .Complementary = 0, .Bus = 2,
+        .Features = HIERODULE_TIM_CAP_SLAVE, .DmaRequests = 0, .SharedIRQ = 1,
+        .UpdateIRQ = TIM1_BRK_TIM9_IRQn, .CaptureIRQ = TIM1_BRK_TIM9_IRQn },
+    { .Number = 10, .Width = 16, .Channels = 1, .Complementary = 0, .Bus = 2,
+        .Features = 0, .DmaRequests = 0, .SharedIRQ = 1,
+        .UpdateIRQ = TIM1_UP_TIM10_IRQn, .CaptureIRQ = TIM1_UP_TIM10_IRQn },
+    { .Number = 11, .Width = 16, .Channels = 1, .Complementary = 0, .Bus = 2,
+        .Features = 0, .DmaRequests = 0, .SharedIRQ = 1,
+        .UpdateIRQ = TIM1_TRG_COM_TIM11_IRQn,
+        .CaptureIRQ = TIM1_TRG_COM_TIM11_IRQn }
+/** \cond */
+#endif /** \endcond */
+};
+
+/** @brief Timers allocated via @ref HIERODULE_TIM_Request
+  * "HIERODULE_TIM_Request" or @ref HIERODULE_TIM_Claim "HIERODULE_TIM_Claim".
+  * @details Bit n stands for the timer with identifier n.
+  */
+static uint32_t AllocatedTimers = 0;
+
+/** @brief Switching and low phases of each step of six-step commutation,
+  * channel 1 to 3 being 0 to 2.
+  * @details The switching phase is driven with PWM on its high side, the
+  * low phase with its low side on, and the third phase is off.
+  */
+static const uint8_t SixStep[6][2] =
+{
+    { 0, 1 }, { 0, 2 }, { 1, 2 }, { 1, 0 }, { 2, 0 }, { 2, 1 }
+};
+
+/** \cond */
+#define OCM_PWM1        (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1)
+#define OCM_INACTIVE    TIM_CCMR1_OC1M_2
+#define CCER_E(Index)   (TIM_CCER_CC1E << ((Index) << 2))
+#define CCER_NE(Index)  (TIM_CCER_CC1NE << ((Index) << 2))
+/** \endcond */
+
+/** @brief Set when the kernel clocks in
+  * @ref TimerDescriptor "TimerDescriptor" are up to date.
+  * @details Cleared by @ref HIERODULE_TIM_InvalidateClockCache
+  * "HIERODULE_TIM_InvalidateClockCache", set by
+  * @ref HIERODULE_TIM_RefreshClockCache "HIERODULE_TIM_RefreshClockCache".
+  */
+static uint32_t ClockCacheValid = 0;
+
+/** \cond */
+#ifdef HIERODULE_TIM_HANDLE_IRQ
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #if (HIERODULE_TIM_DETECT_OVERRUN == 1) /** \endcond */
+/** @brief Hook called on handler overruns, NULL if none is assigned.
+  * @details @rv_def_req{HIERODULE_TIM_DETECT_OVERRUN}
+  */
+static HIERODULE_TIM_OverrunHook OverrunHook = NULL;
+        /** \cond */
+        #endif
+    #endif
+#endif /** \endcond */
+
+/** @brief Returns the identifier of a timer.
+  * @rv_param_timer
+  * @return Identifier of the timer, @ref HIERODULE_TIM_ID_COUNT
+  * "HIERODULE_TIM_ID_COUNT" if the timer isn't supported.
+  * @details Timer base addresses are 1 KB apart, so bits 10 and up tell them
+  * apart. Folding bits 14 and up onto them maps every timer of a supported
+  * device to a distinct entry of @ref TimerIDMap "TimerIDMap", which is then
+  * verified against the descriptor to reject foreign addresses.
+  */
+static inline uint32_t GetTimerID(TIM_TypeDef *Timer)
+{
+    uint32_t Address = (uint32_t)Timer;
+    uint32_t ID = TimerIDMap[((Address >> 10) + (Address >> 14)) & 15UL];
+
+    if( (ID == HIERODULE_TIM_ID_COUNT) || (TimerDescriptor[ID].Timer != Timer) )
+    {
+        return HIERODULE_TIM_ID_COUNT;
+    }
+    return ID;
+}
+
+/** @brief Returns the kernel frequency of a timer, the clock its prescaler
+  * is fed with.
+  * @rv_param_timer
+  * @return Frequency in Hertz.
+  * @details Timers are driven by the different advanced peripheral bus clocks,
+  * depending on the device and type of the timer, that's configured here
+  * via device specific macro constant checks.\n
+  * The bus clock is by default doubled if the peripheral bus divider is
+  * greater than unity, which is also managed in the function with constants
+  * @ref APB1_DIV1 "APB1_DIV1", @ref APB2_DIV1 "APB2_DIV1" and
+  * @ref APB1_DIV1_SINGLE "APB1_DIV1_SINGLE".\n\n
+  * \f$Kernel Frequency = System Clock / APB Prescaler \f$ (x2 if the APB
+  * prescaler is not 1)\n
+  */
+static uint32_t GetKernelFreq(TIM_TypeDef *Timer)
 {
-    volatile uint32_t BaseFreq;
+    uint32_t KernelFreq;
+
+    (void)Timer;
+
     /** \cond */
     #ifdef __STM32F103xB_H /** \endcond */
     if(Timer != TIM1)
     {
-        BaseFreq = (SystemCoreClock >>
+        KernelFreq = (SystemCoreClock >>
             APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos]);
 
         if( (READ_REG(RCC->CFGR) & RCC_CFGR_PPRE1) != APB1_DIV1 )
         {
-            BaseFreq *= 2;
+            KernelFreq *= 2;
         }
     }
     else
     {
-        BaseFreq = (SystemCoreClock >>
+        KernelFreq = (SystemCoreClock >>
             APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos]);
 
         if( (READ_REG(RCC->CFGR) & RCC_CFGR_PPRE2) != APB2_DIV1 )
         {
-            BaseFreq *= 2;
+            KernelFreq *= 2;
         }
     }
     /** \cond */
     #elif defined __STM32F401xC_H /** \endcond */
     if(Timer != TIM1 && Timer != TIM9 && Timer != TIM10 && Timer != TIM11)
     {
-        BaseFreq = (SystemCoreClock >>
+        KernelFreq = (SystemCoreClock >>
             APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos]);
 
         if( (READ_REG(RCC->CFGR) & RCC_CFGR_PPRE1) != APB1_DIV1 )
         {
-            BaseFreq *= 2;
+            KernelFreq *= 2;
         }
     }
     else
     {
-        BaseFreq = (SystemCoreClock >> 
+        KernelFreq = (SystemCoreClock >> 
             APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos]);
 
         if( (READ_REG(RCC->CFGR) & RCC_CFGR_PPRE2) != APB2_DIV1 )
         {
-            BaseFreq *= 2;
+            KernelFreq *= 2;
         }
     }
     /** \cond */
     #elif defined __STM32F030x6_H /** \endcond */
-    BaseFreq = (SystemCoreClock >>
+    KernelFreq = (SystemCoreClock >>
         APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE) >> RCC_CFGR_PPRE_Pos]);
 
-    if( (READ_REG(RCC->CFGR) & RCC_CFGR_PPRE) != APB1_DIV1_SINGLE )
+    if( (READ_REG(RCC->CFGR) & RCC_CFGR_PPRE) != APB1_DIV1_SINGLE )
+    {
+        KernelFreq *= 2;
+    }
+    /** \cond */
+    #endif /** \endcond */
+    return KernelFreq;
+}
+
+/** @brief Returns the cached kernel frequency of a timer.
+  * @rv_param_timer
+  * @return Frequency in Hertz.
+  * @details The cache is refreshed first if it's been invalidated. Timers
+  * that don't have a descriptor bypass the cache and get their kernel
+  * frequency derived from RCC via @ref GetKernelFreq "GetKernelFreq".
+  */
+static inline uint32_t GetCachedKernelFreq(TIM_TypeDef *Timer)
+{
+    uint32_t ID = GetTimerID(Timer);
+
+    if(ID == HIERODULE_TIM_ID_COUNT)
+    {
+        return GetKernelFreq(Timer);
+    }
+    if(ClockCacheValid == 0)
+    {
+        HIERODULE_TIM_RefreshClockCache();
+    }
+    return TimerDescriptor[ID].KernelClock;
+}
+
+/** @brief Returns how much more a timer can do than what's required.
+  * @param Capability: Pointer to the capabilities of the timer.
+  * @return Cost, the lower the better.
+  * @details Complementary outputs weigh the most, being the rarest, then a
+  * 32 bit counter, then each channel, then each feature and DMA request.
+  * A shared IRQ vector weighs a little, to break ties in favour of timers
+  * that can be serviced alone.
+  */
+static uint32_t AllocationCost(const HIERODULE_TIM_Capability *Capability)
+{
+    return ((uint32_t)Capability->Complementary << 6) +
+        ((Capability->Width > 16) ? 32UL : 0UL) +
+        ((uint32_t)Capability->Channels << 2) +
+        (uint32_t)__builtin_popcount(Capability->Features) +
+        (uint32_t)__builtin_popcount(Capability->DmaRequests) +
+        Capability->SharedIRQ;
+}
+
+/** @brief Checks whether a timer meets a requirement.
+  * @param Capability: Pointer to the capabilities of the timer.
+  * @param Requirement: Pointer to the requirement.
+  * @return 1 if so, 0 otherwise.
+  * @details @rv_obvious
+  */
+static uint32_t MeetsRequirement(const HIERODULE_TIM_Capability *Capability,
+    const HIERODULE_TIM_Requirement *Requirement)
+{
+    return ( (Capability->Width >= Requirement->Width) &&
+        (Capability->Channels >= Requirement->Channels) &&
+        (Capability->Complementary >= Requirement->Complementary) &&
+        ((Capability->Features & Requirement->Features) ==
+            Requirement->Features) &&
+        ((Capability->DmaRequests & Requirement->DmaRequests) ==
+            Requirement->DmaRequests) &&
+        ((Requirement->ExclusiveIRQ == 0) || (Capability->SharedIRQ == 0)) )
+        ? 1UL : 0UL;
+}
+
+/** @brief Fills in the handle of an allocated timer.
+  * @param ID: Identifier of the timer.
+  * @param Handle: Pointer to the handle to be filled in.
+  * @return None
+  * @details The kernel clock is acquired via @ref GetCachedKernelFreq
+  * "GetCachedKernelFreq".
+  */
+static void FillHandle(uint32_t ID, HIERODULE_TIM_Handle *Handle)
+{
+    Handle->Timer = TimerDescriptor[ID].Timer;
+    Handle->ID = (HIERODULE_TIM_ID)ID;
+    Handle->KernelClock = GetCachedKernelFreq(Handle->Timer);
+    Handle->Capability = &TimerCapability[ID];
+}
+
+/** @brief Checks whether a timer can be allocated.
+  * @param ID: Identifier of the timer.
+  * @return 1 if it's neither allocated nor reserved via
+  * @ref HIERODULE_TIM_RESERVED "HIERODULE_TIM_RESERVED", 0 otherwise.
+  * @details @rv_obvious
+  */
+static inline uint32_t IsFree(uint32_t ID)
+{
+    return ( ((AllocatedTimers & (1UL << ID)) == 0) &&
+        (TimerCapability[ID].Number != HIERODULE_TIM_RESERVED) ) ? 1UL : 0UL;
+}
+
+/** @brief Returns the period of the kernel clock of a timer.
+  * @param KernelFreq: Kernel frequency in Hertz.
+  * @return Period in nanoseconds, Q24, rounded to nearest. 0 if the
+  * frequency is 0.
+  * @details @rv_obvious
+  */
+static inline uint64_t ComputeKernelPeriod(uint32_t KernelFreq)
+{
+    if(KernelFreq == 0)
+    {
+        return 0;
+    }
+    return ((1000000000ULL << 24) + KernelFreq/2) / KernelFreq;
+}
+
+/** @brief Returns the cached period of the kernel clock of a timer.
+  * @rv_param_timer
+  * @return Period in nanoseconds, Q24.
+  * @details Same as @ref GetCachedKernelFreq "GetCachedKernelFreq", except
+  * for timers that don't have a descriptor getting the period computed with
+  * a division.
+  */
+static inline uint64_t GetCachedKernelPeriod(TIM_TypeDef *Timer)
+{
+    uint32_t ID = GetTimerID(Timer);
+
+    if(ID == HIERODULE_TIM_ID_COUNT)
+    {
+        return ComputeKernelPeriod(GetKernelFreq(Timer));
+    }
+    if(ClockCacheValid == 0)
+    {
+        HIERODULE_TIM_RefreshClockCache();
+    }
+    return TimerDescriptor[ID].KernelPeriod_Q24;
+}
+
+/** @brief Returns the reciprocal of the period of a timer, in counts.
+  * @rv_param_timer
+  * @param Reload: ARR value of the timer.
+  * @return 2^48 / (ARR+1), rounded up.
+  * @details The reciprocal precomputed by @ref WriteReload "WriteReload" is
+  * returned as long as it was computed for the ARR value given, so reads
+  * after ARR is set via the module cost no division. The reciprocal is read
+  * before the ARR value it was computed for, so a write that preempts the
+  * read makes them mismatch rather than be torn. ARR values written to the
+  * register directly, and timers that don't have a descriptor, get it
+  * computed on each call, the cache being left to the setters.
+  */
+static uint64_t GetReloadReciprocal(TIM_TypeDef *Timer, uint32_t Reload)
+{
+    uint32_t ID = GetTimerID(Timer);
+    uint64_t Divisor = (uint64_t)Reload + 1;
+    uint64_t Reciprocal;
+
+    if(ID != HIERODULE_TIM_ID_COUNT)
+    {
+        Reciprocal = TimerDescriptor[ID].ReloadReciprocal;
+        if( (TimerDescriptor[ID].CachedReload == Reload) &&
+            (Reciprocal != 0) )
+        {
+            return Reciprocal;
+        }
+    }
+
+    return ((1ULL << 48) + Divisor - 1) / Divisor;
+}
+
+/** @brief Writes the ARR of a timer, precomputing its reciprocal.
+  * @rv_param_timer
+  * @param Reload: ARR value to write.
+  * @return None
+  * @details The reciprocal read by @ref GetReloadReciprocal
+  * "GetReloadReciprocal" is computed and stored along with the ARR value
+  * it's for, with interrupts masked so that no read finds one of them
+  * updated without the other, then the register is written. The division
+  * is spent here, once per change of ARR, rather than on every read.
+  */
+static void WriteReload(TIM_TypeDef *Timer, uint32_t Reload)
+{
+    uint32_t ID = GetTimerID(Timer);
+    uint64_t Divisor = (uint64_t)Reload + 1;
+    uint64_t Reciprocal = ((1ULL << 48) + Divisor - 1) / Divisor;
+    uint32_t Primask;
+
+    if(ID != HIERODULE_TIM_ID_COUNT)
+    {
+        Primask = __get_PRIMASK();
+        __disable_irq();
+        TimerDescriptor[ID].CachedReload = Reload;
+        TimerDescriptor[ID].ReloadReciprocal = Reciprocal;
+        __set_PRIMASK(Primask);
+    }
+    WRITE_REG(Timer->ARR, Reload);
+}
+
+/** @brief Returns the base frequency of a timer.
+  * @rv_param_timer
+  * @return Frequency in Hertz.
+  * @details Base frequency is basically the peripheral bus clock prescaled.
+  * The cached peripheral clock is acquired via @ref GetCachedKernelFreq
+  * "GetCachedKernelFreq" and divided by the prescaler value to get the clock
+  * frequency to be scaled by ARR, in turn, to set frequency and period.\n\n
+  * \f$Base Frequency = System Clock / (APB Prescaler * (PSC+1)*(ARR+1)) \f$\n
+  */
+static uint32_t GetBaseFreq(TIM_TypeDef *Timer)
+{
+    return GetCachedKernelFreq(Timer) / (Timer->PSC+1);
+}
+
+/** @brief Returns the maximum value the counter of a timer can count up to.
+  * @rv_param_timer
+  * @return 0xFFFFFFFF for 32-bit counters, 0xFFFF otherwise.
+  * @details Among the supported devices, only TIM2 and TIM5 of STM32F401xC
+  * have 32-bit counters.
+  */
+static uint32_t GetCounterMax(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+
+    /** \cond */
+    #ifdef __STM32F401xC_H /** \endcond */
+    if( (Timer == TIM2) || (Timer == TIM5) )
+    {
+        return 0xFFFFFFFFUL;
+    }
+    /** \cond */
+    #endif /** \endcond */
+    return 0xFFFFUL;
+}
+
+/** @brief Finds the prescaler and auto-reload divisors whose product is
+  * closest to a clock divider given as a fraction, among a span of
+  * prescaler candidates.
+  * @param Numerator: Numerator of the clock divider.
+  * @param Denominator: Denominator of the clock divider.
+  * @param CounterMax: Maximum value ARR may be set to.
+  * @param Prescaler: Pointer to return the prescaler divisor, PSC+1.
+  * @param Reload: Pointer to return the auto-reload divisor, ARR+1.
+  * @return None
+  * @details The search starts with the smallest prescaler that lets ARR
+  * reach the divider, which yields the highest ARR resolution, and goes on
+  * for @ref HIERODULE_TIM_SOLVER_SPAN "HIERODULE_TIM_SOLVER_SPAN" prescaler
+  * values or until an exact pair is found. For each prescaler, ARR is the
+  * rounded quotient. A pair replaces the best one only if its divider error
+  * is strictly smaller, so ties are resolved in favour of the larger ARR.
+  * The pair returned is the closest of those tried, not necessarily the
+  * closest overall, since the span doesn't cover every prescaler.\n
+  * The divider error is compared scaled by the denominator,
+  * \f$|Numerator - Denominator * (PSC+1) * (ARR+1)|\f$, which keeps the
+  * search within integer arithmetic and is, to first order, proportional
+  * to the frequency error.\n
+  * Dividers out of range are clamped to the slowest or fastest pair,
+  * ARR being kept at 1 at least. Prescalers past the divider itself are
+  * never tried, and the quotients are rounded off their remainders, so
+  * nothing overflows for any 64 bit numerator and denominator.
+  */
+static void SolveDivider
+(
+    uint64_t Numerator,
+    uint64_t Denominator,
+    uint32_t CounterMax,
+    uint32_t *Prescaler,
+    uint64_t *Reload
+)
+{
+    uint64_t ReloadMax = (uint64_t)CounterMax + 1;
+    uint64_t Quotient = Numerator / Denominator;
+    uint64_t First = Quotient / ReloadMax;
+    uint64_t BestError = UINT64_MAX;
+
+    *Prescaler = 1;
+    *Reload = 2;
+
+    if( (Quotient % ReloadMax) || (Numerator % Denominator) )
+    {
+        First++;
+    }
+
+    if(First < 1)
+    {
+        First = 1;
+    }
+    if(First > 65536)
+    {
+        *Prescaler = 65536;
+        *Reload = ReloadMax;
+        return;
+    }
+
+    for(uint32_t P = (uint32_t)First ; (P <= 65536) && (P <= Quotient) &&
+        (P < First + HIERODULE_TIM_SOLVER_SPAN) ; P++)
+    {
+        uint64_t Scale = Denominator * P;
+        uint64_t Truncated = Numerator / Scale;
+        uint64_t Remainder = Numerator % Scale;
+        uint64_t A = Truncated;
+        uint64_t Error;
+
+        if(Remainder >= Scale - Scale/2)
+        {
+            A++;
+        }
+        if(A < 2)
+        {
+            A = 2;
+        }
+        else if(A > ReloadMax)
+        {
+            A = ReloadMax;
+        }
+
+        Error = (A > Truncated) ? (Scale - Remainder)
+            : (Numerator - Scale * A);
+
+        if(Error < BestError)
+        {
+            BestError = Error;
+            *Prescaler = P;
+            *Reload = A;
+
+            if(Error == 0)
+            {
+                break;
+            }
+        }
+    }
+}
+
+/** @brief Finds the internal trigger input of a timer that's wired to the
+  * TRGO of another.
+  * @param Master: Pointer to the timer driving TRGO.
+  * @param Slave: Pointer to the timer to be triggered.
+  * @return Index of the ITR, 4 if there's none.
+  */
+static uint32_t FindTriggerInput(TIM_TypeDef *Master, TIM_TypeDef *Slave)
+{
+    uint32_t MasterID = GetTimerID(Master);
+    uint32_t SlaveID = GetTimerID(Slave);
+    uint32_t Input;
+
+    if( (MasterID == HIERODULE_TIM_ID_COUNT) ||
+        (SlaveID == HIERODULE_TIM_ID_COUNT) )
+    {
+        return 4;
+    }
+
+    for(Input = 0 ; Input < 4 ; Input++)
+    {
+        if(TriggerSource[SlaveID][Input] == MasterID)
+        {
+            break;
+        }
+    }
+    return Input;
+}
+
+/** @brief Latches the prescaler and auto-reload of a stopped timer via a
+  * software update event, without an update interrupt.
+  * @rv_param_timer
+  * @return None
+  * @details URS is held set during the event and restored afterwards. The
+  * counter is cleared by the event.
+  */
+static void LatchStopped(TIM_TypeDef *Timer)
+{
+    uint32_t Source = READ_BIT(Timer->CR1, TIM_CR1_URS);
+
+    SET_BIT(Timer->CR1, TIM_CR1_URS);
+    WRITE_REG(Timer->EGR, TIM_EGR_UG);
+    MODIFY_REG(Timer->CR1, TIM_CR1_URS, Source);
+}
+
+/** @brief Returns the dead time clock of an advanced timer.
+  * @rv_param_timer
+  * @return Frequency in Hertz.
+  * @details The cached kernel clock divided by the clock division of
+  * CR1.CKD, 1, 2 or 4.
+  */
+static uint32_t GetDeadTimeFreq(TIM_TypeDef *Timer)
+{
+    uint32_t Division = READ_BIT(Timer->CR1, TIM_CR1_CKD) >> TIM_CR1_CKD_Pos;
+
+    return GetCachedKernelFreq(Timer) >> ((Division > 2) ? 2 : Division);
+}
+
+/** @brief Encodes a dead time into the DTG field of BDTR.
+  * @param Ticks: Dead time in dead time clocks.
+  * @param Achieved: Pointer to return the encoded dead time in dead time
+  * clocks.
+  * @return DTG value.
+  * @details DTG has four ranges, each with a step of its own:\n
+  * 0 to 127 in steps of 1, DTG[7] being 0,\n
+  * 128 to 254 in steps of 2, DTG[7:6] being 10,\n
+  * 256 to 504 in steps of 8, DTG[7:5] being 110,\n
+  * 512 to 1008 in steps of 16, DTG[7:5] being 111.\n
+  * The dead time is rounded to the step of its range, and clamped to 1008.
+  */
+static uint32_t EncodeDeadTime(uint64_t Ticks, uint32_t *Achieved)
+{
+    uint32_t Multiplier;
+
+    if(Ticks < 128)
+    {
+        *Achieved = (uint32_t)Ticks;
+        return (uint32_t)Ticks;
+    }
+    if(Ticks < 256)
+    {
+        Multiplier = (uint32_t)((Ticks + 1) >> 1);
+        Multiplier = (Multiplier > 127) ? 127 : Multiplier;
+        *Achieved = Multiplier << 1;
+        return 0x80UL | (Multiplier - 64);
+    }
+    if(Ticks < 512)
+    {
+        Multiplier = (uint32_t)((Ticks + 4) >> 3);
+        Multiplier = (Multiplier > 63) ? 63 : Multiplier;
+        *Achieved = Multiplier << 3;
+        return 0xC0UL | (Multiplier - 32);
+    }
+
+    Ticks = (Ticks + 8) >> 4;
+    Multiplier = (Ticks > 63) ? 63 : (uint32_t)Ticks;
+    *Achieved = Multiplier << 4;
+    return 0xE0UL | (Multiplier - 32);
+}
+
+/** @brief Decodes the DTG field of BDTR.
+  * @param Code: DTG value.
+  * @return Dead time in dead time clocks.
+  * @details The inverse of @ref EncodeDeadTime "EncodeDeadTime".
+  */
+static uint32_t DecodeDeadTime(uint32_t Code)
+{
+    if((Code & 0x80UL) == 0)
+    {
+        return Code;
+    }
+    if((Code & 0xC0UL) == 0x80UL)
+    {
+        return (64 + (Code & 0x3FUL)) << 1;
+    }
+    if((Code & 0xE0UL) == 0xC0UL)
+    {
+        return (32 + (Code & 0x1FUL)) << 3;
+    }
+    return (32 + (Code & 0x1FUL)) << 4;
+}
+
+/** @brief Converts a dead time to its DTG value for a timer.
+  * @rv_param_timer
+  * @param DeadTime_ns: Dead time in nanoseconds.
+  * @param Achieved_ns: Pointer to return the encoded dead time in
+  * nanoseconds.
+  * @return DTG value.
+  */
+static uint32_t DeadTimeCode(TIM_TypeDef *Timer, uint32_t DeadTime_ns,
+    uint32_t *Achieved_ns)
+{
+    uint64_t Freq = GetDeadTimeFreq(Timer);
+    uint32_t Achieved;
+    uint32_t Code = EncodeDeadTime(
+        ((uint64_t)DeadTime_ns * Freq + 500000000UL) / 1000000000UL,
+        &Achieved);
+
+    *Achieved_ns = (uint32_t)( ((uint64_t)Achieved * 1000000000UL + Freq/2)
+        / Freq );
+    return Code;
+}
+
+/** @brief Programs a chain of timers for a clock divider given as a
+  * fraction.
+  * @param Chain: Pointer to the chain.
+  * @param Numerator: Numerator of the clock divider.
+  * @param Denominator: Denominator of the clock divider.
+  * @return The clock divider actually achieved.
+  * @details @ref SolveDivider "SolveDivider" is run twice. First, the
+  * divider is split into the master prescaler and a 32 bit reload, taking
+  * the smallest prescaler for the highest resolution. Then, the reload is
+  * split into the master and slave auto-reload divisors, the slave's taking
+  * the place of the prescaler, so the master is given the larger one.\n
+  * The second split is off by no more than half the slave divisor, which is
+  * within about 2^-17 of the reload.
+  */
+static uint64_t ProgramChain
+(
+    HIERODULE_TIM_Chain *Chain,
+    uint64_t Numerator,
+    uint64_t Denominator
+)
+{
+    uint32_t Prescaler;
+    uint64_t Reload;
+    uint32_t Upper;
+    uint64_t Lower;
+
+    SolveDivider(Numerator, Denominator, 0xFFFFFFFFUL, &Prescaler, &Reload);
+    SolveDivider(Reload, 1, 0xFFFFUL, &Upper, &Lower);
+
+    WRITE_REG(Chain->Master->PSC, Prescaler-1);
+    WriteReload(Chain->Master, (uint32_t)(Lower-1));
+    WriteReload(Chain->Slave, Upper-1);
+
+    return (uint64_t)Prescaler * Lower * Upper;
+}
+
+/** @brief Returns the clock divider of a chain of timers.
+  * @param Chain: Pointer to the chain.
+  * @return Product of the master prescaler and the auto-reload divisors of
+  * both timers.
+  */
+static uint64_t GetChainDivider(HIERODULE_TIM_Chain *Chain)
+{
+    return (uint64_t)(READ_REG(Chain->Master->PSC) + 1) *
+        (READ_REG(Chain->Master->ARR) + 1) *
+        (READ_REG(Chain->Slave->ARR) + 1);
+}
+
+/** \cond */
+#define CHAIN_SYNC_CLOCKS   4UL
+/** \endcond */
+
+/** @brief Returns the least master count a chain's counter can be read at.
+  * @param Chain: Pointer to the chain.
+  * @return Master count, no more than the master's ARR.
+  * @details The slave counts an update event of the master a few kernel
+  * clocks after the master wraps, as its trigger input is resynchronized.
+  * Until then, the slave counter lags a master period behind. The count
+  * returned is the first one reached at least CHAIN_SYNC_CLOCKS kernel
+  * clocks after the wrap, which covers that delay.\n
+  * 0 if the master's counter is disabled, since it won't move on.
+  */
+static uint32_t GetChainGuard(HIERODULE_TIM_Chain *Chain)
+{
+    uint32_t Prescaler = READ_REG(Chain->Master->PSC) + 1;
+    uint32_t Guard = (CHAIN_SYNC_CLOCKS + Prescaler - 1) / Prescaler;
+    uint32_t Reload = READ_REG(Chain->Master->ARR);
+
+    if(READ_BIT(Chain->Master->CR1, TIM_CR1_CEN) == 0)
+    {
+        return 0;
+    }
+    return (Guard > Reload) ? Reload : Guard;
+}
+
+/** @brief Returns the pointer to the target channel's capture compare register.
+  * @rv_param_timer
+  * @param ChannelOffset: Offset of the targeted register within the struct.
+  * @return Pointer to the targeted CCR
+  * @details This function is meant to be used with the array @ref TimerChannel_CCR
+  * "TimerChannel_CCR".\n
+  */
+static inline uint32_t *ChannelSelector(TIM_TypeDef *Timer, uint32_t ChannelOffset)
+{
+    return (uint32_t*)((char*)Timer + (size_t)ChannelOffset);
+}
+
+/** @brief Returns the duty cycle of a channel of a timer in Q16, as a
+  * fraction of ARR+1.
+  * @rv_param_timer
+  * @param Channel: Integer to specify the channel, 1 to 4.
+  * @return Duty cycle, 65536 being 100%. 0 if the channel is invalid.
+  * @details The compare value is multiplied by the reciprocal acquired via
+  * @ref GetReloadReciprocal "GetReloadReciprocal" and shifted, there's no
+  * division involved. Compare values above ARR make 100%, so the product
+  * stays within 2^48. Rounding the reciprocal up makes the result exact,
+  * i.e. the floor of the quotient, as long as ARR+1 fits in 16 bits.
+  * Otherwise, it may exceed the floor by 1.
+  */
+static uint32_t GetDutyCycle_Q16(TIM_TypeDef *Timer, uint8_t Channel)
+{
+    uint32_t Reload;
+    uint32_t Compare;
+
+    if( (Channel < 1) || (Channel > 4) )
+    {
+        return 0;
+    }
+
+    Reload = READ_REG(Timer->ARR);
+    Compare = *(ChannelSelector(Timer, TimerChannel_CCR[Channel-1]));
+    if(Compare > Reload)
+    {
+        return 65536UL;
+    }
+    return (uint32_t)(((uint64_t)Compare *
+        GetReloadReciprocal(Timer, Reload)) >> 32);
+}
+
+/** \cond */
+#ifdef HIERODULE_TIM_HANDLE_IRQ
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
+        /** \cond */
+        #if (HIERODULE_TIM_INSTRUMENT == 1) /** \endcond */
+/** @brief Returns the counts from one counter value of a timer to another,
+  * across the reload.\n
+  * @rv_def_req{HIERODULE_TIM_INSTRUMENT}
+  * @rv_param_timer
+  * @param From: Earlier counter value.
+  * @param To: Later counter value.
+  * @return Counts in between, less than a period.
+  * @details On 32 bit timers with ARR at its maximum, ARR + 1 wraps to 0
+  * and the subtraction wraps by itself.
+  */
+        static inline uint32_t CounterDistance(TIM_TypeDef *Timer,
+            uint32_t From, uint32_t To)
+        {
+            uint32_t Distance = To - From;
+
+            if(To < From)
+            {
+                Distance += READ_REG(Timer->ARR) + 1;
+            }
+            return Distance;
+        }
+
+/** @brief Returns the counts since the event that set an interrupt flag of
+  * a timer.\n
+  * @rv_def_req{HIERODULE_TIM_INSTRUMENT}
+  * @rv_param_timer
+  * @param FlagPos: Bit position of the flag in the status register, update
+  * or capture compare.
+  * @return Counts since the event.
+  * @details The update event is where the counter wraps to 0, or to ARR
+  * when counting down. The capture compare event is where the counter meets
+  * the compare register, or in input capture mode, the value captured. Both
+  * hold in edge-aligned mode, for latencies shorter than a period.
+  */
+        static inline uint32_t EventLatency(TIM_TypeDef *Timer,
+            uint32_t FlagPos)
+        {
+            uint32_t Count = READ_REG(Timer->CNT);
+
+            if(FlagPos == TIM_SR_UIF_Pos)
+            {
+                return READ_BIT(Timer->CR1, TIM_CR1_DIR) ?
+                    READ_REG(Timer->ARR) - Count : Count;
+            }
+            return CounterDistance(Timer,
+                READ_REG(*(&Timer->CCR1 + (FlagPos - 1))), Count);
+        }
+
+/** @brief Adds a value to a set of statistics.\n
+  * @rv_def_req{HIERODULE_TIM_INSTRUMENT}
+  * @param Value: Latency or duration.
+  * @param Min: Pointer to the minimum.
+  * @param Max: Pointer to the maximum.
+  * @param Sum: Pointer to the sum.
+  * @param Histogram: Pointer to the histogram.
+  * @return None
+  * @details The bin is the bit length of the value, a single CLZ on cores
+  * that have it.
+  */
+        static inline void Record(uint32_t Value, uint32_t *Min,
+            uint32_t *Max, uint64_t *Sum, uint32_t *Histogram)
+        {
+            uint32_t Bin = 32UL - (uint32_t)__CLZ(Value);
+
+            if(Bin >= HIERODULE_TIM_STATS_BINS)
+            {
+                Bin = HIERODULE_TIM_STATS_BINS - 1;
+            }
+            Histogram[Bin]++;
+            *Sum += Value;
+            if(Value < *Min)
+            {
+                *Min = Value;
+            }
+            if(Value > *Max)
+            {
+                *Max = Value;
+            }
+        }
+
+/** @brief Performs the callback assigned to a flag, measuring the latency
+  * of the event and the duration of the callback.\n
+  * @rv_def_req{HIERODULE_TIM_INSTRUMENT}
+  * @param ID: Identifier of the timer.
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @return None
+  * @details The latency is taken from the counter of the timer first thing.
+  * The duration is taken from the DWT cycle counter on Cortex-M3 and up,
+  * from the counter of the timer otherwise. The break flag has no counter
+  * value to refer to, so only its duration is recorded. The count is
+  * incremented last.
+  */
+        static void PerformMeasured(uint32_t ID, uint32_t FlagPos)
+        {
+            TIM_TypeDef *Timer = TimerDescriptor[ID].Timer;
+            TIM_Slot *Slot = &TimerDescriptor[ID].Slot[FlagPos];
+            HIERODULE_TIM_Stats *Stats = Slot->Stats;
+            uint32_t Latency = 0;
+            uint32_t Start;
+
+            if(FlagPos <= TIM_SR_CC4IF_Pos)
+            {
+                Latency = EventLatency(Timer, FlagPos);
+            }
+            /** \cond */
+            #if (__CORTEX_M >= 3U) /** \endcond */
+            Start = DWT->CYCCNT;
+            /** \cond */
+            #else /** \endcond */
+            Start = READ_REG(Timer->CNT);
+            /** \cond */
+            #endif /** \endcond */
+
+            if(Slot->Callback != NULL)
+            {
+                Slot->Callback(Timer, 1UL << FlagPos, Slot->Context);
+            }
+
+            /** \cond */
+            #if (__CORTEX_M >= 3U) /** \endcond */
+            Start = DWT->CYCCNT - Start;
+            /** \cond */
+            #else /** \endcond */
+            Start = CounterDistance(Timer, Start, READ_REG(Timer->CNT));
+            /** \cond */
+            #endif /** \endcond */
+
+            if(FlagPos <= TIM_SR_CC4IF_Pos)
+            {
+                Record(Latency, &Stats->LatencyMin, &Stats->LatencyMax,
+                    &Stats->LatencySum, Stats->LatencyHistogram);
+            }
+            Record(Start, &Stats->DurationMin, &Stats->DurationMax,
+                &Stats->DurationSum, Stats->DurationHistogram);
+            Stats->Count++;
+        }
+        /** \cond */
+        #endif /** \endcond */
+
+/** @brief Performs the callback assigned to a flag if it's not NULL.\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}
+  * @param ID: Identifier of the timer.
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @return None
+  * @details Goes through @ref PerformMeasured "PerformMeasured" instead if
+  * @ref HIERODULE_TIM_INSTRUMENT "HIERODULE_TIM_INSTRUMENT" is declared as
+  * 1 and the flag has statistics attached.
+  */
+        static inline void Perform_IT(uint32_t ID, uint32_t FlagPos)
+        {
+            TIM_Slot *Slot = &TimerDescriptor[ID].Slot[FlagPos];
+
+            /** \cond */
+            #if (HIERODULE_TIM_INSTRUMENT == 1) /** \endcond */
+            if(Slot->Stats != NULL)
+            {
+                PerformMeasured(ID, FlagPos);
+                return;
+            }
+            /** \cond */
+            #endif /** \endcond */
+            if(Slot->Callback != NULL)
+            {
+                Slot->Callback(TimerDescriptor[ID].Timer, 1UL << FlagPos,
+                    Slot->Context);
+            }
+        }
+
+/** @brief Checks whether an interrupt flag of a timer is set with its
+  * interrupt enabled.\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}
+  * @param ID: Identifier of the timer.
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @return 1 if so, 0 otherwise.
+  * @details Interrupt enable bits share their positions with the flags they
+  * enable, so a single AND of SR and DIER does it.
+  */
+        static inline uint32_t IsPending_IT(uint32_t ID, uint32_t FlagPos)
+        {
+            TIM_TypeDef *Timer = TimerDescriptor[ID].Timer;
+
+            return (READ_REG(Timer->SR) & READ_REG(Timer->DIER)
+                & (1UL << FlagPos)) ? 1UL : 0UL;
+        }
+
+/** @brief Performs a void function assigned via the
+  * HIERODULE_TIM_Assign_ISR_* routines.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: The void function, stored as the context of the slot.
+  * @return None
+  * @details @rv_obvious
+  */
+        static void PlainISR(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+        {
+            (void)Timer;
+            (void)Flags;
+
+            ((FUNC_POINTER)Context)();
+        }
+
+/** @brief Tells whether a flag is to be cleared before its handler.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @param ID: Identifier of the timer.
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @return 1 if so, 0 if it's to be cleared after.
+  * @details Flags serviced by callbacks are always cleared before them.
+  * Flags serviced by void functions assigned via the
+  * HIERODULE_TIM_Assign_ISR_* routines are cleared after them, as they've
+  * always been, unless @ref HIERODULE_TIM_CLEAR_BEFORE_HANDLER
+  * "HIERODULE_TIM_CLEAR_BEFORE_HANDLER" is defined.
+  */
+        static inline uint32_t ClearsFirst(uint32_t ID, uint32_t FlagPos)
+        {
+            /** \cond */
+            #ifdef HIERODULE_TIM_CLEAR_BEFORE_HANDLER /** \endcond */
+            (void)ID;
+            (void)FlagPos;
+
+            return 1;
+            /** \cond */
+            #else /** \endcond */
+            return (TimerDescriptor[ID].Slot[FlagPos].Callback != &PlainISR)
+                ? 1UL : 0UL;
+            /** \cond */
+            #endif /** \endcond */
+        }
+
+        /** \cond */
+        #if (HIERODULE_TIM_DETECT_OVERRUN == 1) /** \endcond */
+/** @brief Checks whether the event of a flag has come again while its
+  * handler was running.\n
+  * @rv_def_req{HIERODULE_TIM_DETECT_OVERRUN}
+  * @rv_param_timer
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @param Entry: Counter value before the handler.
+  * @param Cleared: 1 if the flag was cleared before the handler.
+  * @return 1 if so, 0 otherwise.
+  * @details With the flag cleared before the handler, it's simply checked
+  * again, along with its interrupt enable, so a handler that disables its
+  * own interrupt isn't taken for an overrun. With the flag cleared after
+  * the handler, the flag can't tell, so the counter is checked for having
+  * wrapped instead, which only works for the update flag.
+  */
+        static inline uint32_t IsOverrun(TIM_TypeDef *Timer,
+            uint32_t FlagPos, uint32_t Entry, uint32_t Cleared)
+        {
+            uint32_t Exit;
+
+            if(Cleared != 0)
+            {
+                return (READ_REG(Timer->SR) & READ_REG(Timer->DIER)
+                    & (1UL << FlagPos)) ? 1UL : 0UL;
+            }
+            if(FlagPos != TIM_SR_UIF_Pos)
+            {
+                return 0;
+            }
+            Exit = READ_REG(Timer->CNT);
+            if(READ_BIT(Timer->CR1, TIM_CR1_DIR))
+            {
+                return (Exit > Entry) ? 1UL : 0UL;
+            }
+            return (Exit < Entry) ? 1UL : 0UL;
+        }
+
+/** @brief Counts an overrun of a flag, or ends a run of them.\n
+  * @rv_def_req{HIERODULE_TIM_DETECT_OVERRUN}
+  * @param ID: Identifier of the timer.
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @param Overrun: 1 if the handler has overrun, 0 otherwise.
+  * @return None
+  * @details The depth is the number of overruns in a row, reset by a
+  * handler that finishes in time. The hook, if assigned, is called on each
+  * overrun with the depth.
+  */
+        static inline void RecordOverrun(uint32_t ID, uint32_t FlagPos,
+            uint32_t Overrun)
+        {
+            TIM_Slot *Slot = &TimerDescriptor[ID].Slot[FlagPos];
+
+            if(Overrun == 0)
+            {
+                Slot->Depth = 0;
+                return;
+            }
+            Slot->Depth++;
+            Slot->Overruns++;
+            if(OverrunHook != NULL)
+            {
+                OverrunHook(TimerDescriptor[ID].Timer, 1UL << FlagPos,
+                    Slot->Depth);
+            }
+        }
+        /** \cond */
+        #endif /** \endcond */
+
+/** @brief Performs the callback assigned to a flag if it's not NULL, and
+  * clears the flag.\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}
+  * @param ID: Identifier of the timer.
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @return None
+  * @details The flag is cleared before or after the callback as told by
+  * @ref ClearsFirst "ClearsFirst". Cleared before, the flag getting set
+  * again while the handler is running isn't missed, which the callbacks of
+  * the utility modules rely on, as they raise their own compare events when
+  * a deadline has passed by the time it's programmed. The flag is cleared
+  * with a single write, since status flags are cleared by writing 0 and
+  * writing 1 has no effect. Unlike a read-modify-write, this won't clear
+  * flags that are set meanwhile.\n
+  * The handler is checked for overruns if
+  * @ref HIERODULE_TIM_DETECT_OVERRUN "HIERODULE_TIM_DETECT_OVERRUN" is
+  * declared as 1.
+  */
+        static inline void Service_IT(uint32_t ID, uint32_t FlagPos)
+        {
+            TIM_TypeDef *Timer = TimerDescriptor[ID].Timer;
+            uint32_t Cleared = ClearsFirst(ID, FlagPos);
+            /** \cond */
+            #if (HIERODULE_TIM_DETECT_OVERRUN == 1) /** \endcond */
+            uint32_t Entry = READ_REG(Timer->CNT);
+            /** \cond */
+            #endif /** \endcond */
+
+            if(Cleared != 0)
+            {
+                WRITE_REG(Timer->SR, ~(1UL << FlagPos));
+            }
+
+            Perform_IT(ID, FlagPos);
+
+            /** \cond */
+            #if (HIERODULE_TIM_DETECT_OVERRUN == 1) /** \endcond */
+            RecordOverrun(ID, FlagPos,
+                IsOverrun(Timer, FlagPos, Entry, Cleared));
+            /** \cond */
+            #endif /** \endcond */
+            if(Cleared == 0)
+            {
+                WRITE_REG(Timer->SR, ~(1UL << FlagPos));
+            }
+        }
+
+/** @brief Out of line @ref Service_IT "Service_IT", for the IRQs that
+  * service a single flag per entry.\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}
+  * @param ID: Identifier of the timer.
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @return None
+  * @details @rv_obvious
+  */
+        static void Check_IT(uint32_t ID, uint32_t FlagPos)
+        {
+            Service_IT(ID, FlagPos);
+        }
+
+        /** \cond */
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+/** @brief Returns the bit position of the next flag to be serviced.\n
+  * @rv_def_req{HIERODULE_TIM_DISPATCH_ALL_PENDING}
+  * @param Flags: Pending flags, not 0.
+  * @return Bit position of the lowest or highest set bit, depending on
+  * @ref HIERODULE_TIM_DISPATCH_ORDER "HIERODULE_TIM_DISPATCH_ORDER".
+  * @details Boils down to a single CLZ instruction, and a bit reversal for
+  * the lowest bit, on cores that have them.
+  */
+        static inline uint32_t NextFlag(uint32_t Flags)
+        {
+            /** \cond */
+            #if (HIERODULE_TIM_DISPATCH_ORDER == 1) /** \endcond */
+            return 31UL - (uint32_t)__builtin_clz(Flags);
+            /** \cond */
+            #else /** \endcond */
+            return (uint32_t)__builtin_ctz(Flags);
+            /** \cond */
+            #endif /** \endcond */
+        }
+
+/** @brief Services every pending interrupt flag of a timer within a source
+  * mask.\n
+  * @rv_def_req{HIERODULE_TIM_DISPATCH_ALL_PENDING}
+  * @param ID: Identifier of the timer.
+  * @param SourceMask: Status register mask of the flags wired to the IRQ.
+  * @return None
+  * @details SR and DIER are read only once. Flags in
+  * @ref HIERODULE_TIM_DISPATCH_URGENT "HIERODULE_TIM_DISPATCH_URGENT" are
+  * serviced first, the rest in the order set by
+  * @ref HIERODULE_TIM_DISPATCH_ORDER "HIERODULE_TIM_DISPATCH_ORDER".
+  * Flags that get set after the read are left for the next IRQ entry.
+  */
+        static void Dispatch_IT(uint32_t ID, uint32_t SourceMask)
+        {
+            TIM_TypeDef *Timer = TimerDescriptor[ID].Timer;
+            uint32_t Pending = READ_REG(Timer->SR) & READ_REG(Timer->DIER)
+                & SourceMask;
+            uint32_t Urgent = Pending & (HIERODULE_TIM_DISPATCH_URGENT);
+            uint32_t FlagPos;
+
+            Pending &= ~Urgent;
+            while(Urgent != 0)
+            {
+                FlagPos = NextFlag(Urgent);
+                Urgent &= ~(1UL << FlagPos);
+                Service_IT(ID, FlagPos);
+            }
+            while(Pending != 0)
+            {
+                FlagPos = NextFlag(Pending);
+                Pending &= ~(1UL << FlagPos);
+                Service_IT(ID, FlagPos);
+            }
+        }
+        /** \cond */
+        #endif /** \endcond */
+
+/** @brief @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @return None
+  * @details @rv_obvious
+  */
+        static void InfiniteLoopOfError(void)
+        {
+            while(1);
+        }
+
+/** @brief Assigns a callback and its context to the slot of a timer flag.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @rv_param_cb
+  * @return None
+  * @details Branches to @ref InfiniteLoopOfError "InfiniteLoopOfError" if
+  * the timer isn't supported or doesn't have the flag, as listed in the
+  * slot mask of its descriptor.\n
+  * Both fields are written with interrupts masked, so an interrupt of the
+  * timer never finds the new callback paired with the old context.
+  */
+        static void AssignSlot
+        (
+            TIM_TypeDef *Timer,
+            uint32_t FlagPos,
+            HIERODULE_TIM_Callback Callback,
+            void *Context
+        )
+        {
+            uint32_t ID = GetTimerID(Timer);
+            TIM_Slot *Slot;
+            uint32_t Primask;
+
+            if( (ID == HIERODULE_TIM_ID_COUNT) ||
+                ((TimerDescriptor[ID].SlotMask & (1UL << FlagPos)) == 0) )
+            {
+                InfiniteLoopOfError();
+            }
+            Slot = &TimerDescriptor[ID].Slot[FlagPos];
+
+            Primask = __get_PRIMASK();
+            __disable_irq();
+            Slot->Callback = Callback;
+            Slot->Context = Context;
+            __set_PRIMASK(Primask);
+        }
+
+        /** \cond */
+        #if ( (HIERODULE_TIM_INSTRUMENT == 1) || \
+            (HIERODULE_TIM_DETECT_OVERRUN == 1) ) /** \endcond */
+/** @brief Returns the slot of a timer flag given as a status register
+  * mask.\n
+  * @rv_def_req{HIERODULE_TIM_INSTRUMENT or HIERODULE_TIM_DETECT_OVERRUN}
+  * @rv_param_timer
+  * @param Flag: Status register mask of the flag.
+  * @return Pointer to the slot.
+  * @details Branches to @ref InfiniteLoopOfError "InfiniteLoopOfError" if
+  * the timer isn't supported, or the mask isn't a single flag the timer
+  * has.
+  */
+        static TIM_Slot *FindSlot(TIM_TypeDef *Timer, uint32_t Flag)
+        {
+            uint32_t ID = GetTimerID(Timer);
+
+            if( (ID == HIERODULE_TIM_ID_COUNT) || (Flag == 0) ||
+                ((Flag & (Flag - 1)) != 0) ||
+                ((TimerDescriptor[ID].SlotMask & Flag) == 0) )
+            {
+                InfiniteLoopOfError();
+            }
+            return &TimerDescriptor[ID].Slot[__builtin_ctz(Flag)];
+        }
+        /** \cond */
+        #endif /** \endcond */
+
+/** @brief Assigns a void function to the slot of a timer flag.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  * @rv_param_timer
+  * @param FlagPos: Bit position of the flag in the status register.
+  * @rv_param_fp_isr
+  * @return None
+  * @details The function is stored as the context of
+  * @ref PlainISR "PlainISR" via @ref AssignSlot "AssignSlot".
+  */
+        static void AssignHandler
+        (
+            TIM_TypeDef *Timer,
+            uint32_t FlagPos,
+            FUNC_POINTER ISR
+        )
+        {
+            if(ISR != NULL)
+            {
+                AssignSlot(Timer, FlagPos, &PlainISR, (void*)ISR);
+            }
+            else
+            {
+                AssignSlot(Timer, FlagPos, NULL, NULL);
+            }
+        }
+    /** \cond */
+    #endif
+#endif /** \endcond */
+
+/**
+  * @}
+  */
+
+/** @addtogroup TIM_Public Global
+  * @{
+  */
+
+/** @details @rv_upd_via_psc_arr\n
+  * @rv_cached_kernel_clock\n\n
+  * @rv_frm_period\n
+  * @rv_frm_arr
+  */
+void HIERODULE_TIM_SetPeriod(TIM_TypeDef *Timer, double DurationSec)
+{
+    WriteReload(Timer, (uint32_t)(GetBaseFreq(Timer)*DurationSec-1.0));
+}
+
+/** @details @rv_otf_arr_base_calc{The period}\n
+  * @rv_cached_kernel_clock\n\n
+  * @rv_frm_period\n
+  */
+double HIERODULE_TIM_GetPeriod(TIM_TypeDef *Timer)
+{
+    return ((double)READ_REG(Timer->ARR)+1.0)/((double)GetBaseFreq(Timer));
+}
+
+/** @details @rv_upd_via_psc_arr\n
+  * @rv_cached_kernel_clock\n\n
+  * @rv_frm_freq\n
+  * @rv_frm_arr
+  */
+void HIERODULE_TIM_SetFrequency(TIM_TypeDef *Timer, double Frequency_Hz)
+{
+    WriteReload(Timer, (uint32_t)(GetBaseFreq(Timer)/Frequency_Hz-1.0));
+}
+
+/** @details @rv_otf_arr_base_calc{The frequency}\n
+  * @rv_cached_kernel_clock\n\n
+  * @rv_frm_freq
+  */
+double HIERODULE_TIM_GetFrequency(TIM_TypeDef *Timer)
+{
+    return ((double)GetBaseFreq(Timer))/((double)(READ_REG(Timer->ARR)+1.0));
+}
+
+/** @details The kernel clock of the timer multiplied by the period makes the
+  * clock divider, which @ref SolveDivider "SolveDivider" splits into PSC and
+  * ARR. The new prescaler is latched by the hardware at the next update
+  * event, like the ARR if its preload is enabled.\n
+  * Only integer arithmetic is used, there's no double calculation involved.
+  * If the product of the kernel clock and the period won't fit in 64 bits,
+  * the period is rounded to microseconds first.\n
+  * @rv_cached_kernel_clock\n\n
+  * \f$(PSC+1)*(ARR+1) = Kernel Frequency * Period\f$
+  */
+uint64_t HIERODULE_TIM_SetPeriod_ns(TIM_TypeDef *Timer, uint64_t Period_ns)
+{
+    uint64_t KernelFreq = GetCachedKernelFreq(Timer);
+    uint64_t Numerator;
+    uint64_t Denominator;
+    uint32_t Prescaler;
+    uint64_t Reload;
+    uint64_t Divider;
+
+    if(Period_ns == 0)
+    {
+        return 0;
+    }
+
+    if(Period_ns > (UINT64_MAX / KernelFreq))
+    {
+        Numerator = KernelFreq * ((Period_ns + 500) / 1000);
+        Denominator = 1000000UL;
+    }
+    else
+    {
+        Numerator = KernelFreq * Period_ns;
+        Denominator = 1000000000UL;
+    }
+
+    SolveDivider(Numerator, Denominator, GetCounterMax(Timer),
+        &Prescaler, &Reload);
+
+    WRITE_REG(Timer->PSC, Prescaler-1);
+    WriteReload(Timer, (uint32_t)(Reload-1));
+
+    Divider = (uint64_t)Prescaler * Reload;
+    return (Divider / KernelFreq) * 1000000000UL +
+        ((Divider % KernelFreq) * 1000000000UL + KernelFreq/2) / KernelFreq;
+}
+
+/** @details The kernel clock of the timer divided by the frequency makes the
+  * clock divider, which @ref SolveDivider "SolveDivider" splits into PSC and
+  * ARR. The new prescaler is latched by the hardware at the next update
+  * event, like the ARR if its preload is enabled.\n
+  * Only integer arithmetic is used, there's no double calculation involved.
+  * @rv_cached_kernel_clock\n\n
+  * \f$(PSC+1)*(ARR+1) = Kernel Frequency / Frequency\f$
+  */
+uint64_t HIERODULE_TIM_SetFrequency_mHz(TIM_TypeDef *Timer,
+    uint64_t Frequency_mHz)
+{
+    uint64_t Numerator = (uint64_t)GetCachedKernelFreq(Timer) * 1000;
+    uint32_t Prescaler;
+    uint64_t Reload;
+    uint64_t Divider;
+
+    if(Frequency_mHz == 0)
+    {
+        return 0;
+    }
+
+    SolveDivider(Numerator, Frequency_mHz, GetCounterMax(Timer),
+        &Prescaler, &Reload);
+
+    WRITE_REG(Timer->PSC, Prescaler-1);
+    WriteReload(Timer, (uint32_t)(Reload-1));
+
+    Divider = (uint64_t)Prescaler * Reload;
+    return (Numerator + Divider/2) / Divider;
+}
+
+/** @details Product of the prescaler and ARR, no division involved.
+  */
+uint64_t HIERODULE_TIM_GetPeriod_Ticks(TIM_TypeDef *Timer)
+{
+    return ((uint64_t)READ_REG(Timer->PSC) + 1) *
+        ((uint64_t)READ_REG(Timer->ARR) + 1);
+}
+
+/** @details The period in kernel clocks, acquired via
+  * @ref HIERODULE_TIM_GetPeriod_Ticks "HIERODULE_TIM_GetPeriod_Ticks", is
+  * multiplied by the cached kernel clock period in Q24 nanoseconds, in two
+  * parts split at bit 24 so that neither product overflows, there's no
+  * division involved. The error is below one nanosecond per 2^24 kernel
+  * clocks.
+  */
+uint64_t HIERODULE_TIM_GetPeriod_ns(TIM_TypeDef *Timer)
+{
+    uint64_t Ticks = HIERODULE_TIM_GetPeriod_Ticks(Timer);
+    uint64_t KernelPeriod = GetCachedKernelPeriod(Timer);
+
+    return (Ticks >> 24) * KernelPeriod +
+        (((Ticks & 0xFFFFFFUL) * KernelPeriod + (1UL << 23)) >> 24);
+}
+
+/** @details The kernel clock of each timer in @ref TimerDescriptor
+  * "TimerDescriptor" is derived from RCC via @ref GetKernelFreq
+  * "GetKernelFreq" and stored, along with its period in nanoseconds. Call
+  * this, or @ref HIERODULE_TIM_InvalidateClockCache
+  * "HIERODULE_TIM_InvalidateClockCache", after the system clock or the
+  * peripheral bus prescalers are changed.
+  */
+void HIERODULE_TIM_RefreshClockCache(void)
+{
+    for(uint32_t ID = 0 ; ID < HIERODULE_TIM_ID_COUNT ; ID++)
+    {
+        TimerDescriptor[ID].KernelClock =
+            GetKernelFreq(TimerDescriptor[ID].Timer);
+        TimerDescriptor[ID].KernelPeriod_Q24 =
+            ComputeKernelPeriod(TimerDescriptor[ID].KernelClock);
+    }
+    ClockCacheValid = 1;
+}
+
+/** @details The cache is refreshed lazily, on the next call that needs a
+  * kernel clock.
+  */
+void HIERODULE_TIM_InvalidateClockCache(void)
+{
+    ClockCacheValid = 0;
+}
+
+/** @details @rv_obvious
+  */
+uint32_t HIERODULE_TIM_GetKernelClock(TIM_TypeDef *Timer)
+{
+    return GetCachedKernelFreq(Timer);
+}
+
+/** @details Looked up in @ref TimerCapability "TimerCapability".
+  */
+const HIERODULE_TIM_Capability *HIERODULE_TIM_GetCapability(
+    TIM_TypeDef *Timer)
+{
+    uint32_t ID = GetTimerID(Timer);
+
+    if(ID == HIERODULE_TIM_ID_COUNT)
     {
-        BaseFreq *= 2;
+        return NULL;
     }
-    /** \cond */
-    #endif /** \endcond */
-    BaseFreq /= (Timer->PSC+1);
-    return BaseFreq;
+    return &TimerCapability[ID];
 }
 
-/** @brief Returns the pointer to the target channel's capture compare register.
-  * @rv_param_timer
-  * @param ChannelOffset: Offset of the targeted register within the struct.
-  * @return Pointer to the targeted CCR
-  * @details This function is meant to be used with the array @ref TimerChannel_CCR
-  * "TimerChannel_CCR".\n
+/** @details Of the free timers that meet the requirement, the one with the
+  * lowest @ref AllocationCost "AllocationCost" is allocated, leaving the
+  * more capable timers for later requests. The timer selected by
+  * @ref HIERODULE_TIM_RESERVED "HIERODULE_TIM_RESERVED" is never allocated.
+  * Interrupts are masked while the timer is looked up and marked, so that
+  * requests from different contexts don't collide.
   */
-static inline uint32_t *ChannelSelector(TIM_TypeDef *Timer, uint32_t ChannelOffset)
+uint32_t HIERODULE_TIM_Request(const HIERODULE_TIM_Requirement *Requirement,
+    HIERODULE_TIM_Handle *Handle)
 {
-    return (uint32_t*)((char*)Timer + (size_t)ChannelOffset);
-}
+    uint32_t Mask = __get_PRIMASK();
+    uint32_t Best = HIERODULE_TIM_ID_COUNT;
+    uint32_t BestCost = UINT32_MAX;
+    uint32_t Cost;
+    uint32_t ID;
 
-/** \cond */
-#ifdef HIERODULE_TIM_HANDLE_IRQ
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-/** @brief Performs a routine if it's not NULL, and clears the flag of a timer
-  * as specified with the clear-flag routine.\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}
-  * @rv_param_timer
-  * @param Handler: Pointer to the assigned void function
-  * @param ClearFlag: Pointer to the clear-flag routine
-  * @return None
-  * @details @rv_obvious
-  */
-        static void Check_IT
-        (
-            TIM_TypeDef *Timer,
-            FUNC_POINTER Handler,
-            T2V_Function_Pointer ClearFlag
-        )
+    __disable_irq();
+    for(ID = 0 ; ID < HIERODULE_TIM_ID_COUNT ; ID++)
+    {
+        if( IsFree(ID) &&
+            MeetsRequirement(&TimerCapability[ID], Requirement) )
         {
-            if(Handler != NULL)
+            Cost = AllocationCost(&TimerCapability[ID]);
+            if(Cost < BestCost)
             {
-                 Handler();
+                Best = ID;
+                BestCost = Cost;
             }
-            ClearFlag(Timer);
         }
+    }
+    if(Best != HIERODULE_TIM_ID_COUNT)
+    {
+        AllocatedTimers |= 1UL << Best;
+    }
+    __set_PRIMASK(Mask);
 
-/** @brief @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
-  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
-  * @return None
-  * @details @rv_obvious
-  */
-        static void InfiniteLoopOfError(void)
-        {
-            while(1);
-        }
-    /** \cond */
-    #endif
-#endif /** \endcond */
+    if(Best == HIERODULE_TIM_ID_COUNT)
+    {
+        return 0;
+    }
+    FillHandle(Best, Handle);
+    return 1;
+}
 
-/**
-  * @}
+/** @details Meant for timers that are wired to specific pins, so that
+  * they're kept from @ref HIERODULE_TIM_Request "HIERODULE_TIM_Request" as
+  * well. Interrupts are masked while the timer is checked and marked.
   */
+uint32_t HIERODULE_TIM_Claim(TIM_TypeDef *Timer, HIERODULE_TIM_Handle *Handle)
+{
+    uint32_t Mask = __get_PRIMASK();
+    uint32_t ID = GetTimerID(Timer);
+    uint32_t Free;
 
-/** @addtogroup TIM_Public Global
-  * @{
-  */
+    if(ID == HIERODULE_TIM_ID_COUNT)
+    {
+        return 0;
+    }
 
-/** @details @rv_upd_via_psc_arr\n\n
-  * @rv_frm_period\n
-  * @rv_frm_arr
-  */
-void HIERODULE_TIM_SetPeriod(TIM_TypeDef *Timer, double DurationSec)
-{
-    WRITE_REG(Timer->ARR, GetBaseFreq(Timer)*DurationSec-1.0);
-}
+    __disable_irq();
+    Free = IsFree(ID);
+    if(Free)
+    {
+        AllocatedTimers |= 1UL << ID;
+    }
+    __set_PRIMASK(Mask);
 
-/** @details @rv_otf_arr_base_calc{The period}\n\n
-  * @rv_frm_period\n
-  */
-double HIERODULE_TIM_GetPeriod(TIM_TypeDef *Timer)
-{
-    return ((double)READ_REG(Timer->ARR)+1.0)/((double)GetBaseFreq(Timer));
+    if(Free)
+    {
+        FillHandle(ID, Handle);
+    }
+    return Free;
 }
 
-/** @details @rv_upd_via_psc_arr\n\n
-  * @rv_frm_freq\n
-  * @rv_frm_arr
+/** @details The timer is left running as it is, stop it beforehand if
+  * need be. The handle is cleared.
   */
-void HIERODULE_TIM_SetFrequency(TIM_TypeDef *Timer, double Frequency_Hz)
+void HIERODULE_TIM_Release(HIERODULE_TIM_Handle *Handle)
 {
-    WRITE_REG(Timer->ARR, GetBaseFreq(Timer)/Frequency_Hz-1.0);
-}
+    uint32_t Mask = __get_PRIMASK();
 
-/** @details @rv_otf_arr_base_calc{The frequency}\n\n
-  * @rv_frm_freq
-  */
-double HIERODULE_TIM_GetFrequency(TIM_TypeDef *Timer)
-{
-    return ((double)GetBaseFreq(Timer))/((double)(READ_REG(Timer->ARR)+1.0));
+    if(Handle->Timer == NULL)
+    {
+        return;
+    }
+
+    __disable_irq();
+    AllocatedTimers &= ~(1UL << Handle->ID);
+    __set_PRIMASK(Mask);
+
+    Handle->Timer = NULL;
+    Handle->Capability = NULL;
 }
 
 /** @details @rv_obvious
@@ -819,18 +2150,501 @@ void HIERODULE_TIM_SetDutyCycle
   * @rv_ch_14_avoid_fail
   * @rv_ch_ret_min_1_on_fail
   */
-double HIERODULE_TIM_GetDutyCycle(TIM_TypeDef *Timer, uint8_t Channel)
+double HIERODULE_TIM_GetDutyCycle(TIM_TypeDef *Timer, uint8_t Channel)
+{
+    if( (Channel < 1) && (Channel > 4) )
+    {
+        return -1.0;
+    }
+    else
+    {
+        return
+            ((double)(*(ChannelSelector(Timer, TimerChannel_CCR[Channel-1]))))
+            / ((double)(READ_REG(Timer->ARR)));
+    }
+}
+
+/** @details Acquired via @ref GetDutyCycle_Q16 "GetDutyCycle_Q16" and
+  * halved, there's no division involved.
+  */
+uint32_t HIERODULE_TIM_GetDutyCycle_Q15(TIM_TypeDef *Timer, uint8_t Channel)
+{
+    return GetDutyCycle_Q16(Timer, Channel) >> 1;
+}
+
+/** @details Acquired via @ref GetDutyCycle_Q16 "GetDutyCycle_Q16", there's
+  * no division involved.
+  */
+uint32_t HIERODULE_TIM_GetDutyCycle_Q16_16(TIM_TypeDef *Timer,
+    uint8_t Channel)
+{
+    return GetDutyCycle_Q16(Timer, Channel);
+}
+
+/** @details ARPE is set, along with the OCxPE bits of the channels in the
+  * mask. The compare registers of those channels then take new values only
+  * on update events.
+  */
+void HIERODULE_TIM_EnablePreload(TIM_TypeDef *Timer, uint8_t ChannelMask)
+{
+    SET_BIT(Timer->CR1, TIM_CR1_ARPE);
+    SET_BIT(Timer->CCMR1,
+        ((ChannelMask & 0x01U) ? TIM_CCMR1_OC1PE : 0U) |
+        ((ChannelMask & 0x02U) ? TIM_CCMR1_OC2PE : 0U));
+    SET_BIT(Timer->CCMR2,
+        ((ChannelMask & 0x04U) ? TIM_CCMR2_OC3PE : 0U) |
+        ((ChannelMask & 0x08U) ? TIM_CCMR2_OC4PE : 0U));
+}
+
+/** @details ARPE is cleared, along with the OCxPE bits of the channels in
+  * the mask.
+  */
+void HIERODULE_TIM_DisablePreload(TIM_TypeDef *Timer, uint8_t ChannelMask)
+{
+    CLEAR_BIT(Timer->CR1, TIM_CR1_ARPE);
+    CLEAR_BIT(Timer->CCMR1,
+        ((ChannelMask & 0x01U) ? TIM_CCMR1_OC1PE : 0U) |
+        ((ChannelMask & 0x02U) ? TIM_CCMR1_OC2PE : 0U));
+    CLEAR_BIT(Timer->CCMR2,
+        ((ChannelMask & 0x04U) ? TIM_CCMR2_OC3PE : 0U) |
+        ((ChannelMask & 0x08U) ? TIM_CCMR2_OC4PE : 0U));
+}
+
+/** @details The values are written to the compare registers, the pointers
+  * to which are acquired with calls to @ref ChannelSelector "ChannelSelector".
+  * With the preload enabled via @ref HIERODULE_TIM_EnablePreload
+  * "HIERODULE_TIM_EnablePreload", they're all latched on the next update
+  * event.\n
+  * If @ref HIERODULE_TIM_BATCH_UDIS "HIERODULE_TIM_BATCH_UDIS" is defined,
+  * update events are disabled while the registers are written, so that one
+  * can't land in between.
+  */
+void HIERODULE_TIM_SetCompareBatch(TIM_TypeDef *Timer, uint8_t ChannelMask,
+    const uint32_t *Compare)
+{
+    uint32_t Channel;
+
+    /** \cond */
+    #ifdef HIERODULE_TIM_BATCH_UDIS /** \endcond */
+        SET_BIT(Timer->CR1, TIM_CR1_UDIS);
+    /** \cond */
+    #endif /** \endcond */
+
+    for(Channel = 0 ; Channel < 4 ; Channel++)
+    {
+        if(ChannelMask & (1U << Channel))
+        {
+            (*(ChannelSelector(Timer, TimerChannel_CCR[Channel]))) =
+                Compare[Channel];
+        }
+    }
+
+    /** \cond */
+    #ifdef HIERODULE_TIM_BATCH_UDIS /** \endcond */
+        CLEAR_BIT(Timer->CR1, TIM_CR1_UDIS);
+    /** \cond */
+    #endif /** \endcond */
+}
+
+/** @details Compare values are ARR scaled by the duty cycles, in integer
+  * arithmetic. The product is kept in 32 bits unless ARR exceeds 16 bits.
+  * The values are then committed as in @ref HIERODULE_TIM_SetCompareBatch
+  * "HIERODULE_TIM_SetCompareBatch".
+  */
+void HIERODULE_TIM_SetDutyCycleBatch_Q15(TIM_TypeDef *Timer,
+    uint8_t ChannelMask, const uint16_t *DutyCycle_Q15)
+{
+    uint32_t Compare[4];
+    uint32_t Reload = READ_REG(Timer->ARR);
+    uint32_t Channel;
+
+    for(Channel = 0 ; Channel < 4 ; Channel++)
+    {
+        if(ChannelMask & (1U << Channel))
+        {
+            if(Reload <= 0xFFFFU)
+            {
+                Compare[Channel] = (Reload * DutyCycle_Q15[Channel]) >> 15;
+            }
+            else
+            {
+                Compare[Channel] = (uint32_t)
+                    (((uint64_t)Reload * DutyCycle_Q15[Channel]) >> 15);
+            }
+        }
+    }
+
+    HIERODULE_TIM_SetCompareBatch(Timer, ChannelMask, Compare);
+}
+
+/** @details The master's update event is selected as its TRGO, and the
+  * slave is put in external clock mode 1, clocked by the internal trigger
+  * input wired to the master's TRGO, looked up in
+  * @ref TriggerSource "TriggerSource". Nothing is written if there's no such
+  * input.\n
+  * Both timers are set to wrap at 0xFFFF and the slave prescaler is set to
+  * 1, latched at its next update event. Set the period or the frequency
+  * of the chain afterwards, as the master's prescaler is left as is.\n
+  * Neither counter is enabled, see @ref HIERODULE_TIM_EnableChainCounter
+  * "HIERODULE_TIM_EnableChainCounter".
+  */
+uint32_t HIERODULE_TIM_InitChain(HIERODULE_TIM_Chain *Chain,
+    TIM_TypeDef *Master, TIM_TypeDef *Slave)
+{
+    uint32_t Input = FindTriggerInput(Master, Slave);
+
+    if(Input == 4)
+    {
+        return 0;
+    }
+
+    Chain->Master = Master;
+    Chain->Slave = Slave;
+
+    MODIFY_REG(Master->CR2, TIM_CR2_MMS, TIM_CR2_MMS_1);
+    MODIFY_REG(Slave->SMCR, TIM_SMCR_TS | TIM_SMCR_SMS,
+        (Input << TIM_SMCR_TS_Pos) | TIM_SMCR_SMS);
+    WRITE_REG(Slave->PSC, 0);
+    WriteReload(Master, 0xFFFFUL);
+    WriteReload(Slave, 0xFFFFUL);
+
+    return 1;
+}
+
+/** @details Same as @ref HIERODULE_TIM_SetPeriod_ns
+  * "HIERODULE_TIM_SetPeriod_ns", with the divider split among three
+  * registers by @ref ProgramChain "ProgramChain". Periods up to 2^48 master
+  * kernel clocks can be set, with a resolution of a single kernel clock for
+  * periods up to 2^32 of them.\n\n
+  * \f$(PSC_m+1)*(ARR_m+1)*(ARR_s+1) = Kernel Frequency * Period\f$
+  */
+uint64_t HIERODULE_TIM_SetChainPeriod_ns(HIERODULE_TIM_Chain *Chain,
+    uint64_t Period_ns)
+{
+    uint64_t KernelFreq = GetCachedKernelFreq(Chain->Master);
+    uint64_t Divider;
+
+    if(Period_ns == 0)
+    {
+        return 0;
+    }
+
+    if(Period_ns > (UINT64_MAX / KernelFreq))
+    {
+        Divider = ProgramChain(Chain,
+            KernelFreq * ((Period_ns + 500) / 1000), 1000000UL);
+    }
+    else
+    {
+        Divider = ProgramChain(Chain, KernelFreq * Period_ns, 1000000000UL);
+    }
+
+    return (Divider / KernelFreq) * 1000000000UL +
+        ((Divider % KernelFreq) * 1000000000UL + KernelFreq/2) / KernelFreq;
+}
+
+/** @details The period is derived from the registers, rounded to the
+  * nearest nanosecond.
+  */
+uint64_t HIERODULE_TIM_GetChainPeriod_ns(HIERODULE_TIM_Chain *Chain)
+{
+    uint64_t KernelFreq = GetCachedKernelFreq(Chain->Master);
+    uint64_t Divider = GetChainDivider(Chain);
+
+    return (Divider / KernelFreq) * 1000000000UL +
+        ((Divider % KernelFreq) * 1000000000UL + KernelFreq/2) / KernelFreq;
+}
+
+/** @details Same as @ref HIERODULE_TIM_SetFrequency_mHz
+  * "HIERODULE_TIM_SetFrequency_mHz", with the divider split among three
+  * registers by @ref ProgramChain "ProgramChain".\n\n
+  * \f$(PSC_m+1)*(ARR_m+1)*(ARR_s+1) = Kernel Frequency / Frequency\f$
+  */
+uint64_t HIERODULE_TIM_SetChainFrequency_mHz(HIERODULE_TIM_Chain *Chain,
+    uint64_t Frequency_mHz)
+{
+    uint64_t Numerator = (uint64_t)GetCachedKernelFreq(Chain->Master) * 1000;
+    uint64_t Divider;
+
+    if(Frequency_mHz == 0)
+    {
+        return 0;
+    }
+
+    Divider = ProgramChain(Chain, Numerator, Frequency_mHz);
+    return (Numerator + Divider/2) / Divider;
+}
+
+/** @details The frequency is derived from the registers, rounded to the
+  * nearest millihertz.
+  */
+uint64_t HIERODULE_TIM_GetChainFrequency_mHz(HIERODULE_TIM_Chain *Chain)
+{
+    uint64_t Numerator = (uint64_t)GetCachedKernelFreq(Chain->Master) * 1000;
+    uint64_t Divider = GetChainDivider(Chain);
+
+    return (Numerator + Divider/2) / Divider;
+}
+
+/** @details The high word is read before and after the low word, and the
+  * read is retried if it has changed in between, so a wrap of the master
+  * can't pair a low word with the wrong high word.\n
+  * The slave counter increments a few kernel clocks after the master wraps,
+  * for the trigger to be resynchronized, so the high word may not have
+  * changed yet right after a wrap. The read is also retried while the low
+  * word is below the count given by @ref GetChainGuard "GetChainGuard",
+  * past which the slave is known to have caught up. That holds the read back
+  * by no more than a master count, and only when it lands right after a
+  * wrap.\n
+  * The logical counter counts up to
+  * \f$(ARR_m+1)*(ARR_s+1)-1\f$, then wraps to 0.
+  */
+uint32_t HIERODULE_TIM_GetChainCounter(HIERODULE_TIM_Chain *Chain)
+{
+    uint32_t Guard = GetChainGuard(Chain);
+    uint32_t High;
+    uint32_t Low;
+
+    do
+    {
+        High = READ_REG(Chain->Slave->CNT);
+        Low = READ_REG(Chain->Master->CNT);
+    }
+    while( (High != READ_REG(Chain->Slave->CNT)) || (Low < Guard) );
+
+    return High * (READ_REG(Chain->Master->ARR) + 1) + Low;
+}
+
+/** @details The counters are written directly, no update event is generated
+  * since it would clock the slave.
+  */
+void HIERODULE_TIM_ClearChainCounter(HIERODULE_TIM_Chain *Chain)
+{
+    WRITE_REG(Chain->Master->CNT, 0);
+    WRITE_REG(Chain->Slave->CNT, 0);
+}
+
+/** @details The slave is enabled first, so that it doesn't miss an update
+  * event of the master.
+  */
+void HIERODULE_TIM_EnableChainCounter(HIERODULE_TIM_Chain *Chain)
+{
+    HIERODULE_TIM_EnableCounter(Chain->Slave);
+    HIERODULE_TIM_EnableCounter(Chain->Master);
+}
+
+/** @details The master is disabled first, so that the slave doesn't miss its
+  * last update event.
+  */
+void HIERODULE_TIM_DisableChainCounter(HIERODULE_TIM_Chain *Chain)
+{
+    HIERODULE_TIM_DisableCounter(Chain->Master);
+    HIERODULE_TIM_DisableCounter(Chain->Slave);
+}
+
+/** @details The master's counter enable is selected as its TRGO, and each
+  * member is put in trigger mode on the internal trigger input wired to the
+  * master's TRGO, looked up in @ref TriggerSource "TriggerSource". Every
+  * member is checked before anything is written.\n
+  * A member may be triggered only by timers wired to one of its inputs, see
+  * the timer interconnection tables of the device manual. The master's
+  * TRGO is taken over by the group, so it can't clock a chain at the same
+  * time.
+  */
+uint32_t HIERODULE_TIM_InitGroup(HIERODULE_TIM_Group *Group,
+    TIM_TypeDef *Master, HIERODULE_TIM_GroupMember *Members, uint32_t Count)
+{
+    for(uint32_t Index = 0 ; Index < Count ; Index++)
+    {
+        if(FindTriggerInput(Master, Members[Index].Timer) == 4)
+        {
+            return 0;
+        }
+    }
+
+    Group->Master = Master;
+    Group->Members = Members;
+    Group->Count = Count;
+
+    MODIFY_REG(Master->CR2, TIM_CR2_MMS, TIM_CR2_MMS_0);
+    for(uint32_t Index = 0 ; Index < Count ; Index++)
+    {
+        TIM_TypeDef *Timer = Members[Index].Timer;
+
+        MODIFY_REG(Timer->SMCR, TIM_SMCR_TS | TIM_SMCR_SMS,
+            (FindTriggerInput(Master, Timer) << TIM_SMCR_TS_Pos) |
+            TIM_SMCR_SMS_2 | TIM_SMCR_SMS_1);
+    }
+
+    return 1;
+}
+
+/** @details Meant to be called with every timer of the group stopped.
+  * Prescalers and auto-reloads are latched via software update events
+  * first, without update interrupts. Then, the counter of each member is
+  * loaded with its phase, scaled to its own period, and the master's with
+  * 0.\n
+  * Finally, a single write to the master's control register starts the
+  * master, and every member along with it, in a fixed number of kernel
+  * clocks, regardless of the interrupt load. Members start a couple of
+  * kernel clocks after the master, for the trigger to be resynchronized,
+  * but all of them on the same clock, so the phases among members are
+  * exact.\n
+  * Phases apply to edge-aligned timers counting up; a member ahead in
+  * phase wraps earlier, so it leads.
+  */
+void HIERODULE_TIM_StartGroup(HIERODULE_TIM_Group *Group)
+{
+    LatchStopped(Group->Master);
+
+    for(uint32_t Index = 0 ; Index < Group->Count ; Index++)
+    {
+        TIM_TypeDef *Timer = Group->Members[Index].Timer;
+        uint64_t Reload;
+        uint64_t Count;
+
+        LatchStopped(Timer);
+        Reload = (uint64_t)READ_REG(Timer->ARR) + 1;
+        Count = (Reload * Group->Members[Index].Phase_Q15) >> 15;
+        WRITE_REG(Timer->CNT, (Count < Reload) ? (uint32_t)Count : 0);
+    }
+
+    HIERODULE_TIM_EnableCounter(Group->Master);
+}
+
+/** @details The master is stopped first, then the members, each of which
+  * has its counter enable set by the trigger.
+  */
+void HIERODULE_TIM_StopGroup(HIERODULE_TIM_Group *Group)
+{
+    HIERODULE_TIM_DisableCounter(Group->Master);
+
+    for(uint32_t Index = 0 ; Index < Group->Count ; Index++)
+    {
+        HIERODULE_TIM_DisableCounter(Group->Members[Index].Timer);
+    }
+}
+
+/** @details The dead time is encoded via @ref EncodeDeadTime
+  * "EncodeDeadTime" from the cached kernel clock and the clock division of
+  * the timer, in integer arithmetic. Everything but the main output enable,
+  * which is kept as is, is written to BDTR at once.\n
+  * Write-once bits: once written, a lock level can't be lowered, and the
+  * bits it locks can't be changed, up to the next reset. So configure the
+  * whole thing in a single call, with the clock division set beforehand.
+  * \n
+  * @rv_req_xreg{break and dead time}
+  */
+uint32_t HIERODULE_TIM_ConfigureBridge(TIM_TypeDef *Timer,
+    const HIERODULE_TIM_BridgeConfig *Config)
+{
+    uint32_t Achieved;
+    uint32_t Value = DeadTimeCode(Timer, Config->DeadTime_ns, &Achieved);
+
+    Value |= ((uint32_t)(Config->Lock & 3) << TIM_BDTR_LOCK_Pos);
+    Value |= Config->BreakEnable ? TIM_BDTR_BKE : 0;
+    Value |= Config->BreakActiveHigh ? TIM_BDTR_BKP : 0;
+    Value |= Config->AutomaticOutput ? TIM_BDTR_AOE : 0;
+    Value |= Config->OffStateRun ? TIM_BDTR_OSSR : 0;
+    Value |= Config->OffStateIdle ? TIM_BDTR_OSSI : 0;
+    Value |= READ_BIT(Timer->BDTR, TIM_BDTR_MOE);
+
+    WRITE_REG(Timer->BDTR, Value);
+    return Achieved;
+}
+
+/** @details Same as @ref HIERODULE_TIM_ConfigureBridge
+  * "HIERODULE_TIM_ConfigureBridge" for DTG alone. It takes no effect if
+  * the lock level is 1 or higher.\n
+  * @rv_req_xreg{break and dead time}
+  */
+uint32_t HIERODULE_TIM_SetDeadTime_ns(TIM_TypeDef *Timer,
+    uint32_t DeadTime_ns)
+{
+    uint32_t Achieved;
+
+    MODIFY_REG(Timer->BDTR, TIM_BDTR_DTG,
+        DeadTimeCode(Timer, DeadTime_ns, &Achieved));
+    return Achieved;
+}
+
+/** @details DTG is decoded via @ref DecodeDeadTime "DecodeDeadTime" and
+  * converted to nanoseconds, rounded.\n
+  * @rv_req_xreg{break and dead time}
+  */
+uint32_t HIERODULE_TIM_GetDeadTime_ns(TIM_TypeDef *Timer)
+{
+    uint64_t Freq = GetDeadTimeFreq(Timer);
+    uint64_t Ticks = DecodeDeadTime(READ_BIT(Timer->BDTR, TIM_BDTR_DTG));
+
+    return (uint32_t)( (Ticks * 1000000000UL + Freq/2) / Freq );
+}
+
+/** @details Sets CR2.CCPC, so that the CCxE, CCxNE and OCxM bits are
+  * preloaded, and CR2.CCUS if requested. Once set, writes to those bits
+  * take effect on the next commutation event only, all of them at once.\n
+  * Hall sensor timers may be connected to the trigger input, to commutate
+  * in hardware.
+  */
+void HIERODULE_TIM_EnableCommutationPreload(TIM_TypeDef *Timer,
+    uint8_t OnTrigger)
+{
+    MODIFY_REG(Timer->CR2, TIM_CR2_CCPC | TIM_CR2_CCUS,
+        TIM_CR2_CCPC | (OnTrigger ? TIM_CR2_CCUS : 0));
+}
+
+/** @details @rv_obvious
+  */
+void HIERODULE_TIM_DisableCommutationPreload(TIM_TypeDef *Timer)
+{
+    CLEAR_BIT(Timer->CR2, TIM_CR2_CCPC | TIM_CR2_CCUS);
+}
+
+/** @details The switching phase of the step, looked up in
+  * @ref SixStep "SixStep", is set to PWM mode 1 with its high side output
+  * enabled, and its low side as well if complementary. The low phase is
+  * forced inactive with both outputs enabled, so that its low side is on,
+  * and the third phase has both outputs disabled. The compare values and
+  * the other bits of the channels are left as is.\n
+  * With the commutation preload enabled, none of it takes effect until the
+  * next commutation event, which then switches all three phases at once.
+  * Call it right after each commutation event to prepare the next step.
+  */
+void HIERODULE_TIM_PrepareSixStep(TIM_TypeDef *Timer, uint8_t Step,
+    uint8_t Complementary)
 {
-    if( (Channel < 1) && (Channel > 4) )
+    uint32_t Mode[3] = { OCM_INACTIVE, OCM_INACTIVE, OCM_INACTIVE };
+    uint32_t Switching;
+    uint32_t Low;
+    uint32_t Enable;
+
+    if( (Step < 1) || (Step > 6) )
     {
-        return -1.0;
+        return;
     }
-    else
+
+    Switching = SixStep[Step-1][0];
+    Low = SixStep[Step-1][1];
+
+    Mode[Switching] = OCM_PWM1;
+    Enable = CCER_E(Switching) | CCER_E(Low) | CCER_NE(Low);
+    if(Complementary)
     {
-        return
-            ((double)(*(ChannelSelector(Timer, TimerChannel_CCR[Channel-1]))))
-            / ((double)(READ_REG(Timer->ARR)));
+        Enable |= CCER_NE(Switching);
     }
+
+    MODIFY_REG(Timer->CCMR1, TIM_CCMR1_OC1M | (TIM_CCMR1_OC1M << 8),
+        Mode[0] | (Mode[1] << 8));
+    MODIFY_REG(Timer->CCMR2, TIM_CCMR1_OC1M, Mode[2]);
+    MODIFY_REG(Timer->CCER, CCER_E(0) | CCER_NE(0) | CCER_E(1) | CCER_NE(1)
+        | CCER_E(2) | CCER_NE(2), Enable);
+}
+
+/** @details @rv_obvious
+  */
+void HIERODULE_TIM_GenerateCommutation(TIM_TypeDef *Timer)
+{
+    WRITE_REG(Timer->EGR, TIM_EGR_COMG);
 }
 
 /** @details @rv_clear_tim_it_flag_det{Update}
@@ -1098,263 +2912,219 @@ uint32_t HIERODULE_TIM_IsEnabledCounter(TIM_TypeDef *Timer)
   */
 void HIERODULE_TIM_Assign_ISR_UPD(TIM_TypeDef *Timer, FUNC_POINTER ISR)
 {
-    uint32_t TimerAddress = (uint32_t)Timer;
-
-    switch(TimerAddress)
-    {
-        case ( (uint32_t)TIM1 ):
-            UPD_Handler_TIM1 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM2 ):
-            UPD_Handler_TIM2 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        case ( (uint32_t)TIM3 ):
-            UPD_Handler_TIM3 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM4 ):
-            UPD_Handler_TIM4 = ISR;
-            break;
-        /** \cond */
-        #endif
-        #ifdef __STM32F401xC_H /** \endcond */
-        case ( (uint32_t)TIM5 ):
-            UPD_Handler_TIM5 = ISR;
-            break;
-        case ( (uint32_t)TIM9 ):
-            UPD_Handler_TIM9 = ISR;
-            break;
-        case ( (uint32_t)TIM10 ):
-            UPD_Handler_TIM10 = ISR;
-            break;
-        case ( (uint32_t)TIM11 ):
-            UPD_Handler_TIM11 = ISR;
-            break;
-        /** \cond */
-        #elif defined __STM32F030x6_H /** \endcond */
-        case ( (uint32_t)TIM14 ):
-            UPD_Handler_TIM14 = ISR;
-            break;
-        case ( (uint32_t)TIM16 ):
-            UPD_Handler_TIM16 = ISR;
-            break;
-        case ( (uint32_t)TIM17 ):
-            UPD_Handler_TIM17 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        default:
-            InfiniteLoopOfError();
-    }
+    AssignHandler(Timer, TIM_SR_UIF_Pos, ISR);
 }
 
 /** @details @rv_conv_isr_assign_det{capture compare channel 1}
   */
 void HIERODULE_TIM_Assign_ISR_CC1(TIM_TypeDef *Timer, FUNC_POINTER ISR)
 {
-    uint32_t TimerAddress = (uint32_t)Timer;
-
-    switch(TimerAddress)
-    {
-        case ( (uint32_t)TIM1 ):
-            CC1_Handler_TIM1 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM2 ):
-            CC1_Handler_TIM2 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        case ( (uint32_t)TIM3 ):
-            CC1_Handler_TIM3 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM4 ):
-            CC1_Handler_TIM4 = ISR;
-            break;
-        /** \cond */
-        #endif
-        #ifdef __STM32F401xC_H /** \endcond */
-        case ( (uint32_t)TIM5 ):
-            CC1_Handler_TIM5 = ISR;
-            break;
-        case ( (uint32_t)TIM9 ):
-            CC1_Handler_TIM9 = ISR;
-            break;
-        case ( (uint32_t)TIM10 ):
-            CC1_Handler_TIM10 = ISR;
-            break;
-        case ( (uint32_t)TIM11 ):
-            CC1_Handler_TIM11 = ISR;
-            break;
-        /** \cond */
-        #elif defined __STM32F030x6_H /** \endcond */
-        case ( (uint32_t)TIM14 ):
-            CC1_Handler_TIM14 = ISR;
-            break;
-        case ( (uint32_t)TIM16 ):
-            CC1_Handler_TIM16 = ISR;
-            break;
-        case ( (uint32_t)TIM17 ):
-            CC1_Handler_TIM17 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        default:
-            InfiniteLoopOfError();
-    }
+    AssignHandler(Timer, TIM_SR_CC1IF_Pos, ISR);
 }
 
 /** @details @rv_conv_isr_assign_det{capture compare channel 2}
   */
 void HIERODULE_TIM_Assign_ISR_CC2(TIM_TypeDef *Timer, FUNC_POINTER ISR)
 {
-    uint32_t TimerAddress = (uint32_t)Timer;
-
-    switch(TimerAddress)
-    {
-        case ( (uint32_t)TIM1 ):
-            CC2_Handler_TIM1 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM2 ):
-            CC2_Handler_TIM2 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        case ( (uint32_t)TIM3 ):
-            CC2_Handler_TIM3 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM4 ):
-            CC2_Handler_TIM4 = ISR;
-            break;
-        /** \cond */
-        #endif
-        #ifdef __STM32F401xC_H /** \endcond */
-        case ( (uint32_t)TIM5 ):
-            CC2_Handler_TIM5 = ISR;
-            break;
-        case ( (uint32_t)TIM9 ):
-            CC2_Handler_TIM9 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        default:
-            InfiniteLoopOfError();
-    }
+    AssignHandler(Timer, TIM_SR_CC2IF_Pos, ISR);
 }
 
 /** @details @rv_conv_isr_assign_det{capture compare channel 3}
   */
 void HIERODULE_TIM_Assign_ISR_CC3(TIM_TypeDef *Timer, FUNC_POINTER ISR)
 {
-    uint32_t TimerAddress = (uint32_t)Timer;
-
-    switch(TimerAddress)
-    {
-        case ( (uint32_t)TIM1 ):
-            CC3_Handler_TIM1 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM2 ):
-            CC3_Handler_TIM2 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        case ( (uint32_t)TIM3 ):
-            CC3_Handler_TIM3 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM4 ):
-            CC3_Handler_TIM4 = ISR;
-            break;
-        /** \cond */
-        #endif
-        #ifdef __STM32F401xC_H /** \endcond */
-        case ( (uint32_t)TIM5 ):
-            CC3_Handler_TIM5 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        default:
-            InfiniteLoopOfError();
-    }
+    AssignHandler(Timer, TIM_SR_CC3IF_Pos, ISR);
 }
 
 /** @details @rv_conv_isr_assign_det{capture compare channel 4}
   */
 void HIERODULE_TIM_Assign_ISR_CC4(TIM_TypeDef *Timer, FUNC_POINTER ISR)
 {
-    uint32_t TimerAddress = (uint32_t)Timer;
+    AssignHandler(Timer, TIM_SR_CC4IF_Pos, ISR);
+}
+
+/** @details @rv_conv_isr_assign_det{break}
+  */
+void HIERODULE_TIM_Assign_ISR_BRK(TIM_TypeDef *Timer, FUNC_POINTER ISR)
+{
+    AssignHandler(Timer, TIM_SR_BIF_Pos, ISR);
+}
+
+/** @details @rv_conv_cb_assign_det{update}
+  */
+void HIERODULE_TIM_Assign_Callback_UPD
+(
+    TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback,
+    void *Context
+)
+{
+    AssignSlot(Timer, TIM_SR_UIF_Pos, Callback, Context);
+}
+
+/** @details @rv_conv_cb_assign_det{capture compare channel 1}
+  */
+void HIERODULE_TIM_Assign_Callback_CC1
+(
+    TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback,
+    void *Context
+)
+{
+    AssignSlot(Timer, TIM_SR_CC1IF_Pos, Callback, Context);
+}
+
+/** @details @rv_conv_cb_assign_det{capture compare channel 2}
+  */
+void HIERODULE_TIM_Assign_Callback_CC2
+(
+    TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback,
+    void *Context
+)
+{
+    AssignSlot(Timer, TIM_SR_CC2IF_Pos, Callback, Context);
+}
+
+/** @details @rv_conv_cb_assign_det{capture compare channel 3}
+  */
+void HIERODULE_TIM_Assign_Callback_CC3
+(
+    TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback,
+    void *Context
+)
+{
+    AssignSlot(Timer, TIM_SR_CC3IF_Pos, Callback, Context);
+}
+
+/** @details @rv_conv_cb_assign_det{capture compare channel 4}
+  */
+void HIERODULE_TIM_Assign_Callback_CC4
+(
+    TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback,
+    void *Context
+)
+{
+    AssignSlot(Timer, TIM_SR_CC4IF_Pos, Callback, Context);
+}
+
+/** @details @rv_conv_cb_assign_det{break}
+  */
+void HIERODULE_TIM_Assign_Callback_BRK
+(
+    TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback,
+    void *Context
+)
+{
+    AssignSlot(Timer, TIM_SR_BIF_Pos, Callback, Context);
+}
+
+/** \cond */
+#if (HIERODULE_TIM_INSTRUMENT == 1) /** \endcond */
+/** @details The slot is found via @ref FindSlot "FindSlot". The
+  * statistics are cleared before they're attached. On Cortex-M3 and up,
+  * the DWT cycle counter is enabled as well, for the durations.\n
+  * Measurements are valid in edge-aligned mode, for latencies shorter than
+  * a period of the timer.
+  */
+void HIERODULE_TIM_AttachStats
+(
+    TIM_TypeDef *Timer,
+    uint32_t Flag,
+    HIERODULE_TIM_Stats *Stats
+)
+{
+    TIM_Slot *Slot = FindSlot(Timer, Flag);
 
-    switch(TimerAddress)
+    if(Stats != NULL)
     {
-        case ( (uint32_t)TIM1 ):
-            CC4_Handler_TIM1 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM2 ):
-            CC4_Handler_TIM2 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        case ( (uint32_t)TIM3 ):
-            CC4_Handler_TIM3 = ISR;
-            break;
-        /** \cond */
-        #if ( (defined __STM32F103xB_H) || (defined __STM32F401xC_H) ) /** \endcond */
-        case ( (uint32_t)TIM4 ):
-            CC4_Handler_TIM4 = ISR;
-            break;
+        HIERODULE_TIM_ResetStats(Stats);
         /** \cond */
-        #endif
-        #ifdef __STM32F401xC_H /** \endcond */
-        case ( (uint32_t)TIM5 ):
-            CC4_Handler_TIM5 = ISR;
-            break;
+        #if (__CORTEX_M >= 3U) /** \endcond */
+        SET_BIT(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);
+        SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);
         /** \cond */
         #endif /** \endcond */
-        default:
-            InfiniteLoopOfError();
     }
+    Slot->Stats = Stats;
 }
 
-/** @details @rv_conv_isr_assign_det{break}
+/** @details Interrupts are masked while the fields are cleared, so that
+  * the handler doesn't update half cleared statistics.
   */
-void HIERODULE_TIM_Assign_ISR_BRK(TIM_TypeDef *Timer, FUNC_POINTER ISR)
+void HIERODULE_TIM_ResetStats(HIERODULE_TIM_Stats *Stats)
 {
-    uint32_t TimerAddress = (uint32_t)Timer;
+    uint32_t Mask = __get_PRIMASK();
+    uint32_t Bin;
 
-    switch(TimerAddress)
+    __disable_irq();
+    Stats->Count = 0;
+    Stats->LatencyMin = 0xFFFFFFFF;
+    Stats->LatencyMax = 0;
+    Stats->LatencySum = 0;
+    Stats->DurationMin = 0xFFFFFFFF;
+    Stats->DurationMax = 0;
+    Stats->DurationSum = 0;
+    for(Bin = 0; Bin < HIERODULE_TIM_STATS_BINS; Bin++)
     {
-        case ( (uint32_t)TIM1 ):
-            BRK_Handler_TIM1 = ISR;
-            break;
-        /** \cond */
-        #ifdef __STM32F030x6_H /** \endcond */
-        case ( (uint32_t)TIM17 ):
-            BRK_Handler_TIM17 = ISR;
-            break;
-        /** \cond */
-        #endif /** \endcond */
-        default:
-            InfiniteLoopOfError();
+        Stats->LatencyHistogram[Bin] = 0;
+        Stats->DurationHistogram[Bin] = 0;
     }
+    __set_PRIMASK(Mask);
+}
+
+/** @details The statistics are copied without masking interrupts, and
+  * copied again if the count has changed meanwhile, i.e. the flag was
+  * serviced in the middle of the copy. Meant to be called from a context
+  * the timer IRQ can preempt, otherwise there's no need to retry.
+  */
+void HIERODULE_TIM_ReadStats
+(
+    const HIERODULE_TIM_Stats *Stats,
+    HIERODULE_TIM_Stats *Copy
+)
+{
+    uint32_t Count;
+
+    do
+    {
+        Count = Stats->Count;
+        __DMB();
+        *Copy = *Stats;
+        __DMB();
+    } while(Stats->Count != Count);
+}
+/** \cond */
+#endif /** \endcond */
+
+/** \cond */
+#if (HIERODULE_TIM_DETECT_OVERRUN == 1) /** \endcond */
+/** @details @rv_obvious
+  */
+void HIERODULE_TIM_Assign_OverrunHook(HIERODULE_TIM_OverrunHook Hook)
+{
+    OverrunHook = Hook;
+}
+
+/** @details The slot is found via @ref FindSlot "FindSlot".
+  */
+uint32_t HIERODULE_TIM_GetOverruns(TIM_TypeDef *Timer, uint32_t Flag)
+{
+    return FindSlot(Timer, Flag)->Overruns;
+}
+
+/** @details The depth, the number of overruns in a row, is left alone.
+  */
+void HIERODULE_TIM_ClearOverruns(TIM_TypeDef *Timer, uint32_t Flag)
+{
+    FindSlot(Timer, Flag)->Overruns = 0;
 }
 /** \cond */
+#endif /** \endcond */
+/** \cond */
 #else /** \endcond */
 /** @details @rv_obvious
   */
@@ -1487,7 +3257,7 @@ extern void TIM1_UP_IRQHandler(void)
 {
     /** \cond */
     #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-    Check_IT(TIM1, UPD_Handler_TIM1, &HIERODULE_TIM_ClearFlag_UPD);
+    Check_IT(HIERODULE_TIM_ID_1, TIM_SR_UIF_Pos);
     /** \cond */
     #else /** \endcond */
     TIM1_UP_ISR();
@@ -1510,20 +3280,26 @@ extern void TIM1_UP_IRQHandler(void)
 extern void TIM1_UP_TIM10_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-    if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM1) && HIERODULE_TIM_IsSetFlag_UPD(TIM1))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+    Dispatch_IT(HIERODULE_TIM_ID_1, TIM_SR_UIF);
+    Dispatch_IT(HIERODULE_TIM_ID_10, SLOTS_1CH);
+        /** \cond */
+        #else /** \endcond */
+    if(IsPending_IT(HIERODULE_TIM_ID_1, TIM_SR_UIF_Pos))
     {
-        Check_IT(TIM1, UPD_Handler_TIM1, &HIERODULE_TIM_ClearFlag_UPD);
+        Check_IT(HIERODULE_TIM_ID_1, TIM_SR_UIF_Pos);
     }
-    else if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM10) && HIERODULE_TIM_IsSetFlag_UPD(TIM10))
+    else if(IsPending_IT(HIERODULE_TIM_ID_10, TIM_SR_UIF_Pos))
     {
-        Check_IT(TIM10, UPD_Handler_TIM10, &HIERODULE_TIM_ClearFlag_UPD);
+        Check_IT(HIERODULE_TIM_ID_10, TIM_SR_UIF_Pos);
     }
-    else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM10) && HIERODULE_TIM_IsSetFlag_CC1(TIM10))
+    else if(IsPending_IT(HIERODULE_TIM_ID_10, TIM_SR_CC1IF_Pos))
     {
-        Check_IT(TIM10, CC1_Handler_TIM10, &HIERODULE_TIM_ClearFlag_CC1);
+        Check_IT(HIERODULE_TIM_ID_10, TIM_SR_CC1IF_Pos);
     }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
     TIM1_UP_TIM10_ISR();
     /** \cond */
@@ -1545,24 +3321,29 @@ extern void TIM1_UP_TIM10_IRQHandler(void)
 extern void TIM1_CC_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM1) && HIERODULE_TIM_IsSetFlag_CC1(TIM1))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_1, SLOTS_CC);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_1, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM1, CC1_Handler_TIM1, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_1, TIM_SR_CC1IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC2(TIM1) && HIERODULE_TIM_IsSetFlag_CC2(TIM1))
+        else if(IsPending_IT(HIERODULE_TIM_ID_1, TIM_SR_CC2IF_Pos))
         {
-            Check_IT(TIM1, CC2_Handler_TIM1, &HIERODULE_TIM_ClearFlag_CC2);
+            Check_IT(HIERODULE_TIM_ID_1, TIM_SR_CC2IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC3(TIM1) && HIERODULE_TIM_IsSetFlag_CC3(TIM1))
+        else if(IsPending_IT(HIERODULE_TIM_ID_1, TIM_SR_CC3IF_Pos))
         {
-            Check_IT(TIM1, CC3_Handler_TIM1, &HIERODULE_TIM_ClearFlag_CC3);
+            Check_IT(HIERODULE_TIM_ID_1, TIM_SR_CC3IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC4(TIM1) && HIERODULE_TIM_IsSetFlag_CC4(TIM1))
+        else if(IsPending_IT(HIERODULE_TIM_ID_1, TIM_SR_CC4IF_Pos))
         {
-            Check_IT(TIM1, CC4_Handler_TIM1, &HIERODULE_TIM_ClearFlag_CC4);
+            Check_IT(HIERODULE_TIM_ID_1, TIM_SR_CC4IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM1_CC_ISR();
     /** \cond */
@@ -1586,7 +3367,7 @@ extern void TIM1_BRK_IRQHandler(void)
 {
     /** \cond */
     #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-    Check_IT(TIM1, BRK_Handler_TIM1, &HIERODULE_TIM_ClearFlag_BRK);
+    Check_IT(HIERODULE_TIM_ID_1, TIM_SR_BIF_Pos);
     /** \cond */
     #else /** \endcond */
     TIM1_BRK_ISR();
@@ -1608,24 +3389,30 @@ extern void TIM1_BRK_IRQHandler(void)
 extern void TIM1_BRK_TIM9_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-    if(HIERODULE_TIM_IsEnabled_IT_BRK(TIM1) && HIERODULE_TIM_IsSetFlag_BRK(TIM1))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+    Dispatch_IT(HIERODULE_TIM_ID_1, TIM_SR_BIF);
+    Dispatch_IT(HIERODULE_TIM_ID_9, SLOTS_2CH);
+        /** \cond */
+        #else /** \endcond */
+    if(IsPending_IT(HIERODULE_TIM_ID_1, TIM_SR_BIF_Pos))
     {
-        Check_IT(TIM1, BRK_Handler_TIM1, &HIERODULE_TIM_ClearFlag_BRK);
+        Check_IT(HIERODULE_TIM_ID_1, TIM_SR_BIF_Pos);
     }
-    else if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM9) && HIERODULE_TIM_IsSetFlag_UPD(TIM9))
+    else if(IsPending_IT(HIERODULE_TIM_ID_9, TIM_SR_UIF_Pos))
     {
-        Check_IT(TIM9, UPD_Handler_TIM9, &HIERODULE_TIM_ClearFlag_UPD);
+        Check_IT(HIERODULE_TIM_ID_9, TIM_SR_UIF_Pos);
     }
-    else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM9) && HIERODULE_TIM_IsSetFlag_CC1(TIM9))
+    else if(IsPending_IT(HIERODULE_TIM_ID_9, TIM_SR_CC1IF_Pos))
     {
-        Check_IT(TIM9, CC1_Handler_TIM9, &HIERODULE_TIM_ClearFlag_CC1);
+        Check_IT(HIERODULE_TIM_ID_9, TIM_SR_CC1IF_Pos);
     }
-    else if(HIERODULE_TIM_IsEnabled_IT_CC2(TIM9) && HIERODULE_TIM_IsSetFlag_CC2(TIM9))
+    else if(IsPending_IT(HIERODULE_TIM_ID_9, TIM_SR_CC2IF_Pos))
     {
-        Check_IT(TIM9, CC2_Handler_TIM9, &HIERODULE_TIM_ClearFlag_CC2);
+        Check_IT(HIERODULE_TIM_ID_9, TIM_SR_CC2IF_Pos);
     }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
     TIM1_BRK_TIM9_ISR();
     /** \cond */
@@ -1647,16 +3434,21 @@ extern void TIM1_BRK_TIM9_IRQHandler(void)
 extern void TIM1_BRK_UP_TRG_COM_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-    if(HIERODULE_TIM_IsEnabled_IT_BRK(TIM1) && HIERODULE_TIM_IsSetFlag_BRK(TIM1))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+    Dispatch_IT(HIERODULE_TIM_ID_1, (TIM_SR_BIF | TIM_SR_UIF));
+        /** \cond */
+        #else /** \endcond */
+    if(IsPending_IT(HIERODULE_TIM_ID_1, TIM_SR_BIF_Pos))
     {
-        Check_IT(TIM1, BRK_Handler_TIM1, &HIERODULE_TIM_ClearFlag_BRK);
+        Check_IT(HIERODULE_TIM_ID_1, TIM_SR_BIF_Pos);
     }
-    else if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM1) && HIERODULE_TIM_IsSetFlag_UPD(TIM1))
+    else if(IsPending_IT(HIERODULE_TIM_ID_1, TIM_SR_UIF_Pos))
     {
-        Check_IT(TIM1, UPD_Handler_TIM1, &HIERODULE_TIM_ClearFlag_UPD);
+        Check_IT(HIERODULE_TIM_ID_1, TIM_SR_UIF_Pos);
     }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
     TIM1_BRK_UP_TRG_COM_ISR();
     /** \cond */
@@ -1680,28 +3472,33 @@ extern void TIM1_BRK_UP_TRG_COM_IRQHandler(void)
 extern void TIM2_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM2) && HIERODULE_TIM_IsSetFlag_UPD(TIM2))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_2, SLOTS_4CH);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_2, TIM_SR_UIF_Pos))
         {
-            Check_IT(TIM2, UPD_Handler_TIM2, &HIERODULE_TIM_ClearFlag_UPD);
+            Check_IT(HIERODULE_TIM_ID_2, TIM_SR_UIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM2) && HIERODULE_TIM_IsSetFlag_CC1(TIM2))
+        else if(IsPending_IT(HIERODULE_TIM_ID_2, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM2, CC1_Handler_TIM2, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_2, TIM_SR_CC1IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC2(TIM2) && HIERODULE_TIM_IsSetFlag_CC2(TIM2))
+        else if(IsPending_IT(HIERODULE_TIM_ID_2, TIM_SR_CC2IF_Pos))
         {
-            Check_IT(TIM2, CC2_Handler_TIM2, &HIERODULE_TIM_ClearFlag_CC2);
+            Check_IT(HIERODULE_TIM_ID_2, TIM_SR_CC2IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC3(TIM2) && HIERODULE_TIM_IsSetFlag_CC3(TIM2))
+        else if(IsPending_IT(HIERODULE_TIM_ID_2, TIM_SR_CC3IF_Pos))
         {
-            Check_IT(TIM2, CC3_Handler_TIM2, &HIERODULE_TIM_ClearFlag_CC3);
+            Check_IT(HIERODULE_TIM_ID_2, TIM_SR_CC3IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC4(TIM2) && HIERODULE_TIM_IsSetFlag_CC4(TIM2))
+        else if(IsPending_IT(HIERODULE_TIM_ID_2, TIM_SR_CC4IF_Pos))
         {
-            Check_IT(TIM2, CC4_Handler_TIM2, &HIERODULE_TIM_ClearFlag_CC4);
+            Check_IT(HIERODULE_TIM_ID_2, TIM_SR_CC4IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM2_ISR();
     /** \cond */
@@ -1722,28 +3519,33 @@ extern void TIM2_IRQHandler(void)
 extern void TIM3_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM3) && HIERODULE_TIM_IsSetFlag_UPD(TIM3))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_3, SLOTS_4CH);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_3, TIM_SR_UIF_Pos))
         {
-            Check_IT(TIM3, UPD_Handler_TIM3, &HIERODULE_TIM_ClearFlag_UPD);
+            Check_IT(HIERODULE_TIM_ID_3, TIM_SR_UIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM3) && HIERODULE_TIM_IsSetFlag_CC1(TIM3))
+        else if(IsPending_IT(HIERODULE_TIM_ID_3, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM3, CC1_Handler_TIM3, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_3, TIM_SR_CC1IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC2(TIM3) && HIERODULE_TIM_IsSetFlag_CC2(TIM3))
+        else if(IsPending_IT(HIERODULE_TIM_ID_3, TIM_SR_CC2IF_Pos))
         {
-            Check_IT(TIM3, CC2_Handler_TIM3, &HIERODULE_TIM_ClearFlag_CC2);
+            Check_IT(HIERODULE_TIM_ID_3, TIM_SR_CC2IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC3(TIM3) && HIERODULE_TIM_IsSetFlag_CC3(TIM3))
+        else if(IsPending_IT(HIERODULE_TIM_ID_3, TIM_SR_CC3IF_Pos))
         {
-            Check_IT(TIM3, CC3_Handler_TIM3, &HIERODULE_TIM_ClearFlag_CC3);
+            Check_IT(HIERODULE_TIM_ID_3, TIM_SR_CC3IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC4(TIM3) && HIERODULE_TIM_IsSetFlag_CC4(TIM3))
+        else if(IsPending_IT(HIERODULE_TIM_ID_3, TIM_SR_CC4IF_Pos))
         {
-            Check_IT(TIM3, CC4_Handler_TIM3, &HIERODULE_TIM_ClearFlag_CC4);
+            Check_IT(HIERODULE_TIM_ID_3, TIM_SR_CC4IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM3_ISR();
     /** \cond */
@@ -1766,28 +3568,33 @@ extern void TIM3_IRQHandler(void)
 extern void TIM4_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM4) && HIERODULE_TIM_IsSetFlag_UPD(TIM4))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_4, SLOTS_4CH);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_4, TIM_SR_UIF_Pos))
         {
-            Check_IT(TIM4, UPD_Handler_TIM4, &HIERODULE_TIM_ClearFlag_UPD);
+            Check_IT(HIERODULE_TIM_ID_4, TIM_SR_UIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM4) && HIERODULE_TIM_IsSetFlag_CC1(TIM4))
+        else if(IsPending_IT(HIERODULE_TIM_ID_4, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM4, CC1_Handler_TIM4, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_4, TIM_SR_CC1IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC2(TIM4) && HIERODULE_TIM_IsSetFlag_CC2(TIM4))
+        else if(IsPending_IT(HIERODULE_TIM_ID_4, TIM_SR_CC2IF_Pos))
         {
-            Check_IT(TIM4, CC2_Handler_TIM4, &HIERODULE_TIM_ClearFlag_CC2);
+            Check_IT(HIERODULE_TIM_ID_4, TIM_SR_CC2IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC3(TIM4) && HIERODULE_TIM_IsSetFlag_CC3(TIM4))
+        else if(IsPending_IT(HIERODULE_TIM_ID_4, TIM_SR_CC3IF_Pos))
         {
-            Check_IT(TIM4, CC3_Handler_TIM4, &HIERODULE_TIM_ClearFlag_CC3);
+            Check_IT(HIERODULE_TIM_ID_4, TIM_SR_CC3IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC4(TIM4) && HIERODULE_TIM_IsSetFlag_CC4(TIM4))
+        else if(IsPending_IT(HIERODULE_TIM_ID_4, TIM_SR_CC4IF_Pos))
         {
-            Check_IT(TIM4, CC4_Handler_TIM4, &HIERODULE_TIM_ClearFlag_CC4);
+            Check_IT(HIERODULE_TIM_ID_4, TIM_SR_CC4IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM4_ISR();
     /** \cond */
@@ -1811,28 +3618,33 @@ extern void TIM4_IRQHandler(void)
 extern void TIM5_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM5) && HIERODULE_TIM_IsSetFlag_UPD(TIM5))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_5, SLOTS_4CH);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_5, TIM_SR_UIF_Pos))
         {
-            Check_IT(TIM5, UPD_Handler_TIM5, &HIERODULE_TIM_ClearFlag_UPD);
+            Check_IT(HIERODULE_TIM_ID_5, TIM_SR_UIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM5) && HIERODULE_TIM_IsSetFlag_CC1(TIM5))
+        else if(IsPending_IT(HIERODULE_TIM_ID_5, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM5, CC1_Handler_TIM5, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_5, TIM_SR_CC1IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC2(TIM5) && HIERODULE_TIM_IsSetFlag_CC2(TIM5))
+        else if(IsPending_IT(HIERODULE_TIM_ID_5, TIM_SR_CC2IF_Pos))
         {
-            Check_IT(TIM5, CC2_Handler_TIM5, &HIERODULE_TIM_ClearFlag_CC2);
+            Check_IT(HIERODULE_TIM_ID_5, TIM_SR_CC2IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC3(TIM5) && HIERODULE_TIM_IsSetFlag_CC3(TIM5))
+        else if(IsPending_IT(HIERODULE_TIM_ID_5, TIM_SR_CC3IF_Pos))
         {
-            Check_IT(TIM5, CC3_Handler_TIM5, &HIERODULE_TIM_ClearFlag_CC3);
+            Check_IT(HIERODULE_TIM_ID_5, TIM_SR_CC3IF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC4(TIM5) && HIERODULE_TIM_IsSetFlag_CC4(TIM5))
+        else if(IsPending_IT(HIERODULE_TIM_ID_5, TIM_SR_CC4IF_Pos))
         {
-            Check_IT(TIM5, CC4_Handler_TIM5, &HIERODULE_TIM_ClearFlag_CC4);
+            Check_IT(HIERODULE_TIM_ID_5, TIM_SR_CC4IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM5_ISR();
     /** \cond */
@@ -1853,16 +3665,21 @@ extern void TIM5_IRQHandler(void)
 extern void TIM1_TRG_COM_TIM11_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM11) && HIERODULE_TIM_IsSetFlag_UPD(TIM11))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_11, SLOTS_1CH);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_11, TIM_SR_UIF_Pos))
         {
-            Check_IT(TIM11, UPD_Handler_TIM11, &HIERODULE_TIM_ClearFlag_UPD);
+            Check_IT(HIERODULE_TIM_ID_11, TIM_SR_UIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM11) && HIERODULE_TIM_IsSetFlag_CC1(TIM11))
+        else if(IsPending_IT(HIERODULE_TIM_ID_11, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM11, CC1_Handler_TIM11, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_11, TIM_SR_CC1IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM1_TRG_COM_TIM11_ISR();
     /** \cond */
@@ -1885,16 +3702,21 @@ extern void TIM1_TRG_COM_TIM11_IRQHandler(void)
 extern void TIM14_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM14) && HIERODULE_TIM_IsSetFlag_UPD(TIM14))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_14, SLOTS_1CH);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_14, TIM_SR_UIF_Pos))
         {
-            Check_IT(TIM14, UPD_Handler_TIM14, &HIERODULE_TIM_ClearFlag_UPD);
+            Check_IT(HIERODULE_TIM_ID_14, TIM_SR_UIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM14) && HIERODULE_TIM_IsSetFlag_CC1(TIM14))
+        else if(IsPending_IT(HIERODULE_TIM_ID_14, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM14, CC1_Handler_TIM14, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_14, TIM_SR_CC1IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM14_ISR();
     /** \cond */
@@ -1915,16 +3737,21 @@ extern void TIM14_IRQHandler(void)
 extern void TIM16_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM16) && HIERODULE_TIM_IsSetFlag_UPD(TIM16))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_16, SLOTS_1CH);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_16, TIM_SR_UIF_Pos))
         {
-            Check_IT(TIM16, UPD_Handler_TIM16, &HIERODULE_TIM_ClearFlag_UPD);
+            Check_IT(HIERODULE_TIM_ID_16, TIM_SR_UIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM16) && HIERODULE_TIM_IsSetFlag_CC1(TIM16))
+        else if(IsPending_IT(HIERODULE_TIM_ID_16, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM16, CC1_Handler_TIM16, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_16, TIM_SR_CC1IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM16_ISR();
     /** \cond */
@@ -1945,20 +3772,25 @@ extern void TIM16_IRQHandler(void)
 extern void TIM17_IRQHandler(void)
 {
     /** \cond */
-    #ifdef HIERODULE_TIM_CONVENIENT_IRQ /** \endcond */
-        if(HIERODULE_TIM_IsEnabled_IT_BRK(TIM17) && HIERODULE_TIM_IsSetFlag_BRK(TIM17))
+    #ifdef HIERODULE_TIM_CONVENIENT_IRQ
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING /** \endcond */
+        Dispatch_IT(HIERODULE_TIM_ID_17, SLOTS_1CH_N);
+        /** \cond */
+        #else /** \endcond */
+        if(IsPending_IT(HIERODULE_TIM_ID_17, TIM_SR_BIF_Pos))
         {
-            Check_IT(TIM17, BRK_Handler_TIM17, &HIERODULE_TIM_ClearFlag_BRK);
+            Check_IT(HIERODULE_TIM_ID_17, TIM_SR_BIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_UPD(TIM17) && HIERODULE_TIM_IsSetFlag_UPD(TIM17))
+        else if(IsPending_IT(HIERODULE_TIM_ID_17, TIM_SR_UIF_Pos))
         {
-            Check_IT(TIM17, UPD_Handler_TIM17, &HIERODULE_TIM_ClearFlag_UPD);
+            Check_IT(HIERODULE_TIM_ID_17, TIM_SR_UIF_Pos);
         }
-        else if(HIERODULE_TIM_IsEnabled_IT_CC1(TIM17) && HIERODULE_TIM_IsSetFlag_CC1(TIM17))
+        else if(IsPending_IT(HIERODULE_TIM_ID_17, TIM_SR_CC1IF_Pos))
         {
-            Check_IT(TIM17, CC1_Handler_TIM17, &HIERODULE_TIM_ClearFlag_CC1);
+            Check_IT(HIERODULE_TIM_ID_17, TIM_SR_CC1IF_Pos);
         }
-    /** \cond */
+        /** \cond */
+        #endif
     #else /** \endcond */
         TIM17_ISR();
     /** \cond */
@@ -0,0 +1,200 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tstamp.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the timestamp module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_tstamp.h>
+
+/** @addtogroup Hierodule_Tstamp Timestamp Module
+  * @{
+  */
+
+/** @addtogroup TSTAMP_Private Static
+  * @brief @rv_global_private_brief{are} @rv_corresponds_exc_irqs{source}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the half period counters and the callback that
+  * advances them.
+  * @{
+  */
+
+/** \cond */
+#define COUNT_MASK  0xFFFFUL
+#define HALF_BITS   15
+#define HALF_MASK   ((1UL << HALF_BITS) - 1)
+
+#if HIERODULE_TSTAMP_CHANNEL == 1
+#define CC_REG      CCR1
+#define CC_ASSIGN   HIERODULE_TIM_Assign_Callback_CC1
+#define CC_CLEAR    HIERODULE_TIM_ClearFlag_CC1
+#define CC_ENABLE   HIERODULE_TIM_Enable_IT_CC1
+#elif HIERODULE_TSTAMP_CHANNEL == 2
+#define CC_REG      CCR2
+#define CC_ASSIGN   HIERODULE_TIM_Assign_Callback_CC2
+#define CC_CLEAR    HIERODULE_TIM_ClearFlag_CC2
+#define CC_ENABLE   HIERODULE_TIM_Enable_IT_CC2
+#elif HIERODULE_TSTAMP_CHANNEL == 3
+#define CC_REG      CCR3
+#define CC_ASSIGN   HIERODULE_TIM_Assign_Callback_CC3
+#define CC_CLEAR    HIERODULE_TIM_ClearFlag_CC3
+#define CC_ENABLE   HIERODULE_TIM_Enable_IT_CC3
+#elif HIERODULE_TSTAMP_CHANNEL == 4
+#define CC_REG      CCR4
+#define CC_ASSIGN   HIERODULE_TIM_Assign_Callback_CC4
+#define CC_CLEAR    HIERODULE_TIM_ClearFlag_CC4
+#define CC_ENABLE   HIERODULE_TIM_Enable_IT_CC4
+#endif
+/** \endcond */
+
+/** @brief The timer the module runs on.
+  */
+static TIM_TypeDef *HardwareTimer = NULL;
+
+/** @brief Number of half periods of the timer elapsed, lower 32 bits.
+  * @details Advanced on the update event, when the counter enters its lower
+  * half, and on the compare event, when it enters its upper half. So the
+  * value is even while the counter is in its lower half and odd otherwise,
+  * unless the interrupt of the last event is yet to be serviced.
+  */
+static volatile uint32_t Halves = 0;
+
+/** @brief Number of times the most significant bit of @ref Halves "Halves"
+  * has toggled.
+  * @details Likewise, the value is even while the most significant bit of
+  * @ref Halves "Halves" is clear, and odd otherwise, unless the update is
+  * yet to be stored. Half of it is the upper 32 bits of the half period
+  * count.
+  */
+static volatile uint32_t Epoch = 0;
+
+/** @brief Update and capture compare callback of the timer.
+  * @rv_param_timer
+  * @param Flags: Status register mask of the flag being serviced.
+  * @param Context: Unused.
+  * @return None
+  * @details Both events advance the half period count by one, the order of
+  * the two stores is what lets the readers make up for one that's pending.
+  */
+static void HalfTick(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    uint32_t Next = Halves + 1;
+
+    (void)Timer;
+    (void)Flags;
+    (void)Context;
+
+    Halves = Next;
+    if( (Next << 1) == 0 )
+    {
+        Epoch = Epoch + 1;
+    }
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup TSTAMP_Public Global
+  * @{
+  */
+
+/** @details ARR is set to 0xFFFF, the compare register of the channel
+  * selected by @ref HIERODULE_TSTAMP_CHANNEL "HIERODULE_TSTAMP_CHANNEL" to
+  * 0x8000, and the counter is cleared. The same callback is assigned to the
+  * update and the compare interrupt, and both are enabled.\n
+  * Set the prescaler for the resolution you need and the repetition counter
+  * to 0 beforehand. The counter and the NVIC lines of the timer are left for
+  * the caller to enable.\n
+  * The interrupts should not be kept waiting longer than half a period, that
+  * is 32768 counts, or the timestamps will lose a period.\n
+  * @rv_def_req{HIERODULE_TIM_HANDLE_IRQ}\n
+  * @rv_def_req{HIERODULE_TIM_CONVENIENT_IRQ}
+  */
+void HIERODULE_TSTAMP_Init(TIM_TypeDef *Timer)
+{
+    HardwareTimer = Timer;
+
+    WRITE_REG(Timer->ARR, COUNT_MASK);
+    WRITE_REG(Timer->CC_REG, HALF_MASK + 1);
+    HIERODULE_TIM_ClearCounter(Timer);
+    Halves = 0;
+    Epoch = 0;
+
+    HIERODULE_TIM_Assign_Callback_UPD(Timer, &HalfTick, NULL);
+    CC_ASSIGN(Timer, &HalfTick, NULL);
+    HIERODULE_TIM_ClearFlag_UPD(Timer);
+    CC_CLEAR(Timer);
+    HIERODULE_TIM_Enable_IT_UPD(Timer);
+    CC_ENABLE(Timer);
+}
+
+/** @details The counters are read without masking interrupts, safe to call
+  * from any context. The read is retried if the callback runs in between.\n
+  * Instead of checking the pending flags, the most significant bit of the
+  * counter is compared to the parity of the half period count. A mismatch
+  * means the interrupt of the last event is pending, so one more half period
+  * is added. This also covers readers that preempt the callback itself,
+  * whichever way the flag is cleared.
+  */
+uint64_t HIERODULE_TSTAMP_Get(void)
+{
+    uint32_t High;
+    uint32_t Low;
+    uint32_t Count;
+    uint64_t Total;
+
+    do
+    {
+        High = Epoch;
+        Low = Halves;
+        Count = READ_REG(HardwareTimer->CNT) & COUNT_MASK;
+    }
+    while(Low != Halves);
+
+    High = (High >> 1) + (High & ~(Low >> 31) & 1U);
+    Total = ((uint64_t)High << 32) | Low;
+    Total += (Low ^ (Count >> HALF_BITS)) & 1U;
+
+    return (Total << HALF_BITS) | (Count & HALF_MASK);
+}
+
+/** @details Same as @ref HIERODULE_TSTAMP_Get "HIERODULE_TSTAMP_Get", minus
+  * the upper half.
+  */
+uint32_t HIERODULE_TSTAMP_Get32(void)
+{
+    uint32_t Low;
+    uint32_t Count;
+
+    do
+    {
+        Low = Halves;
+        Count = READ_REG(HardwareTimer->CNT) & COUNT_MASK;
+    }
+    while(Low != Halves);
+
+    Low += (Low ^ (Count >> HALF_BITS)) & 1U;
+
+    return (Low << HALF_BITS) | (Count & HALF_MASK);
+}
+
+/** @details The kernel clock of the timer divided by its prescaler.
+  */
+uint32_t HIERODULE_TSTAMP_GetFrequency(void)
+{
+    return HIERODULE_TIM_GetKernelClock(HardwareTimer) /
+        (READ_REG(HardwareTimer->PSC) + 1);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,273 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_wave.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Source file for the waveform module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <hierodule_wave.h>
+
+/** @addtogroup Hierodule_Wave Waveform Module
+  * @{
+  */
+
+/** @addtogroup WAVE_Private Static
+  * @brief @rv_global_private_brief{are}
+  * @details Consists of definitions for routines declared in the header
+  * file, as well as the quarter sine table.
+  * @{
+  */
+
+/** \cond */
+#define QUARTER     0x40000000UL
+#define STEP_BITS   24
+#define Q31_ONE     0x80000000UL
+#define MAX_TARGET  (0xFFFFULL << 31)
+/** \endcond */
+
+/** @brief Quarter of a sine wave in Q15, in 64 steps plus the peak.
+  * @details Values in between are linearly interpolated, which keeps the
+  * error within 4 counts of Q15, about 0.012% of full scale.
+  */
+static const int16_t QuarterSine[65] =
+{
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602,
+    6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767
+};
+
+/**
+  * @}
+  */
+
+/** @addtogroup WAVE_Public Global
+  * @{
+  */
+
+/** @details The table is refilled half by half, so the frame count should
+  * be even and above 0, and the channel count 1 to 4, with no more than
+  * 65535 values in the table. The stream is left unusable, with 0 frames,
+  * otherwise; starting it does nothing.
+  */
+void HIERODULE_WAVE_Init
+(
+    HIERODULE_WAVE_Stream *Stream,
+    TIM_TypeDef *Timer,
+    const HIERODULE_DMA_Link *Link,
+    uint16_t *Table,
+    uint32_t Frames,
+    uint8_t Channels,
+    HIERODULE_WAVE_Callback Refill,
+    void *Context
+)
+{
+    Stream->Timer = Timer;
+    Stream->Link = *Link;
+    Stream->Table = Table;
+    Stream->Frames = 0;
+    Stream->Channels = Channels;
+    Stream->Refill = Refill;
+    Stream->Context = Context;
+
+    if( (Frames == 0) || (Frames & 1) || (Channels < 1) || (Channels > 4) ||
+        (Frames * Channels > 0xFFFFUL) )
+    {
+        return;
+    }
+
+    Stream->Frames = Frames;
+}
+
+/** @details The DMA burst interface of the timer is pointed at CCR1 with a
+  * burst length of the number of channels, so that each update request
+  * writes a frame to CCR1 onwards through DMAR. The DMA channel is started
+  * in circular mode over the whole table, the preload of the channels is
+  * enabled so that a frame takes effect on the update event after the one
+  * that requested it, and the update DMA request is enabled last.\n
+  * The compare values should be 16 bits each.
+  */
+void HIERODULE_WAVE_Start(HIERODULE_WAVE_Stream *Stream)
+{
+    TIM_TypeDef *Timer = Stream->Timer;
+
+    if(Stream->Frames == 0)
+    {
+        return;
+    }
+
+    WRITE_REG(Timer->DCR,
+        ((offsetof(TIM_TypeDef, CCR1) >> 2) << TIM_DCR_DBA_Pos) |
+        ((uint32_t)(Stream->Channels - 1) << TIM_DCR_DBL_Pos));
+
+    HIERODULE_DMA_StartCircular(&Stream->Link,
+        HIERODULE_DMA_Direction_MEM_TO_PERIPH, &Timer->DMAR, Stream->Table,
+        (uint16_t)(Stream->Frames * Stream->Channels), 2);
+
+    HIERODULE_TIM_EnablePreload(Timer, (1U << Stream->Channels) - 1);
+    SET_BIT(Timer->DIER, TIM_DIER_UDE);
+}
+
+/** @details The update DMA request is disabled before the DMA channel is
+  * stopped. The compare registers keep the last frame.
+  */
+void HIERODULE_WAVE_Stop(HIERODULE_WAVE_Stream *Stream)
+{
+    CLEAR_BIT(Stream->Timer->DIER, TIM_DIER_UDE);
+    HIERODULE_DMA_Stop(&Stream->Link);
+}
+
+/** @details Meant to be called from the IRQ handler of the DMA channel. The
+  * refill callback is performed with the first half of the table on half
+  * transfer, and with the second half on transfer complete, each while the
+  * DMA is sending out the other half. The stream is stopped on a transfer
+  * error.
+  */
+void HIERODULE_WAVE_Service(HIERODULE_WAVE_Stream *Stream)
+{
+    uint32_t Flags = HIERODULE_DMA_FetchFlags(&Stream->Link);
+    uint32_t Half = Stream->Frames >> 1;
+
+    if(Flags & HIERODULE_DMA_FLAG_TE)
+    {
+        HIERODULE_WAVE_Stop(Stream);
+        return;
+    }
+    if(Stream->Refill == NULL)
+    {
+        return;
+    }
+    if(Flags & HIERODULE_DMA_FLAG_HT)
+    {
+        Stream->Refill(Stream, Stream->Table, Half, Stream->Context);
+    }
+    if(Flags & HIERODULE_DMA_FLAG_TC)
+    {
+        Stream->Refill(Stream, Stream->Table + (Half * Stream->Channels),
+            Half, Stream->Context);
+    }
+}
+
+/** @details The phase is folded into the first quarter, where the upper 6
+  * bits select the step and the next 16 bits interpolate towards the next
+  * one.
+  */
+int16_t HIERODULE_WAVE_Sine_Q15(uint32_t Phase)
+{
+    uint32_t Angle = Phase & (QUARTER - 1);
+    uint32_t Step;
+    uint32_t Fraction;
+    int32_t Value;
+
+    if(Phase & QUARTER)
+    {
+        Angle = QUARTER - Angle;
+    }
+    Step = Angle >> STEP_BITS;
+    Fraction = (Angle >> (STEP_BITS - 16)) & 0xFFFFUL;
+
+    Value = QuarterSine[Step];
+    if(Fraction != 0)
+    {
+        Value += ((QuarterSine[Step + 1] - Value) * (int32_t)Fraction) >> 16;
+    }
+
+    return (int16_t)((Phase & (QUARTER << 1)) ? -Value : Value);
+}
+
+/** @details Each compare value is the offset plus the amplitude scaled by
+  * the sine of the phase, which is advanced by the step for every frame.
+  * Feed the returned phase to the next call, e.g. from the refill callback,
+  * to continue the wave without a discontinuity.
+  */
+uint32_t HIERODULE_WAVE_FillSine
+(
+    uint16_t *Table,
+    uint32_t Frames,
+    uint8_t Channels,
+    uint8_t Channel,
+    uint32_t Phase,
+    uint32_t PhaseStep,
+    uint16_t Amplitude,
+    uint16_t Offset
+)
+{
+    Table += Channel - 1;
+    while(Frames > 0)
+    {
+        *Table = (uint16_t)( (int32_t)Offset +
+            (((int32_t)Amplitude * HIERODULE_WAVE_Sine_Q15(Phase)) >> 15) );
+        Table += Channels;
+        Phase += PhaseStep;
+        Frames--;
+    }
+    return Phase;
+}
+
+/** @details The ideal compare value, the duty cycle scaled by the period,
+  * has a whole part and a fraction of a count. The fraction is accumulated
+  * frame by frame, and a frame gets the whole part plus one whenever the
+  * accumulator carries over, the whole part otherwise. So the compare
+  * values averaged over any run of frames are within a count over the
+  * number of frames of the ideal one, which is capped at 0xFFFF. A table
+  * of \f$2^n\f$ frames thus adds \f$n\f$ bits to the duty cycle
+  * resolution, without lowering the PWM frequency, e.g. 64 frames on an ARR
+  * of 359 make for about 14.5 bits.\n
+  * A fixed table repeats every frame count periods, which is the lowest
+  * frequency the dither can ripple at. Feed the returned residue to the
+  * next call, e.g. from the refill callback, to keep the average exact
+  * across refills.\n
+  * Only integer arithmetic is used. Duty cycles over 100% are clamped.
+  */
+uint32_t HIERODULE_WAVE_FillDither
+(
+    uint16_t *Table,
+    uint32_t Frames,
+    uint8_t Channels,
+    uint8_t Channel,
+    uint32_t Residue,
+    uint32_t Duty_Q31,
+    uint32_t Period
+)
+{
+    uint64_t Target;
+    uint64_t Accumulator = Residue & (Q31_ONE - 1);
+
+    if(Duty_Q31 > Q31_ONE)
+    {
+        Duty_Q31 = Q31_ONE;
+    }
+    Target = (uint64_t)Duty_Q31 * Period;
+    if(Target > MAX_TARGET)
+    {
+        Target = MAX_TARGET;
+    }
+
+    Table += Channel - 1;
+    while(Frames > 0)
+    {
+        Accumulator += Target;
+        *Table = (uint16_t)(Accumulator >> 31);
+        Accumulator &= Q31_ONE - 1;
+        Table += Channels;
+        Frames--;
+    }
+    return (uint32_t)Accumulator;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file           : host_clock.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Simulated free running counter for host tests.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HOST_CLOCK_H
+#define __HOST_CLOCK_H
+
+/*
+ * Include after main.h and before the sources under test. Register reads go
+ * through HostRead, which moves the simulated time on each time the counter
+ * of the clocked timer is read, as if the read took that long, and reports
+ * every half period boundary of the 16 bit counter crossed on the way, for
+ * the test to raise or service the interrupts.
+ */
+
+#include <main.h>
+
+/* Timer whose counter is simulated, NULL for none. */
+static TIM_TypeDef *HostClockTimer = NULL;
+
+/* Counts elapsed since the start of the simulation. */
+static uint64_t HostClockTime = 0;
+
+/* Returns the counts a read of the counter takes, set by the test. */
+static uint32_t (*HostClockStep)(void) = NULL;
+
+/* Called with 0 on an update event and 1 on reaching half the period. */
+static void (*HostClockCross)(uint32_t Half) = NULL;
+
+/* Moves the simulated time on, reporting the boundaries crossed. */
+static inline void HostClockAdvance(uint64_t Counts)
+{
+    while(Counts > 0)
+    {
+        uint64_t Boundary = (HostClockTime | 0x7FFFULL) + 1;
+        uint64_t Step = Boundary - HostClockTime;
+
+        if(Step > Counts)
+        {
+            HostClockTime += Counts;
+            break;
+        }
+        HostClockTime = Boundary;
+        Counts -= Step;
+        HostClockTimer->CNT = (uint32_t)(HostClockTime & 0xFFFFU);
+        if(HostClockCross != NULL)
+        {
+            HostClockCross( (uint32_t)((HostClockTime >> 15) & 1U) );
+        }
+    }
+    HostClockTimer->CNT = (uint32_t)(HostClockTime & 0xFFFFU);
+}
+
+static inline uint32_t HostRead(volatile uint32_t *Register)
+{
+    uint32_t Value;
+
+    if( (HostClockTimer == NULL) || (Register != &HostClockTimer->CNT) )
+    {
+        return *Register;
+    }
+    Value = (uint32_t)(HostClockTime & 0xFFFFU);
+    HostClockAdvance( (HostClockStep != NULL) ? HostClockStep() : 1U );
+    return Value;
+}
+
+#undef READ_REG
+#define READ_REG(REG) HostRead(&(REG))
+
+#endif /* __HOST_CLOCK_H */
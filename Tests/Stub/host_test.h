@@ -0,0 +1,44 @@
+/**
+  ******************************************************************************
+  * @file           : host_test.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Minimal check macros for host tests.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned long HostChecks = 0;
+static unsigned long HostFailures = 0;
+
+/* Counts a failed check, printing only the first few of them. */
+#define CHECK(Condition) \
+    do \
+    { \
+        HostChecks++; \
+        if(!(Condition)) \
+        { \
+            if(HostFailures < 10) \
+            { \
+                printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, \
+                    #Condition); \
+            } \
+            HostFailures++; \
+        } \
+    } while(0)
+
+/* Prints the tally and returns the exit status of the test. */
+static inline int HostReport(const char *Name)
+{
+    printf("%s: %lu checks, %lu failed\n", Name, HostChecks, HostFailures);
+    return (HostFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* __HOST_TEST_H */
@@ -0,0 +1,231 @@
+/**
+  ******************************************************************************
+  * @file           : main.h
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host stand-in for the device header, for host tests.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef __HOST_MAIN_H
+#define __HOST_MAIN_H
+
+/*
+ * Models an STM32F103xB just far enough for the modules to build on a host.
+ * Peripheral registers are plain variables, intrinsics are no-ops, and the
+ * tests drive the registers themselves. Each test is a single translation
+ * unit that includes the sources it covers, so the peripherals are static.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __STM32F103xB_H
+#define __CORTEX_M 3U
+
+/* Peripheral addresses are cast to 32 bits by the sources, which the device
+ * does losslessly. The host only needs the low bits to match. */
+#pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+
+#define __IO volatile
+#define HOST_UNUSED __attribute__((unused))
+
+#define SET_BIT(REG, BIT)     ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)   ((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)    ((REG) & (BIT))
+#define WRITE_REG(REG, VAL)   ((REG) = (VAL))
+#define READ_REG(REG)         ((REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK) \
+    WRITE_REG((REG), (((READ_REG(REG)) & (~(CLEARMASK))) | (SETMASK)))
+
+/* Interrupt mask state, so critical sections can be checked by the tests. */
+static HOST_UNUSED uint32_t HostPrimask = 0;
+
+static inline void __NOP(void) {}
+static inline void __WFI(void) {}
+static inline void __DSB(void) {}
+static inline void __DMB(void) {}
+static inline void __ISB(void) {}
+static inline void __disable_irq(void) { HostPrimask = 1; }
+static inline void __enable_irq(void) { HostPrimask = 0; }
+static inline uint32_t __get_PRIMASK(void) { return HostPrimask; }
+static inline void __set_PRIMASK(uint32_t Mask) { HostPrimask = Mask; }
+static inline uint32_t __CLZ(uint32_t Value)
+{
+    return (Value != 0) ? (uint32_t)__builtin_clz(Value) : 32U;
+}
+
+typedef struct
+{
+    __IO uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC,
+        ARR, RCR, CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR, OR;
+} TIM_TypeDef;
+
+typedef struct { __IO uint32_t CR, CFGR, CIR; } RCC_TypeDef;
+typedef struct { __IO uint32_t CTRL, CYCCNT; } DWT_Type;
+typedef struct { __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR; } CoreDebug_Type;
+typedef struct { __IO uint32_t CCR, CNDTR, CPAR, CMAR; } DMA_Channel_TypeDef;
+typedef struct { __IO uint32_t ISR, IFCR; } DMA_TypeDef;
+
+typedef enum
+{
+    TIM1_BRK_IRQn = 24, TIM1_UP_IRQn = 25, TIM1_TRG_COM_IRQn = 26,
+    TIM1_CC_IRQn = 27, TIM2_IRQn = 28, TIM3_IRQn = 29, TIM4_IRQn = 30
+} IRQn_Type;
+
+/* The timers are laid out at their offsets from the peripheral base of the
+ * device, in a block aligned well past them, so that the low address bits
+ * the timer module tells them apart by are those of the device. */
+static HOST_UNUSED uint8_t HostPeripherals[0x13000]
+    __attribute__((aligned(0x100000)));
+static HOST_UNUSED RCC_TypeDef HostRCC;
+static HOST_UNUSED DWT_Type HostDWT;
+static HOST_UNUSED CoreDebug_Type HostCoreDebug;
+static HOST_UNUSED DMA_TypeDef HostDMA1;
+
+static HOST_UNUSED uint32_t SystemCoreClock = 72000000UL;
+static HOST_UNUSED const uint8_t APBPrescTable[8] = {0, 0, 0, 0, 1, 2, 3, 4};
+
+#define TIM1        ((TIM_TypeDef*)(HostPeripherals + 0x12C00))
+#define TIM2        ((TIM_TypeDef*)(HostPeripherals + 0x0000))
+#define TIM3        ((TIM_TypeDef*)(HostPeripherals + 0x0400))
+#define TIM4        ((TIM_TypeDef*)(HostPeripherals + 0x0800))
+#define RCC         (&HostRCC)
+#define DWT         (&HostDWT)
+#define CoreDebug   (&HostCoreDebug)
+#define DMA1        (&HostDMA1)
+
+#define CoreDebug_DEMCR_TRCENA_Msk  (1U << 24)
+#define DWT_CTRL_CYCCNTENA_Msk      (1U << 0)
+
+#define RCC_CFGR_PPRE1_Pos      8U
+#define RCC_CFGR_PPRE1          (7U << 8)
+#define RCC_CFGR_PPRE1_DIV1     0U
+#define RCC_CFGR_PPRE2_Pos      11U
+#define RCC_CFGR_PPRE2          (7U << 11)
+#define RCC_CFGR_PPRE2_DIV1     0U
+
+#define TIM_CR1_CEN         (1U << 0)
+#define TIM_CR1_UDIS        (1U << 1)
+#define TIM_CR1_URS         (1U << 2)
+#define TIM_CR1_OPM         (1U << 3)
+#define TIM_CR1_DIR         (1U << 4)
+#define TIM_CR1_CMS         (3U << 5)
+#define TIM_CR1_ARPE        (1U << 7)
+#define TIM_CR1_CKD_Pos     8U
+#define TIM_CR1_CKD         (3U << 8)
+#define TIM_CR2_CCPC        (1U << 0)
+#define TIM_CR2_CCUS        (1U << 2)
+#define TIM_CR2_CCDS        (1U << 3)
+#define TIM_CR2_MMS_Pos     4U
+#define TIM_CR2_MMS         (7U << 4)
+#define TIM_CR2_MMS_0       (1U << 4)
+#define TIM_CR2_MMS_1       (2U << 4)
+#define TIM_SMCR_SMS_Pos    0U
+#define TIM_SMCR_SMS        (7U << 0)
+#define TIM_SMCR_SMS_0      (1U << 0)
+#define TIM_SMCR_SMS_1      (2U << 0)
+#define TIM_SMCR_SMS_2      (4U << 0)
+#define TIM_SMCR_TS_Pos     4U
+#define TIM_SMCR_TS         (7U << 4)
+#define TIM_SMCR_TS_0       (1U << 4)
+#define TIM_SMCR_TS_2       (4U << 4)
+#define TIM_SMCR_MSM        (1U << 7)
+#define TIM_DIER_UIE        (1U << 0)
+#define TIM_DIER_CC1IE      (1U << 1)
+#define TIM_DIER_CC2IE      (1U << 2)
+#define TIM_DIER_CC3IE      (1U << 3)
+#define TIM_DIER_CC4IE      (1U << 4)
+#define TIM_DIER_COMIE      (1U << 5)
+#define TIM_DIER_TIE        (1U << 6)
+#define TIM_DIER_BIE        (1U << 7)
+#define TIM_DIER_UDE        (1U << 8)
+#define TIM_DIER_CC1DE      (1U << 9)
+#define TIM_DIER_CC2DE      (1U << 10)
+#define TIM_DIER_CC3DE      (1U << 11)
+#define TIM_DIER_CC4DE      (1U << 12)
+#define TIM_SR_UIF_Pos      0U
+#define TIM_SR_UIF          (1U << 0)
+#define TIM_SR_CC1IF_Pos    1U
+#define TIM_SR_CC1IF        (1U << 1)
+#define TIM_SR_CC2IF_Pos    2U
+#define TIM_SR_CC2IF        (1U << 2)
+#define TIM_SR_CC3IF_Pos    3U
+#define TIM_SR_CC3IF        (1U << 3)
+#define TIM_SR_CC4IF_Pos    4U
+#define TIM_SR_CC4IF        (1U << 4)
+#define TIM_SR_COMIF_Pos    5U
+#define TIM_SR_COMIF        (1U << 5)
+#define TIM_SR_TIF_Pos      6U
+#define TIM_SR_TIF          (1U << 6)
+#define TIM_SR_BIF_Pos      7U
+#define TIM_SR_BIF          (1U << 7)
+#define TIM_SR_CC1OF        (1U << 9)
+#define TIM_EGR_UG          (1U << 0)
+#define TIM_EGR_CC1G        (1U << 1)
+#define TIM_EGR_CC2G        (1U << 2)
+#define TIM_EGR_CC3G        (1U << 3)
+#define TIM_EGR_CC4G        (1U << 4)
+#define TIM_EGR_COMG        (1U << 5)
+#define TIM_EGR_TG          (1U << 6)
+#define TIM_EGR_BG          (1U << 7)
+#define TIM_CCMR1_CC1S      (3U << 0)
+#define TIM_CCMR1_CC1S_0    (1U << 0)
+#define TIM_CCMR1_CC1S_1    (2U << 0)
+#define TIM_CCMR1_OC1PE     (1U << 3)
+#define TIM_CCMR1_OC1M      (7U << 4)
+#define TIM_CCMR1_OC1M_0    (1U << 4)
+#define TIM_CCMR1_OC1M_1    (2U << 4)
+#define TIM_CCMR1_OC1M_2    (4U << 4)
+#define TIM_CCMR1_IC1PSC    (3U << 2)
+#define TIM_CCMR1_IC1F_Pos  4U
+#define TIM_CCMR1_IC1F      (15U << 4)
+#define TIM_CCMR1_CC2S      (3U << 8)
+#define TIM_CCMR1_CC2S_0    (1U << 8)
+#define TIM_CCMR1_CC2S_1    (2U << 8)
+#define TIM_CCMR1_OC2PE     (1U << 11)
+#define TIM_CCMR1_IC2F_Pos  12U
+#define TIM_CCMR1_IC2F      (15U << 12)
+#define TIM_CCMR2_OC3PE     (1U << 3)
+#define TIM_CCMR2_OC4PE     (1U << 11)
+#define TIM_CCER_CC1E       (1U << 0)
+#define TIM_CCER_CC1P       (1U << 1)
+#define TIM_CCER_CC1NE      (1U << 2)
+#define TIM_CCER_CC1NP      (1U << 3)
+#define TIM_CCER_CC2E       (1U << 4)
+#define TIM_CCER_CC2P       (1U << 5)
+#define TIM_CCER_CC2NE      (1U << 6)
+#define TIM_CCER_CC3E       (1U << 8)
+#define TIM_CCER_CC3NE      (1U << 10)
+#define TIM_CCER_CC4E       (1U << 12)
+#define TIM_BDTR_DTG_Pos    0U
+#define TIM_BDTR_DTG        (0xFFU)
+#define TIM_BDTR_LOCK_Pos   8U
+#define TIM_BDTR_LOCK       (3U << 8)
+#define TIM_BDTR_OSSI       (1U << 10)
+#define TIM_BDTR_OSSR       (1U << 11)
+#define TIM_BDTR_BKE        (1U << 12)
+#define TIM_BDTR_BKP        (1U << 13)
+#define TIM_BDTR_AOE        (1U << 14)
+#define TIM_BDTR_MOE        (1U << 15)
+#define TIM_DCR_DBA_Pos     0U
+#define TIM_DCR_DBA         (31U)
+#define TIM_DCR_DBL_Pos     8U
+#define TIM_DCR_DBL         (31U << 8)
+
+#define DMA_CCR_EN          (1U << 0)
+#define DMA_CCR_TCIE        (1U << 1)
+#define DMA_CCR_HTIE        (1U << 2)
+#define DMA_CCR_TEIE        (1U << 3)
+#define DMA_CCR_DIR         (1U << 4)
+#define DMA_CCR_CIRC        (1U << 5)
+#define DMA_CCR_MINC        (1U << 7)
+#define DMA_CCR_PSIZE_0     (1U << 8)
+#define DMA_CCR_PSIZE_1     (1U << 9)
+#define DMA_CCR_MSIZE_0     (1U << 10)
+#define DMA_CCR_MSIZE_1     (1U << 11)
+#define DMA_CCR_PL_1        (1U << 13)
+
+#endif /* __HOST_MAIN_H */
@@ -0,0 +1,217 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_delay_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test of the delay module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <host_clock.h>
+#include "../Src/hierodule_tstamp.c"
+#include "../Src/hierodule_delay.c"
+
+/*
+ * The timestamp timer counts at 8 MHz. Delays and waits are run with the
+ * timestamp interrupts serviced as they come, and with them held off, as in
+ * a caller with PRIMASK set, for spans of many counter periods.
+ */
+
+#define KERNEL_CLOCK    8000000UL
+#define STEP_MAX        40U
+#define PREEMPTION      300000U
+
+/* The timer routines the timestamp module needs. */
+#define FAKE_TIMER_IT(Flag) \
+    void HIERODULE_TIM_Assign_Callback_##Flag(TIM_TypeDef *Timer, \
+        HIERODULE_TIM_Callback Callback, void *Context) \
+    { (void)Timer; (void)Callback; (void)Context; } \
+    void HIERODULE_TIM_ClearFlag_##Flag(TIM_TypeDef *Timer) { (void)Timer; } \
+    void HIERODULE_TIM_Enable_IT_##Flag(TIM_TypeDef *Timer) { (void)Timer; }
+
+FAKE_TIMER_IT(UPD)
+FAKE_TIMER_IT(CC1)
+
+void HIERODULE_TIM_ClearCounter(TIM_TypeDef *Timer)
+{
+    Timer->CNT = 0;
+}
+
+uint32_t HIERODULE_TIM_GetKernelClock(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+    return KERNEL_CLOCK;
+}
+
+/* 1 while the timestamp interrupts are held off, and the flags raised
+ * meanwhile. */
+static uint32_t Blocked = 0;
+static uint32_t Pending = 0;
+
+/* Chance in a thousand that a read is preempted for a long while. */
+static uint32_t PreemptionRate = 0;
+
+static void Cross(uint32_t Half)
+{
+    if(Blocked == 0)
+    {
+        HalfTick(TIM3, 0, NULL);
+    }
+    else
+    {
+        Pending |= 1U << Half;
+    }
+}
+
+/* Lets the interrupts in, each pending flag is serviced once. */
+static void Unblock(void)
+{
+    Blocked = 0;
+    for( ; Pending != 0 ; Pending &= Pending - 1)
+    {
+        HalfTick(TIM3, 0, NULL);
+    }
+}
+
+static uint32_t Step(void)
+{
+    if( (PreemptionRate != 0) && ((uint32_t)(rand() % 1000) < PreemptionRate) )
+    {
+        return PREEMPTION + (uint32_t)(rand() % 1000);
+    }
+    return 1U + (uint32_t)(rand() % STEP_MAX);
+}
+
+static void Start(void)
+{
+    HostClockTimer = TIM3;
+    HostClockTime = 0;
+    HostClockStep = &Step;
+    HostClockCross = &Cross;
+    TIM3->PSC = 0;
+    HIERODULE_TSTAMP_Init(TIM3);
+    HIERODULE_DELAY_Init();
+}
+
+/* Runs a delay, returning the counts it took. */
+static uint64_t Delay(uint32_t Microseconds)
+{
+    uint64_t Before = HostClockTime;
+
+    HIERODULE_DELAY_us(Microseconds);
+    return HostClockTime - Before;
+}
+
+static void Delays(uint32_t HeldOff, uint32_t Rate)
+{
+    static const uint32_t Lengths[] = { 0, 1, 3, 10, 4095, 4096, 8192, 65537,
+        100000, 250000 };
+
+    Blocked = HeldOff;
+    PreemptionRate = Rate;
+    for(uint32_t i = 0 ; i < sizeof(Lengths) / sizeof(Lengths[0]) ; i++)
+    {
+        for(uint32_t k = 0 ; k < 5 ; k++)
+        {
+            uint64_t Span = (uint64_t)Lengths[i] * (KERNEL_CLOCK / 1000000UL);
+            uint64_t Took;
+            uint64_t Waited = HIERODULE_DELAY_GetWaited();
+
+            HostClockAdvance((uint64_t)rand() % 70000U);
+            Took = Delay(Lengths[i]);
+
+            CHECK(Took >= Span);
+            if(Rate == 0)
+            {
+                CHECK(Took <= Span + 3U * STEP_MAX);
+            }
+            CHECK(HIERODULE_DELAY_GetWaited() - Waited <= Took);
+            CHECK(HIERODULE_DELAY_GetWaited() - Waited + 3U * STEP_MAX >= Took);
+        }
+    }
+    Unblock();
+    PreemptionRate = 0;
+}
+
+/* The register the waits poll, set by the first read at or past SetAt. */
+static uint32_t Register;
+static uint64_t SetAt;
+
+static uint32_t StepAndSet(void)
+{
+    if(HostClockTime >= SetAt)
+    {
+        Register |= 0x10U;
+    }
+    return Step();
+}
+
+static void Waits(uint32_t HeldOff)
+{
+    Blocked = HeldOff;
+    HostClockStep = &StepAndSet;
+
+    for(uint32_t k = 0 ; k < 20 ; k++)
+    {
+        uint32_t Microseconds = 1000U + (uint32_t)(rand() % 50000);
+        uint64_t Span = (uint64_t)Microseconds * (KERNEL_CLOCK / 1000000UL);
+        HIERODULE_DELAY_Deadline Deadline;
+        uint64_t Before;
+        uint8_t Matched;
+
+        Register = 0;
+        SetAt = UINT64_MAX;
+        Deadline = HIERODULE_DELAY_After_us(Microseconds);
+        Before = HostClockTime;
+
+        if(k & 1)
+        {
+            SetAt = Before + Span / 2;
+            Matched = HIERODULE_DELAY_WaitUntil(&Register, 0x10U, 0x10U,
+                Deadline);
+            CHECK(Matched == 1);
+            CHECK(HostClockTime >= SetAt);
+            CHECK(HostClockTime <= SetAt + 4U * STEP_MAX);
+        }
+        else
+        {
+            Matched = HIERODULE_DELAY_WaitUntil(&Register, 0x10U, 0x10U,
+                Deadline);
+            CHECK(Matched == 0);
+            CHECK(HostClockTime - Before + 2U * STEP_MAX >= Span);
+            CHECK(HostClockTime - Before <= Span + 4U * STEP_MAX);
+        }
+    }
+
+    /* A deadline that has passed reads the register once more. */
+    Register = 0x10U;
+    SetAt = UINT64_MAX;
+    CHECK(HIERODULE_DELAY_WaitUntil(&Register, 0x10U, 0x10U,
+        HIERODULE_TSTAMP_Get32() - 1000U) == 1);
+    Register = 0;
+    CHECK(HIERODULE_DELAY_WaitUntil(&Register, 0x10U, 0x10U,
+        HIERODULE_TSTAMP_Get32() - 1000U) == 0);
+
+    HostClockStep = &Step;
+    Unblock();
+}
+
+int main(void)
+{
+    srand(3);
+    Start();
+
+    Delays(0, 0);
+    Delays(1, 0);
+    Delays(0, 2);
+    Waits(0);
+    Waits(1);
+
+    HIERODULE_DELAY_ResetWaited();
+    CHECK(HIERODULE_DELAY_GetWaited() == 0);
+
+    return HostReport("delay");
+}
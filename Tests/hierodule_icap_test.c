@@ -0,0 +1,425 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_icap_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test of the capture streams of the input capture
+  * module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <string.h>
+#include "../Src/hierodule_icap.c"
+
+/*
+ * A trace of NEC remote frames, as falling edge timestamps of a 1 MHz timer,
+ * is fed through a simulated circular DMA channel into a capture stream and
+ * decoded off the spans returned by HIERODULE_ICAP_Peek. The DMA interrupt
+ * is serviced late, and the reader polls at random points in between, so the
+ * pending half and the stream wrap are both crossed.
+ *
+ * Streams with an odd or empty buffer have to be left unusable, without the
+ * timer or the DMA ever being touched, and PWM input reads have to tell
+ * whether a period has been captured.
+ */
+
+#define TOLERANCE   150U
+#define LEAD        13500U
+#define REPEAT      11250U
+#define BIT_ZERO    1125U
+#define BIT_ONE     2250U
+#define GAP         40000U
+
+/* Simulated DMA channel, and the number of times it was started. */
+static uint32_t DmaStarts = 0;
+static uint16_t *DmaBuffer;
+static uint32_t DmaSize;
+static uint32_t DmaPosition;
+static uint32_t DmaFlags;
+
+void HIERODULE_DMA_StartCircular(const HIERODULE_DMA_Link *Link,
+    HIERODULE_DMA_Direction Direction, volatile uint32_t *Register,
+    void *Memory, uint16_t Count, uint8_t Size)
+{
+    (void)Link;
+    (void)Direction;
+    (void)Register;
+    (void)Size;
+    DmaStarts++;
+    DmaBuffer = (uint16_t*)Memory;
+    DmaSize = Count;
+    DmaPosition = 0;
+    DmaFlags = 0;
+}
+
+void HIERODULE_DMA_Stop(const HIERODULE_DMA_Link *Link)
+{
+    (void)Link;
+}
+
+uint32_t HIERODULE_DMA_GetRemaining(const HIERODULE_DMA_Link *Link)
+{
+    (void)Link;
+    return DmaSize - DmaPosition;
+}
+
+uint32_t HIERODULE_DMA_FetchFlags(const HIERODULE_DMA_Link *Link)
+{
+    uint32_t Flags = DmaFlags;
+
+    (void)Link;
+    DmaFlags = 0;
+    return Flags;
+}
+
+/* The timer routines the engine needs, unused by the streams. */
+#define FAKE_TIMER_IT(Flag) \
+    void HIERODULE_TIM_Assign_Callback_##Flag(TIM_TypeDef *Timer, \
+        HIERODULE_TIM_Callback Callback, void *Context) \
+    { (void)Timer; (void)Callback; (void)Context; } \
+    void HIERODULE_TIM_Enable_IT_##Flag(TIM_TypeDef *Timer) { (void)Timer; }
+
+FAKE_TIMER_IT(UPD)
+FAKE_TIMER_IT(CC1)
+FAKE_TIMER_IT(CC2)
+FAKE_TIMER_IT(CC3)
+FAKE_TIMER_IT(CC4)
+
+void HIERODULE_TIM_ClearFlag_UPD(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+}
+
+uint32_t HIERODULE_TIM_GetKernelClock(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+    return 72000000UL;
+}
+
+/* Writes a capture the way the DMA does, raising HT and TC. */
+static void DmaWrite(uint16_t Capture)
+{
+    DmaBuffer[DmaPosition++] = Capture;
+    if(DmaPosition == (DmaSize >> 1))
+    {
+        DmaFlags |= HIERODULE_DMA_FLAG_HT;
+    }
+    if(DmaPosition == DmaSize)
+    {
+        DmaFlags |= HIERODULE_DMA_FLAG_TC;
+        DmaPosition = 0;
+    }
+}
+
+/* Edge trace of a run of frames, each a lead, 32 bits and a gap. */
+typedef struct
+{
+    uint16_t *Edge;
+    uint32_t Count;
+    uint32_t *Frame;
+    uint32_t Frames;
+} Trace;
+
+static uint32_t Jitter(void)
+{
+    return (uint32_t)(rand() % 101) - 50U;
+}
+
+static void Record(Trace *Run, uint32_t Frames)
+{
+    uint16_t Stamp = (uint16_t)rand();
+    uint32_t Count = 0;
+
+    Run->Edge = malloc(sizeof(uint16_t) * Frames * 35);
+    Run->Frame = malloc(sizeof(uint32_t) * Frames);
+    Run->Frames = Frames;
+
+    Run->Edge[Count++] = Stamp;
+    for(uint32_t f = 0 ; f < Frames ; f++)
+    {
+        uint32_t Address = (uint32_t)rand() & 0xFFU;
+        uint32_t Command = (uint32_t)rand() & 0xFFU;
+        uint32_t Frame = Address | ((~Address & 0xFFU) << 8) |
+            (Command << 16) | ((~Command & 0xFFU) << 24);
+
+        Run->Frame[f] = Frame;
+        Stamp = (uint16_t)(Stamp + LEAD + Jitter());
+        Run->Edge[Count++] = Stamp;
+        for(uint32_t b = 0 ; b < 32 ; b++)
+        {
+            Stamp = (uint16_t)(Stamp +
+                (((Frame >> b) & 1U) ? BIT_ONE : BIT_ZERO) + Jitter());
+            Run->Edge[Count++] = Stamp;
+        }
+        Stamp = (uint16_t)(Stamp + GAP + Jitter());
+        Run->Edge[Count++] = Stamp;
+    }
+    Run->Count = Count;
+}
+
+static void Discard(Trace *Run)
+{
+    free(Run->Edge);
+    free(Run->Frame);
+}
+
+/* NEC decoder fed one capture at a time. */
+typedef struct
+{
+    uint16_t Last;
+    uint32_t Seen;
+    int32_t Bit;
+    uint32_t Shift;
+    uint32_t *Frame;
+    uint32_t Frames;
+    uint32_t Capacity;
+} Decoder;
+
+static uint8_t Near(uint32_t Interval, uint32_t Nominal)
+{
+    return ( (Interval + TOLERANCE >= Nominal) &&
+        (Interval <= Nominal + TOLERANCE) ) ? 1 : 0;
+}
+
+static void Decode(Decoder *State, uint16_t Capture)
+{
+    uint32_t Interval = (uint16_t)(Capture - State->Last);
+
+    State->Last = Capture;
+    if(State->Seen++ == 0)
+    {
+        return;
+    }
+
+    if(Near(Interval, LEAD))
+    {
+        State->Bit = 0;
+        State->Shift = 0;
+    }
+    else if( (State->Bit >= 0) && (Near(Interval, BIT_ZERO) ||
+        Near(Interval, BIT_ONE)) )
+    {
+        if(Near(Interval, BIT_ONE))
+        {
+            State->Shift |= 1UL << State->Bit;
+        }
+        if(++State->Bit == 32)
+        {
+            if(State->Frames < State->Capacity)
+            {
+                State->Frame[State->Frames++] = State->Shift;
+            }
+            State->Bit = -1;
+        }
+    }
+    else
+    {
+        State->Bit = -1;
+    }
+}
+
+/* Drains the stream into the decoder, returns the number of captures. */
+static uint32_t Drain(HIERODULE_ICAP_Stream *Stream, Decoder *State)
+{
+    const uint16_t *Span;
+    uint32_t Count;
+    uint32_t Total = 0;
+
+    while( (Count = HIERODULE_ICAP_Peek(Stream, &Span)) > 0 )
+    {
+        CHECK(Span >= Stream->Buffer);
+        CHECK(Span + Count <= Stream->Buffer + Stream->Size);
+        for(uint32_t i = 0 ; i < Count ; i++)
+        {
+            Decode(State, Span[i]);
+        }
+        HIERODULE_ICAP_Consume(Stream, Count);
+        Total += Count;
+    }
+    return Total;
+}
+
+/*
+ * Streams a trace with the interrupt serviced within a quarter buffer of
+ * its flag, and the reader polling at random, at least once per half
+ * buffer. The stream is started the
+ * given number of halves before the wrap of its range, an even number for
+ * the DMA to be at the start of the buffer.
+ */
+static void StreamTrace(uint16_t Size, uint32_t HalvesBeforeWrap)
+{
+    HIERODULE_DMA_Link Link = { 0 };
+    HIERODULE_ICAP_Stream Stream;
+    uint16_t *Buffer = malloc(sizeof(uint16_t) * Size);
+    Trace Run;
+    Decoder State = { 0 };
+    uint32_t Drained = 0;
+    uint32_t Idle = 0;
+    int32_t ServiceIn = -1;
+
+    Record(&Run, 400);
+    State.Frame = malloc(sizeof(uint32_t) * Run.Frames);
+    State.Capacity = Run.Frames;
+    State.Bit = -1;
+
+    HIERODULE_ICAP_InitStream(&Stream, TIM3, 1, HIERODULE_ICAP_Edge_FALLING,
+        &Link, Buffer, Size, NULL, NULL);
+    HIERODULE_ICAP_StartStream(&Stream);
+
+    if(HalvesBeforeWrap != 0)
+    {
+        Stream.Halves = Stream.Range / (Size >> 1U) - HalvesBeforeWrap;
+        Stream.Consumed = Stream.Halves * (Size >> 1U);
+    }
+
+    for(uint32_t i = 0 ; i < Run.Count ; i++)
+    {
+        DmaWrite(Run.Edge[i]);
+
+        if( (DmaFlags != 0) && (ServiceIn < 0) )
+        {
+            ServiceIn = rand() % (Size >> 2);
+        }
+        if( (ServiceIn >= 0) && (ServiceIn-- == 0) )
+        {
+            HIERODULE_ICAP_ServiceStream(&Stream);
+        }
+        if( ((rand() % (Size >> 2)) == 0) || (++Idle == (Size >> 1U)) )
+        {
+            Drained += Drain(&Stream, &State);
+            Idle = 0;
+        }
+    }
+    HIERODULE_ICAP_ServiceStream(&Stream);
+    Drained += Drain(&Stream, &State);
+
+    CHECK(Stream.Overruns == 0);
+    CHECK(Drained == Run.Count);
+    CHECK(State.Frames == Run.Frames);
+    for(uint32_t f = 0 ; (f < Run.Frames) && (f < State.Frames) ; f++)
+    {
+        CHECK(State.Frame[f] == Run.Frame[f]);
+    }
+
+    free(State.Frame);
+    free(Buffer);
+    Discard(&Run);
+}
+
+/* A reader that falls behind is counted and resumes on the latest half. */
+static void Overrun(uint16_t Size)
+{
+    HIERODULE_DMA_Link Link = { 0 };
+    HIERODULE_ICAP_Stream Stream;
+    uint16_t *Buffer = malloc(sizeof(uint16_t) * Size);
+    const uint16_t *Span;
+    uint32_t Count;
+    uint32_t Written = 0;
+
+    HIERODULE_ICAP_InitStream(&Stream, TIM3, 1, HIERODULE_ICAP_Edge_FALLING,
+        &Link, Buffer, Size, NULL, NULL);
+    HIERODULE_ICAP_StartStream(&Stream);
+    Stream.Halves = Stream.Range / (Size >> 1U) - 2;
+    Stream.Consumed = Stream.Halves * (Size >> 1U);
+
+    for( ; Written < (uint32_t)Size * 3 + 7 ; Written++)
+    {
+        DmaWrite((uint16_t)Written);
+        if(DmaFlags != 0)
+        {
+            HIERODULE_ICAP_ServiceStream(&Stream);
+        }
+    }
+
+    Count = HIERODULE_ICAP_Peek(&Stream, &Span);
+    CHECK(Stream.Overruns == 1);
+    CHECK(Count > 0);
+    CHECK(Span[0] == (uint16_t)(Written - (Size >> 1)));
+
+    while( (Count = HIERODULE_ICAP_Peek(&Stream, &Span)) > 0 )
+    {
+        for(uint32_t i = 0 ; i < Count ; i++)
+        {
+            CHECK(Span[i] == (uint16_t)(Written - (Size >> 1) + i));
+        }
+        Written += Count;
+        HIERODULE_ICAP_Consume(&Stream, Count);
+    }
+    CHECK(Stream.Overruns == 1);
+
+    free(Buffer);
+}
+
+/* Buffers of odd or no size are refused. */
+static void Refused(void)
+{
+    static const uint16_t Sizes[] = { 0, 1, 7, 255, 4095, 0xFFFF };
+    HIERODULE_DMA_Link Link = { 0 };
+    HIERODULE_ICAP_Stream Stream;
+    uint16_t Buffer[8];
+    const uint16_t *Span = NULL;
+    TIM_TypeDef Before;
+
+    for(uint32_t i = 0 ; i < sizeof(Sizes) / sizeof(Sizes[0]) ; i++)
+    {
+        memset(TIM3, 0, sizeof(*TIM3));
+        memcpy(&Before, (const void*)TIM3, sizeof(Before));
+        DmaStarts = 0;
+
+        HIERODULE_ICAP_InitStream(&Stream, TIM3, 1,
+            HIERODULE_ICAP_Edge_FALLING, &Link, Buffer, Sizes[i], NULL, NULL);
+        CHECK(Stream.Size == 0);
+        HIERODULE_ICAP_StartStream(&Stream);
+        CHECK(DmaStarts == 0);
+        CHECK(memcmp(&Before, (const void*)TIM3, sizeof(Before)) == 0);
+        CHECK(HIERODULE_ICAP_Peek(&Stream, &Span) == 0);
+        CHECK(Span == Buffer);
+        HIERODULE_ICAP_Consume(&Stream, 0);
+        CHECK(HIERODULE_ICAP_Peek(&Stream, &Span) == 0);
+    }
+
+    HIERODULE_ICAP_InitStream(&Stream, TIM3, 1, HIERODULE_ICAP_Edge_FALLING,
+        &Link, Buffer, 8, NULL, NULL);
+    CHECK(Stream.Size == 8);
+    HIERODULE_ICAP_StartStream(&Stream);
+    CHECK(DmaStarts == 1);
+}
+
+/* The count is set along with the period and the width. */
+static void PwmInput(void)
+{
+    HIERODULE_ICAP_Result Result = { 7, 7, 7 };
+
+    TIM3->CCR1 = 0;
+    TIM3->CCR2 = 0;
+    HIERODULE_ICAP_ReadPwmInput(TIM3, &Result);
+    CHECK( (Result.Period == 0) && (Result.Width == 0) );
+    CHECK(Result.Count == 0);
+
+    TIM3->CCR1 = 1000;
+    TIM3->CCR2 = 250;
+    HIERODULE_ICAP_ReadPwmInput(TIM3, &Result);
+    CHECK( (Result.Period == 1000) && (Result.Width == 250) );
+    CHECK(Result.Count == 1);
+}
+
+int main(void)
+{
+    static const uint16_t Sizes[] = { 16, 64, 250, 256, 998, 4096 };
+
+    srand(1);
+    for(uint32_t i = 0 ; i < sizeof(Sizes) / sizeof(Sizes[0]) ; i++)
+    {
+        StreamTrace(Sizes[i], 0);
+        StreamTrace(Sizes[i], 2);
+        StreamTrace(Sizes[i], 8);
+        Overrun(Sizes[i]);
+    }
+    Refused();
+    PwmInput();
+
+    return HostReport("icap");
+}
@@ -0,0 +1,398 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_sched_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test of the event scheduler module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <main.h>
+#include "../Src/hierodule_sched.c"
+
+/*
+ * The timestamps are the simulated time itself, and the counter of TIM3 its
+ * lower 16 bits. A lane runs on channel 2, whose compare raises CC2IF the
+ * way the hardware does when the counter reaches CCR2, as does a CC2G write
+ * to EGR, and the lane's callback is called once the flag is pending with
+ * CC2IE set, right away or a random number of counts late.
+ *
+ * Events sharing a deadline have to fire in post order, also across the wrap
+ * of the post sequence, and events have to fire in deadline order, on their
+ * deadline if the IRQ is on time. Events posted with a deadline already
+ * passed are counted as late and fired right away. A random mix of posts,
+ * moves and cancels, from the main context and from callbacks, is checked
+ * against a reference queue, with the heap checked after each step.
+ */
+
+#define CAPACITY    64U
+#define CHANNEL     2U
+
+/* Simulated time, the count the pending IRQ gets taken at, and the most
+ * counts it may be late by. */
+static uint64_t Time = 0;
+static uint64_t ServiceAt = 0;
+static uint32_t Latency = 0;
+static uint32_t Flag = 0;
+
+/* The callback the lane assigned and its context. */
+static HIERODULE_TIM_Callback Handler = NULL;
+static void *HandlerContext = NULL;
+
+uint64_t HIERODULE_TSTAMP_Get(void)
+{
+    return Time;
+}
+
+#define FAKE_TIMER_CC(Channel) \
+    void HIERODULE_TIM_Assign_Callback_CC##Channel(TIM_TypeDef *Timer, \
+        HIERODULE_TIM_Callback Callback, void *Context) \
+    { (void)Timer; Handler = Callback; HandlerContext = Context; }
+
+FAKE_TIMER_CC(1)
+FAKE_TIMER_CC(2)
+FAKE_TIMER_CC(3)
+FAKE_TIMER_CC(4)
+
+static HIERODULE_SCHED_Lane Lane;
+static HIERODULE_SCHED_Event *Heap[CAPACITY];
+static HIERODULE_SCHED_Event Events[CAPACITY];
+
+/* Events in the order they fired, and the times they fired at. */
+static HIERODULE_SCHED_Event *Fired[4096];
+static uint64_t FiredAt[4096];
+static uint32_t FiredCount = 0;
+
+static void Raise(void)
+{
+    Flag = 1;
+    ServiceAt = Time + ((Latency != 0) ? (uint32_t)(rand() % (Latency + 1)) :
+        0);
+}
+
+static void Service(void)
+{
+    while(1)
+    {
+        if( (TIM3->EGR & TIM_EGR_CC2G) != 0 )
+        {
+            TIM3->EGR = 0;
+            if(Flag == 0)
+            {
+                Raise();
+            }
+        }
+        if( (Flag == 0) || ((TIM3->DIER & TIM_DIER_CC2IE) == 0) ||
+            (Time < ServiceAt) )
+        {
+            break;
+        }
+        Flag = 0;
+        Handler(TIM3, TIM_SR_CC2IF, HandlerContext);
+    }
+}
+
+/* Moves the time on, stopping at each match of CCR2 and at the count the
+ * pending IRQ is taken at. */
+static void Run(uint64_t Counts)
+{
+    uint64_t End = Time + Counts;
+
+    Service();
+    while(Time < End)
+    {
+        uint64_t Match = Time +
+            (((TIM3->CCR2 - TIM3->CNT - 1U) & COUNT_MASK) + 1U);
+        uint64_t Next = End;
+
+        if( (Flag == 0) && (Match < Next) )
+        {
+            Next = Match;
+        }
+        if( (Flag != 0) && (ServiceAt > Time) && (ServiceAt < Next) )
+        {
+            Next = ServiceAt;
+        }
+        Time = Next;
+        TIM3->CNT = (uint32_t)(Time & COUNT_MASK);
+        if( (Flag == 0) && (Time == Match) )
+        {
+            Raise();
+        }
+        Service();
+    }
+}
+
+/* The heap property holds and every event knows its position. */
+static void Heapified(void)
+{
+    for(uint32_t i = 0 ; i < Lane.Count ; i++)
+    {
+        CHECK(Lane.Heap[i]->Index == i + 1);
+        CHECK( (i == 0) || !Precedes(Lane.Heap[i], Lane.Heap[(i - 1) >> 1]) );
+    }
+}
+
+/* Checks the event fires on its deadline, unless it's posted with a context,
+ * which marks one posted late. */
+static void Record(HIERODULE_SCHED_Event *Event, void *Context)
+{
+    CHECK(Event->Index == NOT_QUEUED);
+    CHECK(Time >= Event->Deadline);
+    CHECK( (Context != NULL) || (Time - Event->Deadline <= Latency) );
+    if(FiredCount < sizeof(Fired) / sizeof(Fired[0]))
+    {
+        Fired[FiredCount] = Event;
+        FiredAt[FiredCount++] = Time;
+    }
+}
+
+static void Begin(uint64_t At, uint32_t MaxLatency)
+{
+    Time = At;
+    TIM3->CNT = (uint32_t)(Time & COUNT_MASK);
+    TIM3->DIER = 0;
+    TIM3->EGR = 0;
+    TIM3->SR = TIM_SR_CC2IF;
+    Flag = 0;
+    Latency = MaxLatency;
+    FiredCount = 0;
+    for(uint32_t i = 0 ; i < CAPACITY ; i++)
+    {
+        Events[i].Index = NOT_QUEUED;
+    }
+    HIERODULE_SCHED_InitLane(&Lane, TIM3, CHANNEL, Heap, CAPACITY);
+    CHECK(Lane.Capacity == CAPACITY);
+    CHECK(Handler == &LaneTick);
+    CHECK(HandlerContext == &Lane);
+    CHECK( (TIM3->SR & TIM_SR_CC2IF) == 0 );
+}
+
+static void Post(uint32_t i, uint64_t Deadline)
+{
+    CHECK(HIERODULE_SCHED_Post(&Lane, &Events[i], Deadline, &Record, NULL));
+    Heapified();
+    Service();
+}
+
+static void PostLate(uint32_t i, uint64_t Deadline)
+{
+    CHECK(HIERODULE_SCHED_Post(&Lane, &Events[i], Deadline, &Record, &Lane));
+    Heapified();
+    Service();
+}
+
+/* Events sharing a deadline fire in post order, a moved one going last,
+ * with the post sequence starting right before its wrap. */
+static void Ties(uint32_t Start)
+{
+    static const uint32_t Order[] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+
+    Begin(1000000, 0);
+    Lane.Sequence = Start;
+    for(uint32_t i = 0 ; i < 8 ; i++)
+    {
+        Post(i, Time + 5000);
+    }
+    Post(1, Time + 5000);
+    for(uint32_t i = 8 ; i < 12 ; i++)
+    {
+        Post(i, Time + 4000);
+    }
+
+    Run(6000);
+    CHECK(FiredCount == 12);
+    for(uint32_t i = 0 ; (i < 4) && (i < FiredCount) ; i++)
+    {
+        CHECK(Fired[i] == &Events[8 + i]);
+        CHECK(FiredAt[i] == 1004000);
+    }
+    for(uint32_t i = 0 ; (i < 8) && (i + 4 < FiredCount) ; i++)
+    {
+        CHECK(Fired[i + 4] == &Events[Order[i]]);
+        CHECK(FiredAt[i + 4] == 1005000);
+    }
+    CHECK(Lane.Count == 0);
+    CHECK( (TIM3->DIER & TIM_DIER_CC2IE) == 0 );
+}
+
+/* Deadlines already passed are counted as late and fired right away, in
+ * deadline order, before anything due later, and a deadline past half the
+ * counter range takes intermediate wake ups but still fires on time. */
+static void Late(void)
+{
+    Begin(5000000, 0);
+    Post(0, Time + 100000);
+    Post(1, Time + 10);
+    CHECK(HIERODULE_SCHED_GetLateCount(&Lane) == 0);
+    CHECK(FiredCount == 0);
+
+    Run(3);
+    PostLate(2, Time - 50);
+    CHECK(HIERODULE_SCHED_GetLateCount(&Lane) == 1);
+    CHECK(FiredCount == 1);
+    CHECK( (FiredCount >= 1) && (Fired[0] == &Events[2]) );
+
+    /* Due right now counts as late too. */
+    PostLate(3, Time);
+    CHECK(HIERODULE_SCHED_GetLateCount(&Lane) == 2);
+    CHECK( (FiredCount >= 2) && (Fired[1] == &Events[3]) );
+
+    /* Two late ones posted before the IRQ is taken fire in deadline
+     * order. */
+    CHECK(HIERODULE_SCHED_Post(&Lane, &Events[4], Time - 5, &Record,
+        &Lane));
+    CHECK(HIERODULE_SCHED_Post(&Lane, &Events[5], Time - 500, &Record,
+        &Lane));
+    CHECK(FiredCount == 2);
+    Service();
+    CHECK(HIERODULE_SCHED_GetLateCount(&Lane) == 4);
+    CHECK( (FiredCount >= 4) && (Fired[2] == &Events[5]) &&
+        (Fired[3] == &Events[4]) );
+
+    Run(200000);
+    CHECK(FiredCount == 6);
+    CHECK( (FiredCount == 6) && (Fired[4] == &Events[1]) &&
+        (FiredAt[4] == 5000010) );
+    CHECK( (FiredCount == 6) && (Fired[5] == &Events[0]) &&
+        (FiredAt[5] == 5100000) );
+    CHECK(HIERODULE_SCHED_GetLateCount(&Lane) == 4);
+}
+
+/* Reference queue, the same events kept with their deadlines and post
+ * order, checked against the order the lane fires them in. */
+static uint8_t Queued[CAPACITY];
+static uint64_t Deadline[CAPACITY];
+static uint64_t Order[CAPACITY];
+static uint64_t Posts = 0;
+
+static void Track(HIERODULE_SCHED_Event *Event, void *Context);
+
+static void RandomPost(uint32_t i, uint64_t Due)
+{
+    CHECK(HIERODULE_SCHED_Post(&Lane, &Events[i], Due, &Track, NULL));
+    Queued[i] = 1;
+    Deadline[i] = Due;
+    Order[i] = Posts++;
+    Heapified();
+}
+
+static void RandomCancel(uint32_t i)
+{
+    CHECK(HIERODULE_SCHED_Cancel(&Lane, &Events[i]) == Queued[i]);
+    Queued[i] = 0;
+    Heapified();
+}
+
+/* Deadlines cluster on a few values so ties are common, some are already
+ * passed, and some are further than half the counter range. */
+static uint64_t RandomDeadline(void)
+{
+    switch(rand() % 4)
+    {
+        case 0:
+            return Time - (uint64_t)(rand() % 100);
+        case 1:
+            return (Time & ~0x3FFULL) + 0x400 * (uint64_t)(1 + rand() % 4);
+        case 2:
+            return Time + (uint64_t)(rand() % 200000);
+        default:
+            return Time + (uint64_t)(rand() % 3000);
+    }
+}
+
+static void Track(HIERODULE_SCHED_Event *Event, void *Context)
+{
+    uint32_t i = (uint32_t)(Event - Events);
+
+    (void)Context;
+    CHECK(Queued[i] == 1);
+    CHECK(Event->Index == NOT_QUEUED);
+    CHECK(Time >= Deadline[i]);
+
+    /* Nothing queued precedes it. */
+    for(uint32_t k = 0 ; k < CAPACITY ; k++)
+    {
+        if( (k == i) || (Queued[k] == 0) )
+        {
+            continue;
+        }
+        CHECK( (Deadline[k] > Deadline[i]) ||
+            ((Deadline[k] == Deadline[i]) && (Order[k] > Order[i])) );
+    }
+    Queued[i] = 0;
+    FiredCount++;
+
+    /* Callbacks post and cancel too. */
+    if( (rand() % 4) == 0 )
+    {
+        uint32_t k = (uint32_t)(rand() % CAPACITY);
+
+        if( (rand() % 3) == 0 )
+        {
+            RandomCancel(k);
+        }
+        else
+        {
+            RandomPost(k, RandomDeadline());
+        }
+    }
+}
+
+static void Mix(uint32_t MaxLatency, uint32_t Start)
+{
+    Begin(0x123456789ULL, MaxLatency);
+    Lane.Sequence = Start;
+    for(uint32_t i = 0 ; i < CAPACITY ; i++)
+    {
+        Queued[i] = 0;
+    }
+
+    for(uint32_t Step = 0 ; Step < 20000 ; Step++)
+    {
+        uint32_t i = (uint32_t)(rand() % CAPACITY);
+
+        if( (rand() % 4) == 0 )
+        {
+            RandomCancel(i);
+        }
+        else
+        {
+            RandomPost(i, RandomDeadline());
+        }
+        Service();
+        Run((uint64_t)(rand() % 2000));
+    }
+    Run(300000);
+    CHECK(Lane.Count == 0);
+    for(uint32_t i = 0 ; i < CAPACITY ; i++)
+    {
+        CHECK(Queued[i] == 0);
+    }
+}
+
+int main(void)
+{
+    srand(13);
+
+    /* Channels other than 1 to 4, or the timestamp channel, are refused. */
+    HIERODULE_SCHED_InitLane(&Lane, TIM3, HIERODULE_TSTAMP_CHANNEL, Heap,
+        CAPACITY);
+    CHECK(Lane.Capacity == 0);
+    HIERODULE_SCHED_InitLane(&Lane, TIM3, 5, Heap, CAPACITY);
+    CHECK(Lane.Capacity == 0);
+    CHECK(HIERODULE_SCHED_Post(&Lane, &Events[0], 0, &Record, NULL) == 0);
+
+    Ties(0);
+    Ties(0xFFFFFFFCUL);
+    Ties(0x7FFFFFFDUL);
+    Late();
+    Mix(0, 0);
+    Mix(0, 0xFFFFFF00UL);
+    Mix(400, 0xFFFFFFF0UL);
+
+    return HostReport("sched");
+}
@@ -0,0 +1,306 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_step_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test of the stepper ramp computation.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <main.h>
+#include <math.h>
+#include <string.h>
+
+/*
+ * Ramps are computed for both profiles over a range of lengths, counting
+ * frequencies and step rates, and each step is compared to its ideal time:
+ * the time the profile covers n over the length of the ramp at, found in
+ * floating point by inverting the distance of the profile. With the step
+ * times being the sums of the intervals, each has to be within a count of
+ * the ideal one, give or take the time the Q30 resolution of the fraction
+ * of the distance amounts to there, and the intervals within two counts of
+ * the ideal ones where the ones before are clamped to the ARR range. The
+ * clamp count has to match the ideal intervals out of that range, save for
+ * those right at its bounds.
+ *
+ * The engine initialization is also checked to take a channel of 1 to 4
+ * only, leaving the engine unusable and the timer untouched otherwise.
+ */
+
+#include "../Src/hierodule_step.c"
+
+/* Calls to the timer module, and the last channel enabled. */
+static uint32_t Calls = 0;
+static int8_t Enabled = 0;
+
+void HIERODULE_TIM_DisableCounter(TIM_TypeDef *Timer)
+{
+    Calls++;
+    CLEAR_BIT(Timer->CR1, TIM_CR1_CEN);
+}
+
+void HIERODULE_TIM_EnableCounter(TIM_TypeDef *Timer)
+{
+    Calls++;
+    SET_BIT(Timer->CR1, TIM_CR1_CEN);
+}
+
+void HIERODULE_TIM_EnableChannel(TIM_TypeDef *Timer, int8_t Channel)
+{
+    (void)Timer;
+    Calls++;
+    Enabled = Channel;
+}
+
+void HIERODULE_TIM_Assign_Callback_UPD(TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback, void *Context)
+{
+    (void)Timer;
+    (void)Callback;
+    (void)Context;
+    Calls++;
+}
+
+void HIERODULE_TIM_ClearFlag_UPD(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+    Calls++;
+}
+
+void HIERODULE_TIM_Enable_IT_UPD(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+    Calls++;
+}
+
+#define MAX_LENGTH  5000U
+
+/* Slack for the floating point ideal times, and the error of the Q30
+ * fraction of the distance, a few units of its last place. */
+#define EPSILON     1e-6
+#define RESOLUTION  (8.0 / (double)(1UL << 30))
+
+static uint16_t Table[MAX_LENGTH];
+
+/* Fraction of the duration the profile covers a fraction of the distance
+ * at, by bisection for the S-curve. */
+static double Inverse(HIERODULE_STEP_Profile Profile, double Distance)
+{
+    double Low = 0.0;
+    double High = 1.0;
+
+    if(Profile == HIERODULE_STEP_Profile_TRAPEZOID)
+    {
+        return sqrt(Distance);
+    }
+
+    for(uint32_t i = 0 ; i < 100 ; i++)
+    {
+        double Middle = (Low + High) / 2.0;
+
+        if(2.0 * Middle * Middle * Middle - Middle * Middle * Middle * Middle
+            >= Distance)
+        {
+            High = Middle;
+        }
+        else
+        {
+            Low = Middle;
+        }
+    }
+    return High;
+}
+
+/* Derivative of the distance of the profile, over the fraction of the
+ * duration. */
+static double Slope(HIERODULE_STEP_Profile Profile, double U)
+{
+    if(Profile == HIERODULE_STEP_Profile_TRAPEZOID)
+    {
+        return 2.0 * U;
+    }
+    return 6.0 * U * U - 4.0 * U * U * U;
+}
+
+static void Ramp(HIERODULE_STEP_Profile Profile, uint32_t Length,
+    uint32_t TickFreq_Hz, uint32_t MaxRate_Hz)
+{
+    HIERODULE_STEP_Ramp Ramp;
+    double Duration = (double)(((uint64_t)Length * TickFreq_Hz * 2 +
+        MaxRate_Hz / 2) / MaxRate_Hz);
+    double Cruise = floor((double)TickFreq_Hz / MaxRate_Hz + 0.5);
+    double Previous = 0.0;
+    double Leeway = 0.0;
+    uint64_t Time = 0;
+    uint32_t Clamped;
+    uint32_t Outside = 0;
+    uint32_t Borderline = 0;
+    uint8_t Tracking = 1;
+
+    Clamped = HIERODULE_STEP_ComputeRamp(&Ramp, Table, Length, Profile,
+        TickFreq_Hz, MaxRate_Hz);
+
+    CHECK(Ramp.Table == Table);
+    CHECK(Ramp.Length == Length);
+    if(Cruise > 65536.0)
+    {
+        CHECK(Ramp.Cruise == 0xFFFFU);
+    }
+    else if(Cruise < 2.0)
+    {
+        CHECK(Ramp.Cruise == 1U);
+    }
+    else
+    {
+        CHECK(Ramp.Cruise == (uint16_t)(Cruise - 1.0));
+    }
+
+    for(uint32_t Step = 1 ; Step <= Length ; Step++)
+    {
+        double U = Inverse(Profile, (double)Step / Length);
+        double Ideal = Duration * U;
+        double Interval = Ideal - Previous;
+        double Slack = Duration * RESOLUTION / Slope(Profile, U);
+        uint16_t Value = Table[Step - 1];
+
+        Previous = Ideal;
+
+        if( (Interval > 65536.0 + 2.0) || (Interval < 2.0 - 2.0) )
+        {
+            Outside++;
+        }
+        else if( (Interval > 65536.0 - 2.0) || (Interval < 2.0 + 2.0) )
+        {
+            Borderline++;
+        }
+
+        if( (Value == 0xFFFFU) || (Value == 1U) )
+        {
+            /* Clamped, or right at the bounds. */
+            Tracking = 0;
+            CHECK( (Value == 1U) ? (Interval < 2.0 + 2.0)
+                : (Interval > 65536.0 - 2.0) );
+            Leeway = Slack;
+            continue;
+        }
+
+        CHECK(fabs((double)Value + 1.0 - Interval) <=
+            2.0 + Slack + Leeway + EPSILON);
+        Leeway = Slack;
+
+        /* The step times, as long as none of the intervals before was
+         * clamped. */
+        if(Tracking != 0)
+        {
+            Time += (uint64_t)Value + 1U;
+            CHECK((double)Time >= Ideal - EPSILON);
+            CHECK((double)Time <= Ideal + 1.0 + Slack + EPSILON);
+        }
+    }
+
+    CHECK(Clamped >= Outside);
+    CHECK(Clamped <= Outside + Borderline);
+
+    /* The ramp ends on time, at the maximum rate. */
+    if( (Clamped == 0) && (Tracking != 0) )
+    {
+        CHECK(Time == (uint64_t)Duration);
+    }
+}
+
+static void Ramps(void)
+{
+    static const uint32_t Lengths[] = { 1, 2, 3, 7, 10, 64, 100, 333, 1000,
+        MAX_LENGTH };
+    static const uint32_t Frequencies[] = { 100000UL, 250000UL, 1000000UL,
+        2000000UL, 8000000UL };
+    static const uint32_t Rates[] = { 50, 200, 1000, 4000, 20000, 100000 };
+
+    for(uint32_t p = 0 ; p < 2 ; p++)
+    {
+        for(uint32_t l = 0 ; l < sizeof(Lengths) / sizeof(Lengths[0]) ; l++)
+        {
+            for(uint32_t f = 0 ;
+                f < sizeof(Frequencies) / sizeof(Frequencies[0]) ; f++)
+            {
+                for(uint32_t r = 0 ; r < sizeof(Rates) / sizeof(Rates[0]) ;
+                    r++)
+                {
+                    Ramp((HIERODULE_STEP_Profile)p, Lengths[l],
+                        Frequencies[f], Rates[r]);
+                }
+            }
+        }
+    }
+}
+
+/* Known clamps: the first steps of a ramp counted at 72 MHz outlast the
+ * ARR range, and a rate close to the counting frequency is out of it. */
+static void Clamps(void)
+{
+    HIERODULE_STEP_Ramp Ramp;
+
+    CHECK(HIERODULE_STEP_ComputeRamp(&Ramp, Table, 100,
+        HIERODULE_STEP_Profile_TRAPEZOID, 72000000UL, 20000UL) > 0);
+    CHECK(Table[0] == 0xFFFFU);
+    CHECK(Table[99] < 0xFFFFU);
+
+    CHECK(HIERODULE_STEP_ComputeRamp(&Ramp, Table, 10,
+        HIERODULE_STEP_Profile_SCURVE, 1000000UL, 800000UL) > 0);
+    CHECK(Ramp.Cruise == 1U);
+    CHECK(Table[9] == 1U);
+}
+
+static void Channels(void)
+{
+    static HIERODULE_STEP_Move Moves[4];
+    HIERODULE_STEP_Engine Engine;
+    HIERODULE_STEP_Ramp Ramp;
+    TIM_TypeDef Before;
+
+    CHECK(HIERODULE_STEP_ComputeRamp(&Ramp, Table, 10,
+        HIERODULE_STEP_Profile_TRAPEZOID, 1000000UL, 1000UL) == 0);
+
+    for(uint8_t Channel = 0 ; Channel <= 6 ; Channel += 5)
+    {
+        memset(TIM3, 0, sizeof(*TIM3));
+        memcpy(&Before, (const void*)TIM3, sizeof(Before));
+        Calls = 0;
+
+        HIERODULE_STEP_Init(&Engine, TIM3, Channel, 5, Moves, 4);
+        CHECK(Calls == 0);
+        CHECK(memcmp(&Before, (const void*)TIM3, sizeof(Before)) == 0);
+        CHECK(Engine.Capacity == 0);
+        CHECK(HIERODULE_STEP_Post(&Engine, &Ramp, 100) == 0);
+        CHECK(HIERODULE_STEP_GetPending(&Engine) == 0);
+        CHECK(HIERODULE_STEP_IsRunning(&Engine) == 0);
+        CHECK(memcmp(&Before, (const void*)TIM3, sizeof(Before)) == 0);
+    }
+
+    for(uint8_t Channel = 1 ; Channel <= 4 ; Channel++)
+    {
+        volatile uint32_t *ModeRegister = (Channel < 3) ? &TIM3->CCMR1
+            : &TIM3->CCMR2;
+        uint32_t Shift = (uint32_t)((Channel - 1) & 1) << 3;
+
+        memset(TIM3, 0, sizeof(*TIM3));
+        HIERODULE_STEP_Init(&Engine, TIM3, Channel, 5, Moves, 4);
+        CHECK(Engine.Capacity == 4);
+        CHECK(Engine.Compare == &TIM3->CCR1 + (Channel - 1));
+        CHECK(Enabled == (int8_t)Channel);
+        CHECK(*ModeRegister == (PWM_PRELOAD << Shift));
+        CHECK(READ_BIT(TIM3->CR1, TIM_CR1_ARPE) != 0);
+    }
+}
+
+int main(void)
+{
+    Ramps();
+    Clamps();
+    Channels();
+
+    return HostReport("step");
+}
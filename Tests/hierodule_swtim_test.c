@@ -0,0 +1,491 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_swtim_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test and benchmark of the software timer module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#define _POSIX_C_SOURCE 199309L
+
+#include <host_test.h>
+#include <main.h>
+#include <time.h>
+#include "../Src/hierodule_swtim.c"
+
+/*
+ * Timers are armed with delays around the level boundaries of the wheel and
+ * past its span, so they get cascaded and parked, from ticks around the same
+ * boundaries and the wrap of the tick. Every callback checks it's performed
+ * on the very tick its timer expires at.
+ *
+ * In periodic mode, the update callback is called once per tick. In tickless
+ * mode, the counter of TIM2 is moved on straight to the next match of CCR1,
+ * which raises CC1IF the way the hardware does, as does a CC1G write to EGR,
+ * and the callback is called once the flag is pending with CC1IE set. The
+ * IRQ may be taken late by a random number of counts, in which case the
+ * callbacks may be as late, but the wheel still has to expire them on their
+ * own tick. With the wheel empty, the tick has to keep counting across the
+ * wraps of the counter.
+ *
+ * The benchmark arms 10000 periodic timers and times each tick of the wheel
+ * in periodic mode, printing the mean, 99th percentile and largest cost.
+ */
+
+#define POOL_SIZE       10000U
+#define BENCH_TICKS     (1UL << 18)
+#define BUCKET_NS       16U
+#define BUCKETS         4096U
+
+/* The callback the module assigned to TIM2, and the pending CC1IF. */
+static HIERODULE_TIM_Callback Handler = NULL;
+static uint32_t Flag = 0;
+
+void HIERODULE_TIM_Assign_Callback_UPD(TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback, void *Context)
+{
+    (void)Timer;
+    (void)Context;
+    Handler = Callback;
+}
+
+void HIERODULE_TIM_Assign_Callback_CC1(TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback, void *Context)
+{
+    (void)Timer;
+    (void)Context;
+    Handler = Callback;
+}
+
+void HIERODULE_TIM_Enable_IT_UPD(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+}
+
+void HIERODULE_TIM_ClearFlag_CC1(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+    Flag = 0;
+}
+
+/* Counts elapsed in tickless mode, the count tick 0 was at, the count the
+ * pending IRQ gets taken at and the most counts it may be late by. */
+static uint64_t Time = 0;
+static uint64_t Origin = 0;
+static uint64_t ServiceAt = 0;
+static uint32_t Latency = 0;
+
+/* Expected tick and number of calls of each timer. */
+typedef struct
+{
+    uint32_t Due;
+    uint32_t Fired;
+    uint32_t Expected;
+} Record;
+
+static HIERODULE_SWTIM_Timer Pool[POOL_SIZE];
+static HIERODULE_SWTIM_Timer *Timers[POOL_SIZE];
+static Record Records[POOL_SIZE];
+
+/* Ticks the callbacks may be late by, the most they were, and the number of
+ * callbacks performed. */
+static uint32_t Slack = 0;
+static uint32_t Latest = 0;
+static unsigned long Expiries = 0;
+
+static uint32_t Random(void)
+{
+    return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+static uint32_t Current(void)
+{
+    return (WheelMode == HIERODULE_SWTIM_Mode_TICKLESS) ?
+        (uint32_t)(Time - Origin) : Now;
+}
+
+static void Expire(HIERODULE_SWTIM_Timer *Timer, void *Context)
+{
+    Record *Expired = Context;
+    uint32_t Late = Current() - Expired->Due;
+
+    CHECK(Now == Expired->Due);
+    CHECK(Late <= Slack);
+    Latest = (Late > Latest) ? Late : Latest;
+    Expired->Fired++;
+    Expired->Due += Timer->Period;
+    Expiries++;
+}
+
+/* Takes the pending IRQ, if it's due and enabled, along with whatever an
+ * EGR write raises meanwhile. */
+static void Raise(void)
+{
+    Flag = 1;
+    ServiceAt = Time + ((Latency != 0) ? (Random() % (Latency + 1U)) : 0);
+}
+
+static void Service(void)
+{
+    while(1)
+    {
+        if( (TIM2->EGR & TIM_EGR_CC1G) != 0 )
+        {
+            TIM2->EGR = 0;
+            if(Flag == 0)
+            {
+                Raise();
+            }
+        }
+        if( (Flag == 0) || ((TIM2->DIER & TIM_DIER_CC1IE) == 0) ||
+            (Time < ServiceAt) )
+        {
+            break;
+        }
+        Flag = 0;
+        Handler(TIM2, TIM_SR_CC1IF, NULL);
+    }
+}
+
+/* Moves the counter on, stopping at each match of CCR1 and at the count
+ * the pending IRQ is taken at. */
+static void Run(uint64_t Counts)
+{
+    uint64_t End = Time + Counts;
+
+    Service();
+    while(Time < End)
+    {
+        uint64_t Match = Time +
+            (((TIM2->CCR1 - TIM2->CNT - 1U) & COUNT_MASK) + 1U);
+        uint64_t Next = End;
+
+        if( (Flag == 0) && (Match < Next) )
+        {
+            Next = Match;
+        }
+        if( (Flag != 0) && (ServiceAt > Time) && (ServiceAt < Next) )
+        {
+            Next = ServiceAt;
+        }
+        Time = Next;
+        TIM2->CNT = (uint32_t)(Time & COUNT_MASK);
+        if( (Flag == 0) && (Time == Match) )
+        {
+            Raise();
+        }
+        Service();
+    }
+}
+
+/* Advances the wheel by a number of ticks in either mode. */
+static void Advance(uint32_t Ticks)
+{
+    if(WheelMode == HIERODULE_SWTIM_Mode_TICKLESS)
+    {
+        Run(Ticks);
+        return;
+    }
+    while(Ticks-- > 0)
+    {
+        Handler(TIM2, TIM_SR_UIF, NULL);
+    }
+}
+
+/* Starts the module with the tick at Base. */
+static void Begin(HIERODULE_SWTIM_Mode Mode, uint32_t Base, uint32_t Count)
+{
+    TIM2->CNT = (uint32_t)(Time & COUNT_MASK);
+    TIM2->CCR1 = 0;
+    TIM2->DIER = 0;
+    TIM2->EGR = 0;
+    Flag = (Mode == HIERODULE_SWTIM_Mode_TICKLESS) ? 1 : 0;
+    HIERODULE_SWTIM_Init(TIM2, Pool, POOL_SIZE, Mode);
+    CHECK(Flag == 0);
+    CHECK(NextEvent() == 0);
+
+    Now = Base;
+    Horizon = Base;
+    Origin = Time - Base;
+    Latest = 0;
+    for(uint32_t i = 0 ; i < Count ; i++)
+    {
+        Timers[i] = HIERODULE_SWTIM_Create(&Expire, &Records[i]);
+        CHECK(Timers[i] != NULL);
+    }
+}
+
+static void Arm(uint32_t i, uint32_t Delay, uint32_t Period)
+{
+    Delay = (Delay == 0) ? 1 : ((Delay > MAX_DELAY) ? MAX_DELAY : Delay);
+    Period = (Period > MAX_DELAY) ? MAX_DELAY : Period;
+
+    Records[i].Due = Current() + Delay;
+    Records[i].Fired = 0;
+    Records[i].Expected = 1;
+    HIERODULE_SWTIM_Start(Timers[i], Delay, Period);
+    if(WheelMode == HIERODULE_SWTIM_Mode_TICKLESS)
+    {
+        Service();
+    }
+}
+
+/* Checks one-shot timers fired as often as expected, and periodic ones
+ * haven't missed a period. */
+static void Verify(uint32_t Count)
+{
+    for(uint32_t i = 0 ; i < Count ; i++)
+    {
+        if( (Timers[i]->Period == 0) || (Records[i].Expected == 0) )
+        {
+            CHECK(Records[i].Fired == Records[i].Expected);
+            CHECK(HIERODULE_SWTIM_IsArmed(Timers[i]) == 0);
+        }
+        else
+        {
+            CHECK(Records[i].Fired >= 1);
+            CHECK( (int32_t)(Records[i].Due + Slack - Current()) > 0 );
+            CHECK(HIERODULE_SWTIM_IsArmed(Timers[i]) == 1);
+        }
+    }
+}
+
+static const uint32_t Bases[] = { 0, 1, 63, 4095, 262143, 16777215,
+    0xFFFFFFC0UL, 0xFFFFFFFFUL };
+
+/* Delays one either side of each level boundary and of the wheel span, so
+ * the timers above it get parked, and a few random ones. */
+static uint32_t Delays(uint32_t *Delay, uint32_t *Period, uint8_t Parking)
+{
+    uint32_t Count = 0;
+
+    for(uint32_t Span = 64 ; Span <= (Parking ? WHEEL_SPAN : 262144U) ;
+        Span <<= 6)
+    {
+        for(uint32_t k = 0 ; k < 3 ; k++)
+        {
+            Delay[Count] = Span - 1 + k;
+            Period[Count++] = 0;
+            Delay[Count] = Span - 1 + k;
+            Period[Count++] = Span - 1 + k;
+        }
+        Delay[Count] = (Span <= 4096U) ? (Span * 63 + 1) : (Span * 2 + 1);
+        Period[Count++] = 0;
+    }
+    Delay[Count] = 0;
+    Period[Count++] = Parking ? 4097 : 1;
+    Delay[Count] = 1;
+    Period[Count++] = 63;
+    for(uint32_t k = 0 ; k < 200 ; k++)
+    {
+        Delay[Count] = 1 + Random() % 300000U;
+        Period[Count++] = (k & 1) ? (SLOTS + Random() % 5000U) : 0;
+    }
+    return Count;
+}
+
+/* Arms the timers, stops or restarts some of them before they're due, and
+ * runs the wheel until every one-shot timer has fired. */
+static void Scenario(HIERODULE_SWTIM_Mode Mode, uint32_t Base,
+    uint8_t Parking, uint32_t MaxLatency)
+{
+    static uint32_t Delay[POOL_SIZE];
+    static uint32_t Period[POOL_SIZE];
+    uint32_t Count = Delays(Delay, Period, Parking);
+    uint32_t Last = 0;
+
+    Latency = MaxLatency;
+    Slack = MaxLatency;
+    Begin(Mode, Base, Count);
+    for(uint32_t i = 0 ; i < Count ; i++)
+    {
+        Arm(i, Delay[i], Period[i]);
+        Last = (Delay[i] + Period[i] > Last) ? (Delay[i] + Period[i]) : Last;
+    }
+
+    Advance(32);
+    for(uint32_t i = 0 ; i < Count ; i++)
+    {
+        if( (Delay[i] <= 64) || (Records[i].Fired != 0) )
+        {
+            continue;
+        }
+        if( (i % 7) == 3 )
+        {
+            HIERODULE_SWTIM_Stop(Timers[i]);
+            Records[i].Expected = 0;
+        }
+        else if( (i % 7) == 5 )
+        {
+            HIERODULE_SWTIM_Restart(Timers[i]);
+            Records[i].Due = Current() + Delay[i];
+            Service();
+        }
+    }
+
+    Advance(Last + 32 + MaxLatency);
+    Verify(Count);
+}
+
+/* Delays up to the largest one, parked many times over, tickless only as
+ * the wheel is processed on demand there. */
+static void Parked(uint32_t Base, uint32_t MaxLatency)
+{
+    static const uint32_t Delay[] = { WHEEL_SPAN - 1, WHEEL_SPAN,
+        WHEEL_SPAN + 1, 2 * WHEEL_SPAN + 63, 3 * WHEEL_SPAN - 1,
+        0x40000005UL, MAX_DELAY - 1, MAX_DELAY, 0xFFFFFFFFUL };
+    uint32_t Count = sizeof(Delay) / sizeof(Delay[0]);
+
+    Latency = MaxLatency;
+    Slack = MaxLatency;
+    Begin(HIERODULE_SWTIM_Mode_TICKLESS, Base, Count + 1);
+    for(uint32_t i = 0 ; i < Count ; i++)
+    {
+        Arm(i, Delay[i], 0);
+    }
+    Arm(Count, 0x11000000UL, 0x11000000UL);
+
+    Advance(MAX_DELAY + MaxLatency + 1);
+    Verify(Count + 1);
+    CHECK(Records[Count].Fired == 7);
+}
+
+/* The tick keeps counting across wraps of the counter while the wheel is
+ * empty, from the start and after the last timer expired, and timers armed
+ * afterwards still expire on their own tick. */
+static void Idle(uint32_t Base, uint32_t MaxLatency)
+{
+    static const uint32_t Spans[] = { 70000UL, 0x10000UL, 0x10001UL,
+        0x7FFFUL, 0x8000UL, 5UL * 0x10000UL + 123UL };
+
+    Latency = MaxLatency;
+    Slack = MaxLatency;
+    Begin(HIERODULE_SWTIM_Mode_TICKLESS, Base, 1);
+    CHECK(HIERODULE_SWTIM_GetTick() == Base);
+
+    for(uint32_t s = 0 ; s < sizeof(Spans) / sizeof(Spans[0]) ; s++)
+    {
+        Advance(Spans[s]);
+        CHECK(HIERODULE_SWTIM_GetTick() == Current());
+
+        Arm(0, 1 + Random() % 100000U, 0);
+        Advance(100000U + MaxLatency);
+        Verify(1);
+        CHECK(HIERODULE_SWTIM_GetTick() == Current());
+    }
+}
+
+/* The tick the wheel gets processed at next is never past the nearest
+ * expiry. */
+static void Bounds(void)
+{
+    for(uint32_t Trial = 0 ; Trial < 5000 ; Trial++)
+    {
+        uint32_t Count = 1 + Random() % 8U;
+        uint32_t Nearest = UINT32_MAX;
+        uint32_t Next;
+
+        Begin(HIERODULE_SWTIM_Mode_PERIODIC, Random(), Count);
+        for(uint32_t i = 0 ; i < Count ; i++)
+        {
+            uint32_t Delay = 1 + (Random() & ((2U << (Random() % 31U)) - 1));
+
+            Arm(i, Delay, 0);
+            Delay = (Delay > MAX_DELAY) ? MAX_DELAY : Delay;
+            Nearest = (Delay < Nearest) ? Delay : Nearest;
+        }
+        Next = NextEvent();
+        CHECK(Next >= 1);
+        CHECK(Next <= Nearest);
+        if(Nearest < SLOTS - (Now & SLOT_MASK))
+        {
+            CHECK(Next == Nearest);
+        }
+        for(uint32_t i = 0 ; i < Count ; i++)
+        {
+            HIERODULE_SWTIM_Stop(Timers[i]);
+        }
+        CHECK(NextEvent() == 0);
+    }
+}
+
+static uint64_t Nanoseconds(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return (uint64_t)Now.tv_sec * 1000000000ULL + (uint64_t)Now.tv_nsec;
+}
+
+static void Benchmark(void)
+{
+    static const uint32_t Spans[] = { 1000, 50000, 1000000, 20000000 };
+    static uint32_t Histogram[BUCKETS];
+    uint64_t Total = 0;
+    uint64_t Slowest = 0;
+    uint32_t Percentile = 0;
+    uint32_t Seen = 0;
+    unsigned long Before;
+
+    Latency = 0;
+    Slack = 0;
+    Begin(HIERODULE_SWTIM_Mode_PERIODIC, Random(), POOL_SIZE);
+    for(uint32_t i = 0 ; i < POOL_SIZE ; i++)
+    {
+        uint32_t Period = 1 + Random() % Spans[i % 4];
+
+        Arm(i, 1 + Random() % ((Period < BENCH_TICKS) ? Period : BENCH_TICKS),
+            Period);
+    }
+
+    Before = Expiries;
+    for(uint32_t t = 0 ; t < BENCH_TICKS ; t++)
+    {
+        uint64_t Start = Nanoseconds();
+        uint64_t Took;
+
+        Handler(TIM2, TIM_SR_UIF, NULL);
+        Took = Nanoseconds() - Start;
+        Total += Took;
+        Slowest = (Took > Slowest) ? Took : Slowest;
+        Histogram[(Took / BUCKET_NS < BUCKETS) ? (Took / BUCKET_NS) :
+            (BUCKETS - 1)]++;
+    }
+    Verify(POOL_SIZE);
+
+    while( (Percentile < BUCKETS) && (Seen < BENCH_TICKS / 100 * 99) )
+    {
+        Seen += Histogram[Percentile++];
+    }
+    printf("swtim: %u timers, %.2f expiries per tick, %.1f ns mean, "
+        "%u ns 99th percentile, %lu ns max per tick, %u ticks late\n",
+        POOL_SIZE, (double)(Expiries - Before) / BENCH_TICKS,
+        (double)Total / BENCH_TICKS, Percentile * BUCKET_NS,
+        (unsigned long)Slowest, Latest);
+}
+
+int main(void)
+{
+    srand(11);
+
+    for(uint32_t b = 0 ; b < sizeof(Bases) / sizeof(Bases[0]) ; b++)
+    {
+        uint8_t Parking = ( (b == 0) || (b == 6) ) ? 1 : 0;
+
+        Scenario(HIERODULE_SWTIM_Mode_PERIODIC, Bases[b], Parking, 0);
+        Scenario(HIERODULE_SWTIM_Mode_TICKLESS, Bases[b], Parking, 0);
+        Scenario(HIERODULE_SWTIM_Mode_TICKLESS, Bases[b], Parking, 300);
+        Parked(Bases[b], 0);
+    }
+    Parked(0x12345678UL, 1000);
+    Idle(0, 0);
+    Idle(0xFFFF0000UL, 0);
+    Idle(0x12345678UL, 1000);
+    Bounds();
+    Benchmark();
+
+    return HostReport("swtim");
+}
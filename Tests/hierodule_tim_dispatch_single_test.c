@@ -0,0 +1,14 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tim_dispatch_single_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host benchmark of the interrupt dispatch of the timer
+  * module, servicing a single flag per IRQ entry.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#define DISPATCH_SINGLE
+#include "hierodule_tim_dispatch_test.c"
@@ -0,0 +1,212 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tim_dispatch_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host benchmark of the interrupt dispatch of the timer
+  * module, servicing every pending flag per IRQ entry.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#ifndef DISPATCH_SINGLE
+#define HIERODULE_TIM_DISPATCH_ALL_PENDING
+#define DISPATCH_NAME "tim_dispatch"
+#else
+#define DISPATCH_NAME "tim_dispatch_single"
+#endif
+
+#include <host_test.h>
+#include <main.h>
+
+/*
+ * Bursts of the update and capture compare flags of TIM2, set together, are
+ * serviced the way the NVIC would, entering the IRQ for as long as a flag is
+ * pending with its interrupt enabled. The same test is built with a single
+ * flag serviced per entry by hierodule_tim_dispatch_single_test.c.
+ *
+ * Exception entries and timer register accesses are counted per burst, and
+ * turned into cycles with the figures of a Cortex-M3: 12 cycles to enter,
+ * 6 to tail-chain into the next entry and 10 to return, plus 2 per access,
+ * about what an APB access costs. The handlers themselves are left out, as
+ * they're the same either way.
+ */
+
+#define ENTRY_CYCLES    12UL
+#define CHAIN_CYCLES    6UL
+#define RETURN_CYCLES   10UL
+#define ACCESS_CYCLES   2UL
+
+/* Timer register accesses, and the status register cleared by writing 0. */
+static unsigned long Accesses = 0;
+
+static inline uint8_t IsTimerSR(volatile uint32_t *Register)
+{
+    uintptr_t Offset = (uintptr_t)Register - (uintptr_t)HostPeripherals;
+
+    return ( (Offset < sizeof(HostPeripherals)) &&
+        ((Offset & 0x3FFU) == offsetof(TIM_TypeDef, SR)) ) ? 1 : 0;
+}
+
+static inline uint32_t HostRead(volatile uint32_t *Register)
+{
+    Accesses++;
+    return *Register;
+}
+
+static inline void HostWrite(volatile uint32_t *Register, uint32_t Value)
+{
+    Accesses++;
+    if(IsTimerSR(Register))
+    {
+        *Register &= Value;
+    }
+    else
+    {
+        *Register = Value;
+    }
+}
+
+#undef READ_REG
+#undef WRITE_REG
+#define READ_REG(REG) HostRead(&(REG))
+#define WRITE_REG(REG, VAL) HostWrite(&(REG), (uint32_t)(VAL))
+
+#include "../Src/hierodule_tim.c"
+
+/* Flags in the order their handlers ran. */
+static uint32_t Order[8];
+static uint32_t Served = 0;
+
+static void Serviced(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    (void)Timer;
+    (void)Context;
+    CHECK(Served < 8);
+    if(Served < 8)
+    {
+        Order[Served++] = Flags;
+    }
+}
+
+/* Status register as seen by the handlers. */
+static uint32_t SeenSR = 0;
+
+static void SeenByCallback(TIM_TypeDef *Timer, uint32_t Flags, void *Context)
+{
+    (void)Flags;
+    (void)Context;
+    SeenSR = Timer->SR;
+}
+
+static void SeenByISR(void)
+{
+    SeenSR = TIM2->SR;
+}
+
+#define SOURCES (TIM_SR_UIF | TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF | \
+    TIM_SR_CC4IF)
+
+/* Runs the IRQ until nothing's pending, returns the entries. */
+static uint32_t Burst(uint32_t Flags)
+{
+    uint32_t Entries = 0;
+
+    TIM2->SR = Flags;
+    while( (TIM2->SR & TIM2->DIER & SOURCES) != 0 )
+    {
+        TIM2_IRQHandler();
+        CHECK(++Entries <= 5);
+        if(Entries > 5)
+        {
+            break;
+        }
+    }
+    return Entries;
+}
+
+static uint32_t Count(uint32_t Flags)
+{
+    return (uint32_t)__builtin_popcount(Flags);
+}
+
+int main(void)
+{
+    unsigned long Entries[6] = { 0 };
+    unsigned long Cycles[6] = { 0 };
+    unsigned long Bursts[6] = { 0 };
+
+    HIERODULE_TIM_Assign_Callback_UPD(TIM2, &Serviced, NULL);
+    HIERODULE_TIM_Assign_Callback_CC1(TIM2, &Serviced, NULL);
+    HIERODULE_TIM_Assign_Callback_CC2(TIM2, &Serviced, NULL);
+    HIERODULE_TIM_Assign_Callback_CC3(TIM2, &Serviced, NULL);
+    HIERODULE_TIM_Assign_Callback_CC4(TIM2, &Serviced, NULL);
+    HIERODULE_TIM_Enable_IT_UPD(TIM2);
+    HIERODULE_TIM_Enable_IT_CC1(TIM2);
+    HIERODULE_TIM_Enable_IT_CC2(TIM2);
+    HIERODULE_TIM_Enable_IT_CC3(TIM2);
+    HIERODULE_TIM_Enable_IT_CC4(TIM2);
+
+    /* Every non-empty subset of the five flags. */
+    for(uint32_t Subset = 1 ; Subset < 32 ; Subset++)
+    {
+        uint32_t Flags = (Subset & 1U) | ((Subset >> 1) << TIM_SR_CC1IF_Pos);
+        uint32_t Size = Count(Flags);
+        uint32_t Entered;
+
+        Served = 0;
+        Accesses = 0;
+        Entered = Burst(Flags);
+
+        /* Every flag is serviced once, from update up to channel 4. */
+        CHECK(Served == Size);
+        for(uint32_t i = 0 ; (i < Served) && (i < 8) ; i++)
+        {
+            CHECK(Flags & Order[i]);
+            CHECK( (i == 0) || (Order[i] > Order[i - 1]) );
+        }
+        CHECK(TIM2->SR == 0);
+
+        #ifdef HIERODULE_TIM_DISPATCH_ALL_PENDING
+        CHECK(Entered == 1);
+        #else
+        CHECK(Entered == Size);
+        #endif
+
+        Entries[Size] += Entered;
+        Cycles[Size] += ENTRY_CYCLES + CHAIN_CYCLES * (Entered - 1) +
+            RETURN_CYCLES + ACCESS_CYCLES * Accesses;
+        Bursts[Size]++;
+    }
+
+    /* A flag whose interrupt is disabled is left alone. */
+    HIERODULE_TIM_Disable_IT_CC2(TIM2);
+    Served = 0;
+    Burst(TIM_SR_CC1IF | TIM_SR_CC2IF);
+    CHECK(Served == 1);
+    CHECK(TIM2->SR == TIM_SR_CC2IF);
+
+    /* Callbacks find their flag cleared, void ISRs find it set unless
+     * they're set to have it cleared first too. */
+    HIERODULE_TIM_Assign_Callback_CC1(TIM2, &SeenByCallback, NULL);
+    Burst(TIM_SR_CC1IF);
+    CHECK((SeenSR & TIM_SR_CC1IF) == 0);
+    HIERODULE_TIM_Assign_ISR_CC1(TIM2, &SeenByISR);
+    Burst(TIM_SR_CC1IF);
+    #ifdef HIERODULE_TIM_CLEAR_BEFORE_HANDLER
+    CHECK((SeenSR & TIM_SR_CC1IF) == 0);
+    #else
+    CHECK((SeenSR & TIM_SR_CC1IF) == TIM_SR_CC1IF);
+    #endif
+    CHECK((TIM2->SR & TIM_SR_CC1IF) == 0);
+
+    for(uint32_t Size = 1 ; Size <= 5 ; Size++)
+    {
+        printf("%s: %u flags, %.2f entries, %.1f cycles per burst\n",
+            DISPATCH_NAME, Size, (double)Entries[Size] / Bursts[Size],
+            (double)Cycles[Size] / Bursts[Size]);
+    }
+
+    return HostReport(DISPATCH_NAME);
+}
@@ -0,0 +1,207 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tim_getters_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test of the integer duty cycle and period getters
+  * of the timer module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <math.h>
+#include "../Src/hierodule_tim.c"
+
+/*
+ * For a few kernel clocks, PSC is swept over the prescalers that divide the
+ * kernel clock, so the base frequency the double getters work with is
+ * exact, and ARR over the 16 bit range, written via the setters. The
+ * integer getters are compared against the double ones, turned into the
+ * same units: the duty cycle of every channel, for compare values across
+ * and past the period, and the period in ticks and nanoseconds. The duty
+ * cycles are also compared against the exact quotient, which they have to
+ * match on 16 bit values and may exceed by one LSB beyond.
+ *
+ * The setters have to leave the reciprocal of the ARR they wrote in the
+ * descriptor, so that the getters don't divide, and the getters have to
+ * work the same with ARR written to the register directly, without
+ * touching the descriptor.
+ */
+
+static const uint32_t Clocks[] = { 8000000UL, 48000000UL, 72000000UL };
+
+static void SetClock(uint32_t Clock)
+{
+    SystemCoreClock = Clock;
+    HIERODULE_TIM_InvalidateClockCache();
+}
+
+static void SetCompare(TIM_TypeDef *Timer, uint32_t Compare)
+{
+    Timer->CCR1 = Compare;
+    Timer->CCR2 = Compare / 2;
+    Timer->CCR3 = Compare / 3;
+    Timer->CCR4 = Compare + 1;
+}
+
+static uint64_t Reciprocal(uint32_t Reload)
+{
+    uint64_t Divisor = (uint64_t)Reload + 1;
+
+    return ((1ULL << 48) + Divisor - 1) / Divisor;
+}
+
+/* The reciprocal of the current ARR is in the descriptor. */
+static uint8_t Cached(TIM_TypeDef *Timer)
+{
+    TIM_Descriptor *Descriptor = &TimerDescriptor[GetTimerID(Timer)];
+
+    return ( (Descriptor->CachedReload == Timer->ARR) &&
+        (Descriptor->ReloadReciprocal == Reciprocal(Timer->ARR)) ) ? 1 : 0;
+}
+
+static void Duty(TIM_TypeDef *Timer, uint32_t Wide)
+{
+    uint32_t Reload = Timer->ARR;
+
+    for(uint8_t Channel = 1 ; Channel <= 4 ; Channel++)
+    {
+        uint32_t Compare = *ChannelSelector(Timer,
+            TimerChannel_CCR[Channel-1]);
+        uint32_t Q16 = HIERODULE_TIM_GetDutyCycle_Q16_16(Timer, Channel);
+        uint64_t Exact = (Compare > Reload) ? 65536U :
+            ((uint64_t)Compare << 16) / ((uint64_t)Reload + 1);
+
+        CHECK(HIERODULE_TIM_GetDutyCycle_Q15(Timer, Channel) == (Q16 >> 1));
+        if(Wide == 0)
+        {
+            CHECK(Q16 == Exact);
+        }
+        else
+        {
+            CHECK( (Q16 == Exact) || (Q16 == Exact + 1) );
+        }
+
+        /* The double getter divides by ARR, rather than ARR+1. */
+        if( (Reload > 0) && (Compare <= Reload) )
+        {
+            double Expected = HIERODULE_TIM_GetDutyCycle(Timer, Channel) *
+                (double)Reload / ((double)Reload + 1.0) * 65536.0;
+
+            CHECK((double)Q16 >= Expected - 1.0 - 1e-6);
+            CHECK((double)Q16 <= Expected + (double)Wide + 1e-6);
+        }
+    }
+}
+
+static void Period(TIM_TypeDef *Timer, uint32_t Clock)
+{
+    double Seconds = HIERODULE_TIM_GetPeriod(Timer);
+    uint64_t Ticks = HIERODULE_TIM_GetPeriod_Ticks(Timer);
+    uint64_t Period_ns = HIERODULE_TIM_GetPeriod_ns(Timer);
+
+    CHECK(Ticks == ((uint64_t)Timer->PSC + 1) * ((uint64_t)Timer->ARR + 1));
+    CHECK(fabs((double)Ticks - Seconds * Clock) <= (double)Ticks * 1e-12);
+    CHECK(fabs((double)Period_ns - Seconds * 1e9) <=
+        1.0 + (double)Ticks / (double)(1UL << 24));
+}
+
+static void Sweep(TIM_TypeDef *Timer, uint32_t Clock)
+{
+    static const uint32_t Reloads[] = { 0, 1, 2, 3, 99, 255, 256, 999, 4095,
+        0x7FFF, 0x8000, 0xFFFE, 0xFFFF };
+
+    SetClock(Clock);
+    for(uint32_t Divider = 1 ; Divider <= 65536 ; Divider++)
+    {
+        if( (Clock % Divider) != 0 )
+        {
+            continue;
+        }
+        Timer->PSC = Divider - 1;
+
+        for(uint32_t r = 0 ; r < sizeof(Reloads) / sizeof(Reloads[0]) + 8 ;
+            r++)
+        {
+            uint32_t Reload = (r < sizeof(Reloads) / sizeof(Reloads[0])) ?
+                Reloads[r] : (uint32_t)(rand() % 0x10000);
+            uint32_t Compares[] = { 0, 1, Reload / 3, Reload / 2, Reload - 1,
+                Reload, (uint32_t)rand() % (Reload + 1) };
+
+            WriteReload(Timer, Reload);
+            CHECK(Timer->ARR == Reload);
+            CHECK(Cached(Timer));
+
+            for(uint32_t c = 0 ; c < sizeof(Compares) / sizeof(Compares[0]) ;
+                c++)
+            {
+                SetCompare(Timer, Compares[c]);
+                Duty(Timer, 0);
+            }
+            Period(Timer, Clock);
+        }
+    }
+}
+
+/* The setters precompute the reciprocal of what they write. */
+static void Setters(void)
+{
+    HIERODULE_TIM_Chain Pair = { TIM2, TIM3 };
+
+    SetClock(72000000UL);
+    for(uint32_t i = 0 ; i < 2000 ; i++)
+    {
+        HIERODULE_TIM_SetFrequency_mHz(TIM3, 1000U +
+            (uint64_t)rand() * 997U % 2000000000U);
+        CHECK(Cached(TIM3));
+        HIERODULE_TIM_SetPeriod_ns(TIM4, 100U + (uint64_t)rand() * 13U);
+        CHECK(Cached(TIM4));
+        HIERODULE_TIM_SetFrequency(TIM3, 20.0 + (double)(rand() % 100000));
+        CHECK(Cached(TIM3));
+        HIERODULE_TIM_SetPeriod(TIM4, 1e-4 + (double)(rand() % 1000) * 1e-5);
+        CHECK(Cached(TIM4));
+        HIERODULE_TIM_SetChainPeriod_ns(&Pair, 1000000U +
+            (uint64_t)rand() * 1000U);
+        CHECK(Cached(TIM2) && Cached(TIM3));
+    }
+    CHECK(HIERODULE_TIM_InitChain(&Pair, TIM2, TIM3) == 1);
+    CHECK(Cached(TIM2) && Cached(TIM3));
+}
+
+/* ARR written to the register directly, including 32 bit values, is read
+ * right, and the cache is left as the setters left it. */
+static void Direct(void)
+{
+    TIM_Descriptor *Descriptor = &TimerDescriptor[GetTimerID(TIM2)];
+
+    SetClock(72000000UL);
+    WriteReload(TIM2, 999);
+    for(uint32_t i = 0 ; i < 200000 ; i++)
+    {
+        uint32_t Reload = (i & 1) ? (uint32_t)rand() % 0x10000 :
+            ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+
+        TIM2->ARR = Reload;
+        SetCompare(TIM2, (i % 5 == 0) ? Reload : ((uint32_t)rand() << 16) %
+            (Reload == 0xFFFFFFFFUL ? Reload : Reload + 1));
+        Duty(TIM2, (Reload > 0xFFFFU) ? 1 : 0);
+        CHECK(Descriptor->CachedReload == 999);
+        CHECK(Descriptor->ReloadReciprocal == Reciprocal(999));
+    }
+}
+
+int main(void)
+{
+    srand(23);
+
+    for(uint32_t c = 0 ; c < sizeof(Clocks) / sizeof(Clocks[0]) ; c++)
+    {
+        Sweep(TIM3, Clocks[c]);
+    }
+    Setters();
+    Direct();
+
+    return HostReport("tim_getters");
+}
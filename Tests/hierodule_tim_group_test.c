@@ -0,0 +1,343 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tim_group_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Simulation test of the timer groups of the timer module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <main.h>
+
+/*
+ * TIM2 masters a group of TIM3, TIM4 and TIM1, all clocked off the same
+ * kernel clock, simulated one clock at a time: the prescaler and the counter
+ * of each enabled timer count up, wrapping past ARR with an update event
+ * that latches the prescaler, a UG write latches it too and clears both,
+ * raising UIF unless URS is set, and a rising edge of the master's counter
+ * enable starts the members in trigger mode on the input wired to it, after
+ * a resynchronization delay.
+ *
+ * Every register access of the module takes a couple of kernel clocks, and
+ * is randomly stretched as if an interrupt came in, so nothing that depends
+ * on the timing of the software would hold. Groups are started with random
+ * prescalers, reloads and phases, stopped at random points and started
+ * again. The members have to start on the same clock, the master a fixed
+ * delay before them, and each has to wrap its phase ahead of its own start.
+ */
+
+#define RESYNC          2U
+#define ACCESS          2U
+#define STALL_MAX       40U
+#define TIMERS          4U
+
+/* Simulated state of a timer that's not in its registers. */
+typedef struct
+{
+    TIM_TypeDef *Timer;
+    uint32_t Prescaler;
+    uint32_t PrescalerShadow;
+    uint64_t StartedAt;
+    uint64_t TriggerAt;
+    uint64_t Updates[4];
+    uint32_t UpdateCount;
+} Simulated;
+
+static Simulated Timers[TIMERS];
+static uint64_t Clock = 0;
+static uint32_t MasterWasOn = 0;
+
+/* Chance in a hundred that an access is stretched. */
+static uint32_t StallRate = 0;
+
+static void Tick(void)
+{
+    uint32_t MasterOn;
+
+    Clock++;
+
+    /* The master's counter enable on TRGO, wired to ITR1 of the others. */
+    MasterOn = ( ((TIM2->CR2 & TIM_CR2_MMS) == TIM_CR2_MMS_0) &&
+        ((TIM2->CR1 & TIM_CR1_CEN) != 0) ) ? 1 : 0;
+    for(uint32_t i = 1 ; i < TIMERS ; i++)
+    {
+        Simulated *Sim = &Timers[i];
+        TIM_TypeDef *Timer = Sim->Timer;
+
+        if( (MasterOn != 0) && (MasterWasOn == 0) &&
+            ((Timer->SMCR & TIM_SMCR_SMS) ==
+                (TIM_SMCR_SMS_2 | TIM_SMCR_SMS_1)) &&
+            ((Timer->SMCR & TIM_SMCR_TS) == TIM_SMCR_TS_0) )
+        {
+            Sim->TriggerAt = Clock + RESYNC;
+        }
+        if( (Sim->TriggerAt != 0) && (Sim->TriggerAt == Clock) )
+        {
+            Timer->CR1 |= TIM_CR1_CEN;
+            Sim->TriggerAt = 0;
+        }
+    }
+    MasterWasOn = MasterOn;
+
+    for(uint32_t i = 0 ; i < TIMERS ; i++)
+    {
+        Simulated *Sim = &Timers[i];
+        TIM_TypeDef *Timer = Sim->Timer;
+
+        if( (Timer->CR1 & TIM_CR1_CEN) == 0 )
+        {
+            continue;
+        }
+        if(Sim->StartedAt == 0)
+        {
+            Sim->StartedAt = Clock;
+        }
+        if(++Sim->Prescaler <= Sim->PrescalerShadow)
+        {
+            continue;
+        }
+        Sim->Prescaler = 0;
+        if(Timer->CNT < Timer->ARR)
+        {
+            Timer->CNT++;
+            continue;
+        }
+        Timer->CNT = 0;
+        Sim->PrescalerShadow = Timer->PSC;
+        Timer->SR |= TIM_SR_UIF;
+        if(Sim->UpdateCount < 4)
+        {
+            Sim->Updates[Sim->UpdateCount++] = Clock;
+        }
+    }
+}
+
+static void Access(volatile uint32_t *Register)
+{
+    uintptr_t Offset = (uintptr_t)Register - (uintptr_t)HostPeripherals;
+    uint32_t Clocks = ACCESS;
+
+    if(Offset >= sizeof(HostPeripherals))
+    {
+        return;
+    }
+    if( (StallRate != 0) && ((uint32_t)(rand() % 100) < StallRate) )
+    {
+        Clocks += (uint32_t)(rand() % (STALL_MAX + 1));
+    }
+    while(Clocks-- > 0)
+    {
+        Tick();
+    }
+}
+
+static inline uint32_t HostRead(volatile uint32_t *Register)
+{
+    Access(Register);
+    return *Register;
+}
+
+static inline void HostWrite(volatile uint32_t *Register, uint32_t Value)
+{
+    Access(Register);
+    for(uint32_t i = 0 ; i < TIMERS ; i++)
+    {
+        TIM_TypeDef *Timer = Timers[i].Timer;
+
+        if( (Register == &Timer->EGR) && ((Value & TIM_EGR_UG) != 0) )
+        {
+            Timer->CNT = 0;
+            Timers[i].Prescaler = 0;
+            Timers[i].PrescalerShadow = Timer->PSC;
+            if( (Timer->CR1 & TIM_CR1_URS) == 0 )
+            {
+                Timer->SR |= TIM_SR_UIF;
+            }
+            return;
+        }
+    }
+    *Register = Value;
+}
+
+#undef READ_REG
+#undef WRITE_REG
+#undef SET_BIT
+#undef CLEAR_BIT
+#undef READ_BIT
+#undef MODIFY_REG
+#define READ_REG(REG) HostRead(&(REG))
+#define WRITE_REG(REG, VAL) HostWrite(&(REG), (uint32_t)(VAL))
+#define SET_BIT(REG, BIT) WRITE_REG(REG, READ_REG(REG) | (BIT))
+#define CLEAR_BIT(REG, BIT) WRITE_REG(REG, READ_REG(REG) & ~(uint32_t)(BIT))
+#define READ_BIT(REG, BIT) (READ_REG(REG) & (BIT))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK) \
+    WRITE_REG(REG, (READ_REG(REG) & ~(uint32_t)(CLEARMASK)) | (SETMASK))
+
+#include "../Src/hierodule_tim.c"
+
+static HIERODULE_TIM_Group Group;
+static HIERODULE_TIM_GroupMember Members[TIMERS - 1];
+
+static uint64_t Reload(TIM_TypeDef *Timer)
+{
+    return (uint64_t)Timer->ARR + 1;
+}
+
+static uint64_t Period(TIM_TypeDef *Timer)
+{
+    return Reload(Timer) * ((uint64_t)Timer->PSC + 1);
+}
+
+/* Counter value a member's phase comes down to. */
+static uint64_t Preload(uint32_t Member)
+{
+    TIM_TypeDef *Timer = Members[Member].Timer;
+
+    return (Reload(Timer) * Members[Member].Phase_Q15) >> 15;
+}
+
+/* Starts the group with random settings, runs it until every timer has
+ * wrapped a few times and stops it somewhere. */
+static void Scenario(uint8_t SamePeriod)
+{
+    uint32_t Prescaler = (uint32_t)(rand() % 8);
+    uint32_t AutoReload = 1U + (uint32_t)(rand() % 2000);
+    uint32_t Urs[TIMERS];
+    uint64_t Offset;
+    uint8_t Done = 0;
+
+    for(uint32_t i = 0 ; i < TIMERS ; i++)
+    {
+        TIM_TypeDef *Timer = Timers[i].Timer;
+
+        Timer->PSC = SamePeriod ? Prescaler : (uint32_t)(rand() % 8);
+        Timer->ARR = SamePeriod ? AutoReload :
+            (1U + (uint32_t)(rand() % 2000));
+        Timer->CR1 = (rand() % 2) ? TIM_CR1_URS : 0;
+        Timer->SR = 0;
+        Urs[i] = Timer->CR1 & TIM_CR1_URS;
+        Timers[i].StartedAt = 0;
+        Timers[i].TriggerAt = 0;
+        Timers[i].UpdateCount = 0;
+    }
+    for(uint32_t m = 0 ; m < TIMERS - 1 ; m++)
+    {
+        Members[m].Phase_Q15 = (uint16_t)(rand() % 32768);
+    }
+    Members[rand() % (TIMERS - 1)].Phase_Q15 = (rand() % 2) ? 0 : 32767;
+
+    HIERODULE_TIM_StartGroup(&Group);
+
+    /* Phases loaded, the members not started yet, no update raised. */
+    for(uint32_t m = 0 ; m < TIMERS - 1 ; m++)
+    {
+        CHECK(Members[m].Timer->CNT == Preload(m));
+        CHECK(Preload(m) < Reload(Members[m].Timer));
+    }
+    for(uint32_t i = 0 ; i < TIMERS ; i++)
+    {
+        CHECK( (Timers[i].Timer->CR1 & TIM_CR1_URS) == Urs[i] );
+        CHECK( (Timers[i].Timer->SR & TIM_SR_UIF) == 0 );
+    }
+
+    while(Done == 0)
+    {
+        Tick();
+        Done = 1;
+        for(uint32_t i = 0 ; i < TIMERS ; i++)
+        {
+            Done &= (Timers[i].UpdateCount == 4) ? 1 : 0;
+        }
+    }
+
+    /* The master's first wrap, one period after its start, gives the offset
+     * of the counting from the enable. */
+    Offset = Timers[0].Updates[0] - Timers[0].StartedAt - Period(TIM2);
+
+    for(uint32_t m = 0 ; m < TIMERS - 1 ; m++)
+    {
+        Simulated *Sim = &Timers[m + 1];
+        TIM_TypeDef *Timer = Sim->Timer;
+        uint64_t Ahead = Preload(m) * ((uint64_t)Timer->PSC + 1);
+
+        CHECK(Sim->StartedAt == Timers[1].StartedAt);
+        CHECK(Sim->StartedAt == Timers[0].StartedAt + RESYNC);
+        CHECK(Sim->Updates[0] - Sim->StartedAt ==
+            Period(Timer) - Ahead + Offset);
+        for(uint32_t k = 1 ; k < 4 ; k++)
+        {
+            CHECK(Sim->Updates[k] - Sim->Updates[k - 1] == Period(Timer));
+        }
+
+        /* With the master's period, the member leads it by its phase, less
+         * the resynchronization delay. */
+        if(Period(Timer) == Period(TIM2))
+        {
+            uint64_t Lead = (Timers[0].Updates[1] - Sim->Updates[0]) %
+                Period(TIM2);
+
+            CHECK(Lead == (Ahead + Period(TIM2) - RESYNC) % Period(TIM2));
+        }
+    }
+    for(uint32_t k = 1 ; k < 4 ; k++)
+    {
+        CHECK(Timers[0].Updates[k] - Timers[0].Updates[k - 1] ==
+            Period(TIM2));
+    }
+
+    /* Stops midway through a prescaler cycle, the next start clears it. */
+    for(uint32_t k = (uint32_t)(rand() % 5000) ; k > 0 ; k--)
+    {
+        Tick();
+    }
+    HIERODULE_TIM_StopGroup(&Group);
+    for(uint32_t i = 0 ; i < TIMERS ; i++)
+    {
+        CHECK( (Timers[i].Timer->CR1 & TIM_CR1_CEN) == 0 );
+    }
+    for(uint32_t k = 0 ; k < 8 ; k++)
+    {
+        Tick();
+    }
+}
+
+int main(void)
+{
+    TIM_TypeDef *Order[TIMERS] = { TIM2, TIM3, TIM4, TIM1 };
+
+    srand(17);
+    for(uint32_t i = 0 ; i < TIMERS ; i++)
+    {
+        Timers[i].Timer = Order[i];
+    }
+    for(uint32_t m = 0 ; m < TIMERS - 1 ; m++)
+    {
+        Members[m].Timer = Order[m + 1];
+    }
+
+    /* A timer can't trigger itself, nothing's written then. */
+    Members[1].Timer = TIM2;
+    CHECK(HIERODULE_TIM_InitGroup(&Group, TIM2, Members, TIMERS - 1) == 0);
+    CHECK(TIM3->SMCR == 0);
+    CHECK(TIM2->CR2 == 0);
+    Members[1].Timer = TIM4;
+
+    CHECK(HIERODULE_TIM_InitGroup(&Group, TIM2, Members, TIMERS - 1) == 1);
+    CHECK( (TIM2->CR2 & TIM_CR2_MMS) == TIM_CR2_MMS_0 );
+    for(uint32_t m = 0 ; m < TIMERS - 1 ; m++)
+    {
+        CHECK( (Members[m].Timer->SMCR & (TIM_SMCR_SMS | TIM_SMCR_TS)) ==
+            (TIM_SMCR_SMS_2 | TIM_SMCR_SMS_1 | TIM_SMCR_TS_0) );
+    }
+
+    for(uint32_t Run = 0 ; Run < 400 ; Run++)
+    {
+        StallRate = (Run & 1) ? 30 : 0;
+        Scenario( (Run % 4) < 2 );
+    }
+
+    return HostReport("tim_group");
+}
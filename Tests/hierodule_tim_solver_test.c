@@ -0,0 +1,273 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tim_solver_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test of the integer period and frequency setters of
+  * the timer module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <math.h>
+#include "../Src/hierodule_tim.c"
+
+/*
+ * The integer setters are swept over the whole range of a 16 bit timer, for
+ * a few kernel clocks, and checked against the double setters given the
+ * smallest prescaler that fits, against a brute force search over the same
+ * prescaler span, and against the values they report as achieved. The
+ * chained setters are checked against the ideal divider. Both are also
+ * driven with dividers at the ends of the 64 bit range.
+ */
+
+static const uint32_t Clocks[] = { 8000000UL, 48000000UL, 72000000UL };
+
+static void SetClock(uint32_t Clock)
+{
+    SystemCoreClock = Clock;
+    HIERODULE_TIM_InvalidateClockCache();
+}
+
+/* Closest pair over the span, the way the solver is specified, ties going
+ * to the larger ARR. */
+static void Reference(uint64_t Numerator, uint64_t Denominator,
+    uint32_t *Prescaler, uint64_t *Reload)
+{
+    uint64_t Best = UINT64_MAX;
+    uint64_t First = (Numerator + Denominator * 65536 - 1) /
+        (Denominator * 65536);
+
+    First = (First < 1) ? 1 : First;
+    for(uint64_t P = First ; P < First + HIERODULE_TIM_SOLVER_SPAN ; P++)
+    {
+        for(uint64_t A = 2 ; A <= 65536 ; A++)
+        {
+            uint64_t Product = Denominator * P * A;
+            uint64_t Error = (Product > Numerator) ? (Product - Numerator)
+                : (Numerator - Product);
+
+            if( (Error < Best) || ((Error == Best) && (P == *Prescaler)) )
+            {
+                Best = Error;
+                *Prescaler = (uint32_t)P;
+                *Reload = A;
+            }
+            if(Product > Numerator)
+            {
+                break;
+            }
+        }
+        if(Best == 0)
+        {
+            break;
+        }
+    }
+}
+
+static double Registers(TIM_TypeDef *Timer)
+{
+    return ((double)Timer->PSC + 1.0) * ((double)Timer->ARR + 1.0);
+}
+
+static void Frequency(uint32_t Clock, uint64_t Frequency_mHz, uint8_t Full)
+{
+    double Ideal = (double)Clock * 1000.0 / (double)Frequency_mHz;
+    double First = ceil(Ideal / 65536.0);
+    uint64_t Achieved;
+    double Solved;
+    double Rounded;
+
+    Achieved = HIERODULE_TIM_SetFrequency_mHz(TIM3, Frequency_mHz);
+    Solved = Registers(TIM3);
+    CHECK(TIM3->ARR >= 1);
+    CHECK(TIM3->ARR <= 0xFFFFU);
+    CHECK(Achieved == (uint64_t)floor((double)Clock * 1000.0 / Solved + 0.5));
+
+    if(Full != 0)
+    {
+        uint32_t Prescaler = 0;
+        uint64_t Reload = 0;
+
+        Reference((uint64_t)Clock * 1000, Frequency_mHz, &Prescaler, &Reload);
+        CHECK(TIM3->PSC == Prescaler - 1);
+        CHECK(TIM3->ARR == Reload - 1);
+    }
+
+    /* The double setter, with the smallest prescaler that fits. */
+    WRITE_REG(TIM3->PSC, (uint32_t)First - 1);
+    HIERODULE_TIM_SetFrequency(TIM3, (double)Frequency_mHz / 1000.0);
+    Rounded = Registers(TIM3);
+    CHECK(fabs(Solved - Ideal) <= fabs(Rounded - Ideal) + Ideal * 1e-12);
+
+    /* The relative error is no more than half an ARR step. */
+    CHECK(fabs(Solved - Ideal) <= First * 0.5 + Ideal * 1e-12);
+}
+
+static void Period(uint32_t Clock, uint64_t Period_ns)
+{
+    double Ideal = (double)Clock * (double)Period_ns * 1e-9;
+    double First = ceil(Ideal / 65536.0);
+    uint64_t Achieved;
+    double Solved;
+    double Rounded;
+
+    Achieved = HIERODULE_TIM_SetPeriod_ns(TIM3, Period_ns);
+    Solved = Registers(TIM3);
+    CHECK(TIM3->ARR >= 1);
+    CHECK(TIM3->ARR <= 0xFFFFU);
+    CHECK(Achieved == (uint64_t)floor(Solved * 1e9 / (double)Clock + 0.5));
+    CHECK(fabs((double)HIERODULE_TIM_GetPeriod_ns(TIM3) - (double)Achieved)
+        <= 1.0 + Solved / 16777216.0);
+
+    WRITE_REG(TIM3->PSC, (uint32_t)First - 1);
+    HIERODULE_TIM_SetPeriod(TIM3, (double)Period_ns * 1e-9);
+    Rounded = Registers(TIM3);
+    CHECK(fabs(Solved - Ideal) <= fabs(Rounded - Ideal) + Ideal * 1e-12);
+    CHECK(fabs(Solved - Ideal) <= First * 0.5 + Ideal * 1e-12);
+}
+
+/* Sweeps from the fastest to the slowest frequency, in steps of about 1%,
+ * against the reference every few steps since it's slow. */
+static void Sweep(uint32_t Clock)
+{
+    uint64_t Fastest = (uint64_t)Clock * 500;
+    uint64_t Slowest = ((uint64_t)Clock * 1000 >> 32) + 1;
+    uint32_t Step = 0;
+
+    SetClock(Clock);
+    for(double F = (double)Fastest ; F >= (double)Slowest ; F /= 1.01)
+    {
+        uint64_t Frequency_mHz = (uint64_t)F - (uint64_t)(rand() % 3);
+
+        Frequency(Clock, (Frequency_mHz < Slowest) ? Slowest : Frequency_mHz,
+            (Step++ % 16) == 0);
+    }
+    for(double T = 1e9 * 2.0 / Clock ; T <= 1e9 * 4294967296.0 / Clock ;
+        T *= 1.01)
+    {
+        Period(Clock, (uint64_t)T + (uint64_t)(rand() % 3));
+    }
+}
+
+/* Integer frequencies of common clocks split exactly whenever the span
+ * holds an exact pair, including the one past the 8th candidate. */
+static void Exact(void)
+{
+    SetClock(72000000UL);
+    CHECK(HIERODULE_TIM_SetFrequency_mHz(TIM3, 1000) == 1000);
+    CHECK(TIM3->PSC == 1124);
+    CHECK(TIM3->ARR == 63999);
+
+    for(uint32_t c = 0 ; c < sizeof(Clocks) / sizeof(Clocks[0]) ; c++)
+    {
+        SetClock(Clocks[c]);
+        for(uint32_t Hz = 1 ; Hz <= 20000 ; Hz++)
+        {
+            uint32_t Prescaler = 0;
+            uint64_t Reload = 0;
+
+            if(Clocks[c] % Hz)
+            {
+                continue;
+            }
+            HIERODULE_TIM_SetFrequency_mHz(TIM3, (uint64_t)Hz * 1000);
+            Reference((uint64_t)Clocks[c] * 1000, (uint64_t)Hz * 1000,
+                &Prescaler, &Reload);
+            CHECK(TIM3->PSC == Prescaler - 1);
+            CHECK(TIM3->ARR == Reload - 1);
+            if((uint64_t)Prescaler * Reload == Clocks[c] / Hz)
+            {
+                CHECK(Registers(TIM3) == (double)(Clocks[c] / Hz));
+            }
+        }
+    }
+}
+
+/* The chain divider is within 2^-16 of the ideal one, or a kernel clock. */
+static void Chain(void)
+{
+    HIERODULE_TIM_Chain Pair = { TIM2, TIM3 };
+
+    SetClock(72000000UL);
+    for(double F = 36e9 ; F >= 1.0 ; F /= 1.03)
+    {
+        uint64_t Frequency_mHz = (uint64_t)F;
+        double Ideal = 72e9 / (double)Frequency_mHz;
+        uint64_t Achieved;
+        double Divider;
+
+        Achieved = HIERODULE_TIM_SetChainFrequency_mHz(&Pair, Frequency_mHz);
+        Divider = ((double)TIM2->PSC + 1.0) * ((double)TIM2->ARR + 1.0) *
+            ((double)TIM3->ARR + 1.0);
+        CHECK(TIM2->ARR <= 0xFFFFU);
+        CHECK(TIM3->ARR <= 0xFFFFU);
+        CHECK(TIM2->PSC <= 0xFFFFU);
+        CHECK(fabs(Divider - Ideal) <= Ideal / 65536.0 + 1.0);
+        CHECK(Achieved == HIERODULE_TIM_GetChainFrequency_mHz(&Pair));
+    }
+}
+
+/* Frequencies up to the 64 bit range, and chain periods whose divider is
+ * right below 2^64 ns kernel clocks, neither of which may overflow the
+ * search. Dividers below 2 get the fastest pair. */
+static void Extremes(void)
+{
+    static const uint64_t Fast[] = { 0x100000000ULL, 1ULL << 40,
+        (1ULL << 58) + 12345U, 1ULL << 63, UINT64_MAX - 1, UINT64_MAX };
+    HIERODULE_TIM_Chain Pair = { TIM2, TIM3 };
+
+    for(uint32_t c = 0 ; c < sizeof(Clocks) / sizeof(Clocks[0]) ; c++)
+    {
+        uint64_t Numerator = (uint64_t)Clocks[c] * 1000;
+
+        SetClock(Clocks[c]);
+        if(Numerator / 0xFFFFFFFFUL >= 2)
+        {
+            Frequency(Clocks[c], 0xFFFFFFFFUL, 1);
+            Frequency(Clocks[c], 0xFFFFFFFEUL, 1);
+        }
+        for(uint32_t f = 0 ; f < sizeof(Fast) / sizeof(Fast[0]) + 2 ; f++)
+        {
+            uint64_t Frequency_mHz = (f < 2) ? (0xFFFFFFFFUL - f) : Fast[f - 2];
+
+            if(Numerator / Frequency_mHz >= 2)
+            {
+                continue;
+            }
+            CHECK(HIERODULE_TIM_SetFrequency_mHz(TIM3, Frequency_mHz) ==
+                (Numerator + 1) / 2);
+            CHECK(TIM3->PSC == 0);
+            CHECK(TIM3->ARR == 1);
+        }
+    }
+
+    SetClock(72000000UL);
+    for(uint64_t Period_ns = UINT64_MAX / 72000000UL - 2 ;
+        Period_ns <= UINT64_MAX / 72000000UL + 1 ; Period_ns++)
+    {
+        double Ideal = 72e6 * (double)Period_ns * 1e-9;
+        uint64_t Achieved = HIERODULE_TIM_SetChainPeriod_ns(&Pair, Period_ns);
+        double Divider = ((double)TIM2->PSC + 1.0) *
+            ((double)TIM2->ARR + 1.0) * ((double)TIM3->ARR + 1.0);
+
+        CHECK(fabs(Divider - Ideal) <= Ideal / 65536.0 + 1.0);
+        CHECK(Achieved == HIERODULE_TIM_GetChainPeriod_ns(&Pair));
+    }
+}
+
+int main(void)
+{
+    srand(5);
+    for(uint32_t c = 0 ; c < sizeof(Clocks) / sizeof(Clocks[0]) ; c++)
+    {
+        Sweep(Clocks[c]);
+    }
+    Exact();
+    Chain();
+    Extremes();
+
+    return HostReport("tim_solver");
+}
@@ -0,0 +1,289 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_tstamp_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test of the timestamp module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <main.h>
+
+/*
+ * The counter of TIM3 is simulated by the counter reads, and the half period
+ * events are serviced by the callbacks the module assigned, the update one
+ * on a wrap and the compare one at 0x8000.
+ *
+ * First, the half period count and its epoch are set to every state a reader
+ * may find them in, around the toggles of the most significant bit of the
+ * count and the counter's own half period boundaries: with the last event
+ * serviced, with it pending, and with its callback preempted between its two
+ * stores. Then the time is run on from the same points, each event being
+ * serviced with a random latency under half a period, sometimes right before
+ * or right after a counter read, and the reader is sometimes preempted for a
+ * few half periods before reading the counter, so that the reads are
+ * retried. Either way, a timestamp has to be the exact time of the last
+ * counter read.
+ */
+
+#define HALF            0x8000ULL
+#define LATENCY         30000U
+#define STEP_MAX        3000U
+
+/* Counts since a count of 0 halves, events serviced, the time the pending
+ * one gets serviced at, and the time of the last counter read. */
+static uint64_t Time = 0;
+static uint64_t Serviced = 0;
+static uint64_t DueAt = 0;
+static uint64_t ReadAt = 0;
+
+/* 1 while the time is held still and no event is serviced. */
+static uint8_t Frozen = 1;
+
+static void Elapse(uint64_t Counts);
+static void Service(void);
+
+static inline uint32_t HostRead(volatile uint32_t *Register)
+{
+    uint32_t Preemption;
+    uint32_t Value;
+
+    if( (Register != &TIM3->CNT) || (Frozen != 0) )
+    {
+        return *Register;
+    }
+
+    /* The IRQ may come in right before or right after the read, or the
+     * reader may be preempted for a few half periods before it. */
+    Preemption = (uint32_t)(rand() % 8);
+    if(Preemption == 0)
+    {
+        Service();
+    }
+    else if(Preemption == 2)
+    {
+        Elapse((uint64_t)rand() % (4 * HALF));
+    }
+    Value = (uint32_t)(Time & 0xFFFFU);
+    ReadAt = Time;
+    Elapse(1U + (uint32_t)(rand() % STEP_MAX));
+    if(Preemption == 1)
+    {
+        Service();
+    }
+    return Value;
+}
+
+#undef READ_REG
+#define READ_REG(REG) HostRead(&(REG))
+
+#include "../Src/hierodule_tstamp.c"
+
+/* The callbacks the module assigned. */
+static HIERODULE_TIM_Callback Update = NULL;
+static HIERODULE_TIM_Callback Compare = NULL;
+
+void HIERODULE_TIM_Assign_Callback_UPD(TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback, void *Context)
+{
+    (void)Timer;
+    (void)Context;
+    Update = Callback;
+}
+
+void HIERODULE_TIM_Assign_Callback_CC1(TIM_TypeDef *Timer,
+    HIERODULE_TIM_Callback Callback, void *Context)
+{
+    (void)Timer;
+    (void)Context;
+    Compare = Callback;
+}
+
+void HIERODULE_TIM_ClearFlag_UPD(TIM_TypeDef *Timer) { (void)Timer; }
+void HIERODULE_TIM_ClearFlag_CC1(TIM_TypeDef *Timer) { (void)Timer; }
+void HIERODULE_TIM_Enable_IT_UPD(TIM_TypeDef *Timer) { (void)Timer; }
+void HIERODULE_TIM_Enable_IT_CC1(TIM_TypeDef *Timer) { (void)Timer; }
+
+void HIERODULE_TIM_ClearCounter(TIM_TypeDef *Timer)
+{
+    Timer->CNT = 0;
+}
+
+uint32_t HIERODULE_TIM_GetKernelClock(TIM_TypeDef *Timer)
+{
+    (void)Timer;
+    return 72000000UL;
+}
+
+/* Services the pending event, if there is one. */
+static void Service(void)
+{
+    if( (Time / HALF) > Serviced )
+    {
+        Serviced++;
+        if( (Serviced & 1U) == 0 )
+        {
+            Update(TIM3, TIM_SR_UIF, NULL);
+        }
+        else
+        {
+            Compare(TIM3, TIM_SR_CC1IF, NULL);
+        }
+    }
+}
+
+/* Moves the time on, an event being serviced at most LATENCY counts after
+ * it happens, so there's never more than one pending. */
+static void Elapse(uint64_t Counts)
+{
+    uint64_t End = Time + Counts;
+
+    while(1)
+    {
+        uint64_t Boundary = (Time / HALF + 1) * HALF;
+
+        if( (Time / HALF) > Serviced )
+        {
+            if(DueAt > End)
+            {
+                Time = End;
+                break;
+            }
+            Time = (DueAt > Time) ? DueAt : Time;
+            Service();
+        }
+        else if(Boundary <= End)
+        {
+            Time = Boundary;
+            DueAt = Time + (uint64_t)(rand() % (LATENCY + 1));
+        }
+        else
+        {
+            Time = End;
+            break;
+        }
+    }
+    TIM3->CNT = (uint32_t)(Time & 0xFFFFU);
+}
+
+/* Number of times the most significant bit of the count has toggled. */
+static uint32_t Toggles(uint64_t Count)
+{
+    return (uint32_t)(Count >> 31);
+}
+
+/* Sets up the state a reader finds at a time, with a given number of events
+ * serviced, and the epoch store of the last one left out if Torn. */
+static void Set(uint64_t At, uint64_t Events, uint8_t Torn)
+{
+    Time = At;
+    ReadAt = At;
+    Serviced = Events;
+    TIM3->CNT = (uint32_t)(At & 0xFFFFU);
+    Halves = (uint32_t)Events;
+    Epoch = Toggles(Events) - Torn;
+}
+
+static void Expect(void)
+{
+    CHECK(HIERODULE_TSTAMP_Get() == ReadAt);
+    CHECK(HIERODULE_TSTAMP_Get32() == (uint32_t)ReadAt);
+}
+
+/* Half period counts the epoch toggles around. */
+static const uint64_t Marks[] = { 0, 1ULL << 31, 1ULL << 32, 3ULL << 31,
+    1ULL << 33, 5ULL << 32, 1ULL << 48 };
+
+static void States(void)
+{
+    static const uint32_t Offsets[] = { 0, 1, 2, 0x3FFF, 0x4000, 0x7FFD,
+        0x7FFE, 0x7FFF };
+
+    Frozen = 1;
+    for(uint32_t m = 0 ; m < sizeof(Marks) / sizeof(Marks[0]) ; m++)
+    {
+        for(int32_t d = -3 ; d <= 3 ; d++)
+        {
+            uint64_t Events = Marks[m] + (uint64_t)(int64_t)d;
+
+            if( (Marks[m] == 0) && (d < 0) )
+            {
+                continue;
+            }
+            for(uint32_t o = 0 ; o < sizeof(Offsets) / sizeof(Offsets[0]) ;
+                o++)
+            {
+                uint64_t At = Events * HALF + Offsets[o];
+
+                /* Every event serviced. */
+                Set(At, Events, 0);
+                Expect();
+
+                /* The last one pending. */
+                if(Events > 0)
+                {
+                    Set(At, Events - 1, 0);
+                    Expect();
+                }
+
+                /* The last one's callback preempted by the reader after
+                 * storing the count, before storing the epoch. */
+                if( (Events > 0) && ((uint32_t)(Events << 1) == 0) )
+                {
+                    Set(At, Events, 1);
+                    Expect();
+                }
+            }
+        }
+    }
+}
+
+/* Runs the time on from a little before each toggle of the epoch. */
+static void Runs(void)
+{
+    for(uint32_t m = 0 ; m < sizeof(Marks) / sizeof(Marks[0]) ; m++)
+    {
+        uint64_t Events = (Marks[m] > 64) ? (Marks[m] - 64) : 0;
+        uint64_t Last = 0;
+
+        Frozen = 1;
+        Set(Events * HALF, Events, 0);
+        Frozen = 0;
+        while(Serviced < Events + 4000)
+        {
+            uint64_t Wide = HIERODULE_TSTAMP_Get();
+            uint32_t Narrow;
+
+            CHECK(Wide == ReadAt);
+            CHECK(Wide >= Last);
+            Last = Wide;
+            Narrow = HIERODULE_TSTAMP_Get32();
+            CHECK(Narrow == (uint32_t)ReadAt);
+            Elapse((uint64_t)(rand() % (4 * STEP_MAX)));
+        }
+    }
+}
+
+int main(void)
+{
+    srand(7);
+
+    TIM3->CNT = 1234;
+    TIM3->PSC = 71;
+    Frozen = 1;
+    HIERODULE_TSTAMP_Init(TIM3);
+    CHECK(TIM3->ARR == 0xFFFFU);
+    CHECK(TIM3->CCR1 == 0x8000U);
+    CHECK(TIM3->CNT == 0);
+    CHECK( (Update == &HalfTick) && (Compare == &HalfTick) );
+    CHECK(HIERODULE_TSTAMP_Get() == 0);
+    CHECK(HIERODULE_TSTAMP_GetFrequency() == 1000000UL);
+
+    States();
+    Runs();
+
+    return HostReport("tstamp");
+}
@@ -0,0 +1,411 @@
+/**
+  ******************************************************************************
+  * @file           : hierodule_wave_test.c
+  * @author         : [ushumgigal](https://github.com/ushumgigal)
+  * @brief          : Host test of the waveform module.
+  * @attention      : Copyrighted (2024) by
+  * [ushumgigal](https://github.com/ushumgigal) under MIT License, a copy of
+  * which may be found in the root folder of the
+  * [repository](https://github.com/ushumgigal/hierodule).
+  ******************************************************************************
+  */
+#include <host_test.h>
+#include <main.h>
+#include <math.h>
+#include <string.h>
+
+/*
+ * The table generators are checked on their own: the sine against the one
+ * of the C library, the sine fill against the sine of each frame's phase,
+ * and the dither fill for its average over every run of frames, refill
+ * after refill.
+ *
+ * The stream is then run on a simulated DMA channel in circular mode. Each
+ * update event of TIM1 bursts a frame through DMAR into the compare
+ * registers DCR points at, raising the half transfer and transfer complete
+ * flags as the DMA gets half way and all the way through the table. The
+ * flags are serviced up to almost half a table later, and the refill
+ * callback continues a sine wave on each channel, so the frames sent out
+ * have to be the continuous wave, with no half being sent out before it's
+ * refilled or refilled while it's being sent out. Streams initialized with
+ * an odd frame count, or no frames, or out of range channels, have to be
+ * refused and never start.
+ */
+
+#include "../Src/hierodule_wave.c"
+
+#define TWO_PI      6.283185307179586
+
+/* The simulated DMA channel. */
+static uint8_t Running = 0;
+static uint32_t Starts = 0;
+static uint32_t Stops = 0;
+static volatile uint32_t *Target = NULL;
+static uint16_t *Memory = NULL;
+static uint32_t Count = 0;
+static uint32_t Position = 0;
+static uint32_t Flags = 0;
+
+/* Channel mask the preload was enabled for. */
+static uint8_t Preloaded = 0;
+
+void HIERODULE_DMA_StartCircular
+(
+    const HIERODULE_DMA_Link *Link,
+    HIERODULE_DMA_Direction Direction,
+    volatile uint32_t *Register,
+    void *Buffer,
+    uint16_t Length,
+    uint8_t Size
+)
+{
+    (void)Link;
+    CHECK(Direction == HIERODULE_DMA_Direction_MEM_TO_PERIPH);
+    CHECK(Size == 2);
+    Target = Register;
+    Memory = (uint16_t*)Buffer;
+    Count = Length;
+    Position = 0;
+    Flags = 0;
+    Running = 1;
+    Starts++;
+}
+
+void HIERODULE_DMA_Stop(const HIERODULE_DMA_Link *Link)
+{
+    (void)Link;
+    Running = 0;
+    Stops++;
+}
+
+uint32_t HIERODULE_DMA_FetchFlags(const HIERODULE_DMA_Link *Link)
+{
+    uint32_t Fetched = Flags;
+
+    (void)Link;
+    Flags = 0;
+    return Fetched;
+}
+
+void HIERODULE_TIM_EnablePreload(TIM_TypeDef *Timer, uint8_t ChannelMask)
+{
+    (void)Timer;
+    Preloaded = ChannelMask;
+}
+
+/* An update event of TIM1: a burst of DBL+1 transfers through DMAR, to the
+ * registers from DBA onwards. */
+static void Update(void)
+{
+    uint32_t Base = READ_REG(TIM1->DCR) & TIM_DCR_DBA;
+    uint32_t Length = ((READ_REG(TIM1->DCR) & TIM_DCR_DBL) >>
+        TIM_DCR_DBL_Pos) + 1;
+
+    if( (Running == 0) || ((TIM1->DIER & TIM_DIER_UDE) == 0) )
+    {
+        return;
+    }
+    CHECK(Target == &TIM1->DMAR);
+    for(uint32_t i = 0 ; i < Length ; i++)
+    {
+        ((volatile uint32_t*)TIM1)[Base + i] = Memory[Position++];
+        if(Position == Count / 2)
+        {
+            Flags |= HIERODULE_DMA_FLAG_HT;
+        }
+        if(Position == Count)
+        {
+            Flags |= HIERODULE_DMA_FLAG_TC;
+            Position = 0;
+        }
+    }
+}
+
+#define MAX_FRAMES  256U
+
+static uint16_t Table[MAX_FRAMES * 4];
+
+/* The wave each channel continues, and the refills seen. */
+static uint32_t Phase[4];
+static uint32_t PhaseStep[4];
+static uint32_t Refills = 0;
+static HIERODULE_WAVE_Stream Wave;
+
+static void Refill(HIERODULE_WAVE_Stream *Stream, uint16_t *Half,
+    uint32_t Frames, void *Context)
+{
+    CHECK(Stream == &Wave);
+    CHECK(Context == (void*)&Refills);
+    CHECK(Frames == Stream->Frames / 2);
+    CHECK( (Half == Stream->Table) ||
+        (Half == Stream->Table + Frames * Stream->Channels) );
+
+    /* The DMA has to be in the other half. */
+    CHECK( (Half == Stream->Table) ? (Position >= Count / 2)
+        : (Position < Count / 2) );
+
+    for(uint8_t Channel = 1 ; Channel <= Stream->Channels ; Channel++)
+    {
+        Phase[Channel-1] = HIERODULE_WAVE_FillSine(Half, Frames,
+            Stream->Channels, Channel, Phase[Channel-1], PhaseStep[Channel-1],
+            400, 500);
+    }
+    Refills++;
+}
+
+static void Sine(void)
+{
+    static const double Turn = 4294967296.0;
+    uint32_t Worst = 0;
+
+    for(uint64_t p = 0 ; p < (1ULL << 32) ; p += 4099)
+    {
+        uint32_t Phase = (uint32_t)p;
+        int32_t Value = HIERODULE_WAVE_Sine_Q15(Phase);
+        double Ideal = 32767.0 * sin(TWO_PI * (double)Phase / Turn);
+        uint32_t Error = (uint32_t)fabs((double)Value - Ideal);
+
+        Worst = (Error > Worst) ? Error : Worst;
+        CHECK(HIERODULE_WAVE_Sine_Q15(Phase + 0x80000000UL) == -Value);
+    }
+    CHECK(Worst <= 4);
+
+    for(uint32_t Quarter = 0 ; Quarter < 4 ; Quarter++)
+    {
+        static const int16_t Peaks[4] = { 0, 32767, 0, -32767 };
+
+        CHECK(HIERODULE_WAVE_Sine_Q15(Quarter << 30) == Peaks[Quarter]);
+    }
+}
+
+static void FillSine(void)
+{
+    for(uint32_t n = 0 ; n < 200 ; n++)
+    {
+        uint8_t Channels = (uint8_t)(1 + rand() % 4);
+        uint8_t Channel = (uint8_t)(1 + rand() % Channels);
+        uint32_t Frames = 1 + (uint32_t)rand() % MAX_FRAMES;
+        uint32_t Start = (uint32_t)rand() << 1;
+        uint32_t Step = (uint32_t)rand() << 3;
+        uint16_t Amplitude = (uint16_t)(rand() % 30000);
+        uint16_t Offset = (uint16_t)(Amplitude + rand() % 4000);
+        uint32_t End;
+
+        memset(Table, 0xA5, sizeof(Table));
+        End = HIERODULE_WAVE_FillSine(Table, Frames, Channels, Channel,
+            Start, Step, Amplitude, Offset);
+        CHECK(End == Start + Frames * Step);
+
+        for(uint32_t i = 0 ; i < MAX_FRAMES * 4 ; i++)
+        {
+            uint32_t Frame = i / Channels;
+            uint32_t At = Start + Frame * Step;
+            double Ideal = Offset + Amplitude *
+                sin(TWO_PI * (double)At / 4294967296.0);
+
+            if( (i % Channels != (uint32_t)(Channel - 1)) ||
+                (Frame >= Frames) )
+            {
+                CHECK(Table[i] == 0xA5A5U);
+                continue;
+            }
+            CHECK(Table[i] == (uint16_t)(Offset + ((Amplitude *
+                (int32_t)HIERODULE_WAVE_Sine_Q15(At)) >> 15)));
+            CHECK(fabs((double)Table[i] - Ideal) <=
+                1.0 + Amplitude * 5.0 / 32767.0);
+        }
+    }
+}
+
+/* The compare values of every run of frames average to the ideal one,
+ * within a count over the run, across refills of random sizes. */
+static void FillDither(void)
+{
+    static const uint32_t Periods[] = { 2, 3, 100, 360, 1000, 65535, 65536,
+        70000 };
+
+    for(uint32_t n = 0 ; n < 64 ; n++)
+    {
+        uint32_t Period = (n < 8) ? Periods[n] : 2 + (uint32_t)rand() % 65535;
+        uint32_t Duty = (n % 5 == 0) ? 0x80000000UL + (uint32_t)rand() :
+            ((uint32_t)rand() & 0x7FFFFFFFUL);
+        uint64_t Ideal = (uint64_t)((Duty > 0x80000000UL) ? 0x80000000UL
+            : Duty) * Period;
+        int64_t Sums[MAX_FRAMES + 1];
+        uint32_t Residue = 0;
+        uint32_t Filled = 0;
+
+        Ideal = (Ideal > MAX_TARGET) ? MAX_TARGET : Ideal;
+        while(Filled < MAX_FRAMES)
+        {
+            uint32_t Frames = 1 + (uint32_t)rand() % 40;
+
+            Frames = (Frames > MAX_FRAMES - Filled) ? (MAX_FRAMES - Filled)
+                : Frames;
+            Residue = HIERODULE_WAVE_FillDither(Table + Filled * 2, Frames, 2,
+                2, Residue, Duty, Period);
+            CHECK(Residue < 0x80000000UL);
+            Filled += Frames;
+        }
+
+        Sums[0] = 0;
+        for(uint32_t i = 0 ; i < MAX_FRAMES ; i++)
+        {
+            uint16_t Value = Table[i * 2 + 1];
+
+            CHECK( (Value == (Ideal >> 31)) || (Value == (Ideal >> 31) + 1) );
+            Sums[i + 1] = Sums[i] + Value;
+        }
+        for(uint32_t i = 0 ; i < MAX_FRAMES ; i++)
+        {
+            for(uint32_t j = i + 1 ; j <= MAX_FRAMES ; j++)
+            {
+                int64_t Error = ((Sums[j] - Sums[i]) << 31) -
+                    (int64_t)((j - i) * Ideal);
+
+                CHECK( (Error > -(1LL << 31)) && (Error < (1LL << 31)) );
+            }
+        }
+    }
+}
+
+static const HIERODULE_DMA_Link Link = { DMA1, 5, 0 };
+
+static void Refused(void)
+{
+    static const struct { uint32_t Frames; uint8_t Channels; } Cases[] =
+    {
+        { 0, 1 }, { 1, 1 }, { 3, 2 }, { 127, 3 }, { 64, 0 }, { 64, 5 },
+        { 32768, 2 }, { 65536, 1 }
+    };
+
+    for(uint32_t c = 0 ; c < sizeof(Cases) / sizeof(Cases[0]) ; c++)
+    {
+        memset(TIM1, 0, sizeof(*TIM1));
+        Starts = 0;
+        Preloaded = 0;
+        HIERODULE_WAVE_Init(&Wave, TIM1, &Link, Table, Cases[c].Frames,
+            Cases[c].Channels, &Refill, &Refills);
+        CHECK(Wave.Frames == 0);
+        HIERODULE_WAVE_Start(&Wave);
+        CHECK(Starts == 0);
+        CHECK( (TIM1->DCR == 0) && (TIM1->DIER == 0) && (Preloaded == 0) );
+    }
+}
+
+/* Streams a continuous sine on each channel, the flags being serviced with
+ * a random latency, and checks each frame sent out against it. */
+static void Stream(uint32_t Frames, uint8_t Channels)
+{
+    static uint16_t Expected[4][MAX_FRAMES * 12];
+    uint32_t Updates = Frames * 10;
+    uint32_t Due = 0;
+    uint32_t Refilled = 0;
+
+    for(uint8_t Channel = 1 ; Channel <= Channels ; Channel++)
+    {
+        Phase[Channel-1] = (uint32_t)rand() << 1;
+        PhaseStep[Channel-1] = (uint32_t)rand() << 4;
+        HIERODULE_WAVE_FillSine(Expected[Channel-1], Updates, 1, 1,
+            Phase[Channel-1], PhaseStep[Channel-1], 400, 500);
+    }
+
+    for(uint8_t Channel = 1 ; Channel <= Channels ; Channel++)
+    {
+        Phase[Channel-1] = HIERODULE_WAVE_FillSine(Table, Frames, Channels,
+            Channel, Phase[Channel-1], PhaseStep[Channel-1], 400, 500);
+    }
+
+    memset(TIM1, 0, sizeof(*TIM1));
+    HIERODULE_WAVE_Init(&Wave, TIM1, &Link, Table, Frames, Channels, &Refill,
+        &Refills);
+    Refills = 0;
+    CHECK(Wave.Frames == Frames);
+    HIERODULE_WAVE_Start(&Wave);
+    CHECK(Starts == 1);
+    CHECK(Count == Frames * Channels);
+    CHECK(Memory == Table);
+    CHECK(Preloaded == (1U << Channels) - 1);
+    CHECK(TIM1->DCR == ((13U << TIM_DCR_DBA_Pos) |
+        ((uint32_t)(Channels - 1) << TIM_DCR_DBL_Pos)));
+
+    for(uint32_t u = 0 ; u < Updates ; u++)
+    {
+        uint32_t Before = Flags;
+
+        Update();
+        for(uint8_t Channel = 1 ; Channel <= Channels ; Channel++)
+        {
+            CHECK(*(&TIM1->CCR1 + (Channel - 1)) ==
+                Expected[Channel-1][u]);
+        }
+
+        /* The IRQ is entered somewhere within the next half table. */
+        if( (Before == 0) && (Flags != 0) )
+        {
+            Due = u + (uint32_t)rand() % (Frames / 2);
+        }
+        if( (Flags != 0) && (u >= Due) )
+        {
+            HIERODULE_WAVE_Service(&Wave);
+            Refilled++;
+        }
+    }
+    CHECK(Refills == Refilled);
+    CHECK(Refills >= 19);
+
+    HIERODULE_WAVE_Stop(&Wave);
+    CHECK( (Running == 0) && ((TIM1->DIER & TIM_DIER_UDE) == 0) );
+    Starts = 0;
+}
+
+/* A fixed table plays over and over, and a transfer error stops the
+ * stream without a refill. */
+static void Fixed(void)
+{
+    memset(TIM1, 0, sizeof(*TIM1));
+    for(uint32_t i = 0 ; i < 8 ; i++)
+    {
+        Table[i] = (uint16_t)(i * 100);
+    }
+    HIERODULE_WAVE_Init(&Wave, TIM1, &Link, Table, 8, 1, NULL, NULL);
+    HIERODULE_WAVE_Start(&Wave);
+    for(uint32_t u = 0 ; u < 80 ; u++)
+    {
+        Update();
+        CHECK(TIM1->CCR1 == (u % 8) * 100);
+        HIERODULE_WAVE_Service(&Wave);
+    }
+
+    HIERODULE_WAVE_Init(&Wave, TIM1, &Link, Table, 8, 1, &Refill, &Refills);
+    Refills = 0;
+    Stops = 0;
+    Flags = HIERODULE_DMA_FLAG_TE | HIERODULE_DMA_FLAG_HT;
+    HIERODULE_WAVE_Service(&Wave);
+    CHECK(Refills == 0);
+    CHECK( (Stops == 1) && ((TIM1->DIER & TIM_DIER_UDE) == 0) );
+}
+
+int main(void)
+{
+    static const uint32_t Frames[] = { 2, 4, 6, 10, 64, 128, 250 };
+
+    srand(10);
+
+    Sine();
+    FillSine();
+    FillDither();
+    Refused();
+
+    for(uint32_t f = 0 ; f < sizeof(Frames) / sizeof(Frames[0]) ; f++)
+    {
+        for(uint8_t Channels = 1 ; Channels <= 4 ; Channels++)
+        {
+            Starts = 0;
+            Stream(Frames[f], Channels);
+        }
+    }
+    Fixed();
+
+    return HostReport("wave");
+}
@@ -0,0 +1,19 @@
+#!/bin/sh
+# Builds and runs the host tests, each a single translation unit including
+# the sources it covers, against the host stand-in of the device header.
+cd "$(dirname "$0")/.." || exit 1
+CC=${CC:-cc}
+OUT=${TMPDIR:-/tmp}/hierodule_tests
+mkdir -p "$OUT"
+status=0
+for test in Tests/*_test.c; do
+    name=$(basename "$test" .c)
+    if ! $CC -std=c11 -O2 -Wall -Wextra -Werror -ITests/Stub -IInc \
+        -o "$OUT/$name" "$test" -lm; then
+        echo "$name: build failed"
+        status=1
+        continue
+    fi
+    "$OUT/$name" || status=1
+done
+exit $status
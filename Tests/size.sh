@@ -0,0 +1,78 @@
+#!/bin/sh
+# Reports the flash and RAM the modules take on each supported device, built
+# with the GNU Arm toolchain against the STM32Cube packages, for the working
+# tree and, if REF names a git revision, for that revision to compare with.
+#   CUBE_F0, CUBE_F1, CUBE_F4: roots of the STM32CubeF0, F1 and F4 packages,
+#   a device is skipped if its package isn't set.
+#   SOURCES: sources to build, the timer module by default.
+#   REF: git revision to compare with, e.g. a release tag.
+cd "$(dirname "$0")/.." || exit 1
+CC=${CC:-arm-none-eabi-gcc}
+SIZE=${SIZE:-arm-none-eabi-size}
+CFLAGS=${CFLAGS:--Os -ffunction-sections -fdata-sections}
+SOURCES=${SOURCES:-Src/hierodule_tim.c}
+OUT=${TMPDIR:-/tmp}/hierodule_size
+rm -rf "$OUT"
+mkdir -p "$OUT"
+status=0
+
+if [ -n "$REF" ]; then
+    mkdir -p "$OUT/ref"
+    if ! git archive "$REF" Inc Src | tar -x -C "$OUT/ref"; then
+        exit 1
+    fi
+fi
+
+# Builds the sources of a tree for a device into one directory, and prints
+# the text, data and bss totals.
+build() {
+    tree=$1
+    dir=$2
+    mkdir -p "$dir"
+    for source in $SOURCES; do
+        if ! $CC -mcpu="$cpu" -mthumb $CFLAGS -std=c11 -D"$device" \
+            -I"$OUT/$name" -I"$tree/Inc" -I"$cube/Drivers/CMSIS/Include" \
+            -I"$cube/Drivers/CMSIS/Core/Include" \
+            -I"$cube/Drivers/CMSIS/Device/ST/$family/Include" \
+            -c -o "$dir/$(basename "$source" .c).o" "$tree/$source"; then
+            return 1
+        fi
+    done
+    $SIZE -t "$dir"/*.o | tail -n 1 | awk '{ print $1, $2, $3 }'
+}
+
+for target in \
+    "F030 STM32F030x6 cortex-m0 stm32f0xx STM32F0xx $CUBE_F0" \
+    "F103 STM32F103xB cortex-m3 stm32f1xx STM32F1xx $CUBE_F1" \
+    "F401 STM32F401xC cortex-m4 stm32f4xx STM32F4xx $CUBE_F4"; do
+    set -- $target
+    name=$1 device=$2 cpu=$3 header=$4 family=$5 cube=$6
+    if [ -z "$cube" ]; then
+        echo "$name: skipped, no package"
+        continue
+    fi
+
+    # The modules only need the device header off main.h.
+    mkdir -p "$OUT/$name"
+    echo "#include \"$header.h\"" > "$OUT/$name/main.h"
+
+    if ! now=$(build . "$OUT/$name/now"); then
+        echo "$name: build failed"
+        status=1
+        continue
+    fi
+    set -- $now
+    line="$name: text $1, data $2, bss $3"
+    if [ -n "$REF" ]; then
+        if ! before=$(build "$OUT/ref" "$OUT/$name/ref"); then
+            echo "$line, $REF build failed"
+            status=1
+            continue
+        fi
+        set -- $now $before
+        line="$line, against $REF: text $(($1 - $4)), data $(($2 - $5)),"
+        line="$line bss $(($3 - $6))"
+    fi
+    echo "$line"
+done
+exit $status